@@ -41,6 +41,9 @@ enum FONSalign {
 enum FONSglyphBitmap {
 	FONS_GLYPH_BITMAP_OPTIONAL = 1,
 	FONS_GLYPH_BITMAP_REQUIRED = 2,
+	// Like REQUIRED, but a missing bitmap is queued as a glyph job instead of rendered. The glyph
+	// comes back without one (FONStextIter.slot -1) until its job is committed.
+	FONS_GLYPH_BITMAP_DEFERRED = 3,
 };
 
 enum FONSerrorCode {
@@ -79,6 +82,7 @@ struct FONStextIter {
 	short isize, iblur;
 	struct FONSfont* font;
 	int prevGlyphIndex;
+	int slot;	// atlas slot of the last glyph, -1 without a bitmap
 	const char* str;
 	const char* next;
 	const char* end;
@@ -87,7 +91,19 @@ struct FONStextIter {
 };
 typedef struct FONStextIter FONStextIter;
 
+struct FONSatlasStats {
+	int width, height;
+	int pages, freePages;	// FONS_PAGE_SIZE squares the atlas is split into
+	int glyphs;				// glyph bitmaps resident in the atlas
+	int usedPixels;			// area covered by them, padding included
+	int rasterizations;		// glyph bitmaps rendered since creation
+	int evictions;			// glyph bitmaps dropped to make room for others
+	int queued;				// glyph jobs waiting for fonsTakeGlyphJobs
+};
+typedef struct FONSatlasStats FONSatlasStats;
+
 typedef struct FONScontext FONScontext;
+typedef struct FONSglyphJob FONSglyphJob;
 
 // Constructor and destructor.
 FONScontext* fonsCreateInternal(FONSparams* params);
@@ -101,6 +117,43 @@ int fonsExpandAtlas(FONScontext* s, int width, int height);
 // Resets the whole stash.
 int fonsResetAtlas(FONScontext* stash, int width, int height);
 
+// Starts a new frame. Glyphs used since the previous call are never evicted, so quads
+// submitted earlier in the frame keep sampling the right bitmaps.
+void fonsBeginFrame(FONScontext* s);
+// When enabled, a full atlas recycles the least recently used glyphs of earlier frames
+// before reporting FONS_ATLAS_FULL.
+void fonsSetEviction(FONScontext* s, int enabled);
+// Marks the atlas slots of cached quads (FONStextIter.slot) as used this frame.
+void fonsTouchGlyphs(FONScontext* s, const int* slots, int nslots);
+// Changes whenever a rasterized glyph is evicted or moved, making cached quads stale.
+int fonsAtlasGeneration(FONScontext* s);
+void fonsGetAtlasStats(FONScontext* s, FONSatlasStats* stats);
+
+// Glyph jobs render the bitmaps of FONS_GLYPH_BITMAP_DEFERRED lookups away from the stash.
+// fonsTakeGlyphJobs moves up to maxJobs queued jobs into jobs and returns how many, or the
+// queue length when jobs is NULL. fonsRasterizeGlyphJob only reads font data and may run on
+// any thread. fonsCommitGlyphJob places the bitmap in the atlas: it returns 1, 0 when the glyph
+// went away or got rendered meanwhile, or -1 when the atlas is full, in which case the job can
+// be committed again after growing the atlas or dropped with fonsCancelGlyphJob. Jobs are sized
+// in the implementation, FreeType builds render deferred glyphs right away.
+int fonsTakeGlyphJobs(FONScontext* s, FONSglyphJob* jobs, int maxJobs);
+void fonsRasterizeGlyphJob(FONSglyphJob* job);
+int fonsCommitGlyphJob(FONScontext* s, FONSglyphJob* job);
+void fonsCancelGlyphJob(FONScontext* s, FONSglyphJob* job);
+// Queues jobs for the codepoints first..last found in the current font or its fallbacks, at
+// the current size, blur and SDF mode. last is inclusive and clamped to the last Unicode
+// codepoint, so UINT_MAX means up to the end. Returns the number of jobs added.
+int fonsPrewarmGlyphs(FONScontext* s, unsigned int first, unsigned int last);
+
+// Glyph caches hold rendered glyphs keyed by font data, codepoint, size and blur, so a later
+// run can fill the atlas without rasterizing. fonsSaveGlyphCache writes the resident glyphs
+// to data when ndata is enough and returns the size they need. fonsLoadGlyphCache adds the
+// cached glyphs of font, or of every font for FONS_INVALID, that are not resident yet. It
+// returns 1 once they all are, 0 when the atlas filled up first, in which case calling it
+// again after growing the atlas carries on, and -1 when data is not a glyph cache.
+int fonsSaveGlyphCache(FONScontext* s, unsigned char* data, int ndata);
+int fonsLoadGlyphCache(FONScontext* s, const unsigned char* data, int ndata, int font);
+
 // Add fonts
 int fonsAddFont(FONScontext* s, const char* name, const char* path, int fontIndex);
 int fonsAddFontMem(FONScontext* s, const char* name, unsigned char* data, int ndata, int freeData, int fontIndex);
@@ -118,6 +171,12 @@ void fonsSetSpacing(FONScontext* s, float spacing);
 void fonsSetBlur(FONScontext* s, float blur);
 void fonsSetAlign(FONScontext* s, int align);
 void fonsSetFont(FONScontext* s, int font);
+// Renders glyphs as signed distance fields: one FONS_SDF_SIZE bitmap per glyph serves every
+// size and text is laid out without snapping to whole pixels. Blurred text keeps using bitmaps.
+void fonsSetSDF(FONScontext* s, int enabled);
+// Change of the stored distance (0..1) across one pixel of text drawn at size, or 0 when the
+// current state draws bitmap glyphs. Renderers smooth distance field edges over this width.
+float fonsSDFEdgeWidth(FONScontext* s, float size);
 
 // Draw text
 float fonsDrawText(FONScontext* s, float x, float y, const char* string, const char* end);
@@ -186,8 +245,14 @@ typedef struct FONSttFontImpl FONSttFontImpl;
 #ifndef FONS_INIT_GLYPHS
 #	define FONS_INIT_GLYPHS 256
 #endif
-#ifndef FONS_INIT_ATLAS_NODES
-#	define FONS_INIT_ATLAS_NODES 256
+#ifndef FONS_PAGE_SIZE
+#	define FONS_PAGE_SIZE 128
+#endif
+#ifndef FONS_SDF_SIZE
+#	define FONS_SDF_SIZE 48
+#endif
+#ifndef FONS_SDF_PAD
+#	define FONS_SDF_PAD 6
 #endif
 #ifndef FONS_VERTEX_COUNT
 #	define FONS_VERTEX_COUNT 1024
@@ -225,6 +290,7 @@ struct FONSglyph
 	unsigned int codepoint;
 	int index;
 	int next;
+	int slot;	// atlas slot holding the bitmap, -1 if none
 	short size, blur;
 	short x0,y0,x1,y1;
 	short xadv,xoff,yoff;
@@ -238,6 +304,8 @@ struct FONSfont
 	unsigned char* data;
 	int dataSize;
 	unsigned char freeData;
+	int index;				// face in a font collection
+	unsigned int hash;		// of data and index, keys glyph caches, 0 until needed
 	float ascender;
 	float descender;
 	float lineh;
@@ -258,23 +326,81 @@ struct FONSstate
 	unsigned int color;
 	float blur;
 	float spacing;
+	int sdf;
 };
 typedef struct FONSstate FONSstate;
 
-struct FONSatlasNode {
-    short x, y, width;
+// Last Unicode codepoint, the end of prewarm ranges.
+#define FONS_MAX_CODEPOINT 0x10FFFFu
+
+// Distance field glyphs are keyed by this blur value. The outline sits at FONS_SDF_ONEDGE and
+// the distance falls to zero FONS_SDF_PAD texels outside it.
+#define FONS_SDF_BLUR -1
+#define FONS_SDF_ONEDGE 128
+
+// The atlas is split into FONS_PAGE_SIZE pages. A page is carved into equal square cells of
+// one size class, glyphs bigger than a page take a block of whole pages. Cells are handed
+// out and evicted one by one, each class keeping its cells in least recently used order.
+// Slot ids are page<<8 | cell, a page holds at most 16x16 cells.
+#define FONS_PAGE_CLASSES 8
+#define FONS_PAGE_LARGE FONS_PAGE_CLASSES	// class of pages anchoring a multi-page glyph
+#define FONS_PAGE_FREE -1
+#define FONS_PAGE_SPAN -2					// covered by a multi-page glyph anchored elsewhere
+#define FONS_SLOT_PINNED 0x7fffffff
+#define FONS_GLYPH_QUEUED -2				// FONSglyph.slot of a glyph waiting on its job
+
+// Glyph cache layout, little endian: the magic, version, FONS_SDF_SIZE, FONS_SDF_PAD and glyph
+// count, then per glyph the font hash, codepoint, size, blur, glyph index, xadv, xoff, yoff,
+// width and height followed by width x height pixels.
+#define FONS_CACHE_MAGIC "FONSGLC1"
+#define FONS_CACHE_VERSION 1
+#define FONS_CACHE_HEADER 24
+#define FONS_CACHE_ENTRY 26
+
+struct FONSslot {
+	struct FONSfont* font;	// owner of the glyph, NULL for the pinned white rect
+	int glyph;				// index in font->glyphs
+	int lastUsed;			// frame of the last lookup
+	int prev, next;			// neighbours in the class' used or free list
+	short x, y, w, h;		// cell origin and glyph size, w is 0 while free
 };
-typedef struct FONSatlasNode FONSatlasNode;
+typedef struct FONSslot FONSslot;
+
+struct FONSpage {
+	int cls;		// size class, FONS_PAGE_LARGE, FONS_PAGE_FREE or FONS_PAGE_SPAN
+	int anchor;		// span pages, the page holding the glyph
+	int lastUsed;	// newest lastUsed of its slots
+	FONSslot* slots;
+	int nslots;
+	int cslots;
+};
+typedef struct FONSpage FONSpage;
 
 struct FONSatlas
 {
 	int width, height;
-	FONSatlasNode* nodes;
-	int nnodes;
-	int cnodes;
+	int pagesX, pagesY;
+	FONSpage* pages;
+	int usedHead[FONS_PAGE_CLASSES+1], usedTail[FONS_PAGE_CLASSES+1];	// most recently used first
+	int freeHead[FONS_PAGE_CLASSES], freeTail[FONS_PAGE_CLASSES];
+	int nglyphs;
+	int usedPixels;
 };
 typedef struct FONSatlas FONSatlas;
 
+struct FONSglyphJob {
+	unsigned char* bitmap;	// width x height, NULL until rasterized
+	int width, height;
+	FONSttFontImpl face;	// copy of the rendering font, allocating from the heap
+	FONSfont* font;			// owner of the glyph, NULL once committed or cancelled
+	int glyph;				// index in font->glyphs
+	int epoch;				// atlas resets when queued
+	unsigned int codepoint;
+	short size, blur;
+	int index, pad;
+	float scale;
+};
+
 struct FONScontext
 {
 	FONSparams params;
@@ -295,6 +421,14 @@ struct FONScontext
 	int nstates;
 	void (*handleError)(void* uptr, int error, int val);
 	void* errorUptr;
+	int frame;
+	int evict;
+	int generation;
+	int rasterizations;
+	int evictions;
+	FONSglyphJob* jobs;
+	int njobs, cjobs;
+	int epoch;
 #ifdef FONS_USE_FREETYPE
 	FT_Library ftLibrary;
 #endif
@@ -453,6 +587,18 @@ void fons__tt_renderGlyphBitmap(FONSttFontImpl *font, unsigned char *output, int
 	stbtt_MakeGlyphBitmap(&font->font, output, outWidth, outHeight, outStride, scaleX, scaleY, glyph);
 }
 
+void fons__tt_renderGlyphSDF(FONSttFontImpl *font, unsigned char *output, int outWidth, int outHeight, int outStride,
+							 float scale, int glyph, int padding)
+{
+	int w, h, xoff, yoff, y;
+	unsigned char* sdf = stbtt_GetGlyphSDF(&font->font, scale, glyph, padding, FONS_SDF_ONEDGE,
+										   (float)FONS_SDF_ONEDGE / padding, &w, &h, &xoff, &yoff);
+	if (sdf == NULL) return;	// blank glyph
+	for (y = 0; y < h && y < outHeight; y++)
+		memcpy(&output[y*outStride], &sdf[y*w], fons__mini(w, outWidth));
+	stbtt_FreeSDF(sdf, font->font.userdata);
+}
+
 int fons__tt_getGlyphKernAdvance(FONSttFontImpl *font, int glyph1, int glyph2)
 {
 	return stbtt_GetGlyphKernAdvance(&font->font, glyph1, glyph2);
@@ -467,6 +613,10 @@ static void* fons__tmpalloc(size_t size, void* up)
 	unsigned char* ptr;
 	FONScontext* stash = (FONScontext*)up;
 
+	// Glyph jobs render without a stash.
+	if (stash == NULL)
+		return malloc(size);
+
 	// 16-byte align the returned pointer
 	size = (size + 0xf) & ~0xf;
 
@@ -482,9 +632,8 @@ static void* fons__tmpalloc(size_t size, void* up)
 
 static void fons__tmpfree(void* ptr, void* up)
 {
-	(void)ptr;
-	(void)up;
-	// empty
+	if (up == NULL)
+		free(ptr);
 }
 
 #endif // STB_TRUETYPE_IMPLEMENTATION
@@ -530,14 +679,93 @@ static unsigned int fons__decutf8(unsigned int* state, unsigned int* codep, unsi
 
 // Atlas based on Skyline Bin Packer by Jukka Jylänki
 
+static int fons__cellSize(int cls)
+{
+	static const int sixteenths[FONS_PAGE_CLASSES] = { 1, 2, 3, 4, 6, 8, 12, 16 };
+	return FONS_PAGE_SIZE * sixteenths[cls] / 16;
+}
+
+static FONSslot* fons__atlasSlot(FONSatlas* atlas, int id)
+{
+	return &atlas->pages[id >> 8].slots[id & 0xff];
+}
+
+static void fons__atlasUnlink(FONSatlas* atlas, int* head, int* tail, int id)
+{
+	FONSslot* slot = fons__atlasSlot(atlas, id);
+	if (slot->prev != -1) fons__atlasSlot(atlas, slot->prev)->next = slot->next;
+	else *head = slot->next;
+	if (slot->next != -1) fons__atlasSlot(atlas, slot->next)->prev = slot->prev;
+	else *tail = slot->prev;
+	slot->prev = slot->next = -1;
+}
+
+static void fons__atlasPushFront(FONSatlas* atlas, int* head, int* tail, int id)
+{
+	FONSslot* slot = fons__atlasSlot(atlas, id);
+	slot->prev = -1;
+	slot->next = *head;
+	if (*head != -1) fons__atlasSlot(atlas, *head)->prev = id;
+	else *tail = id;
+	*head = id;
+}
+
+static void fons__atlasInitPages(FONSatlas* atlas, int first)
+{
+	int i;
+	for (i = first; i < atlas->pagesX * atlas->pagesY; i++) {
+		FONSpage* page = &atlas->pages[i];
+		page->cls = FONS_PAGE_FREE;
+		page->anchor = -1;
+		page->lastUsed = 0;
+		page->slots = NULL;
+		page->nslots = 0;
+		page->cslots = 0;
+	}
+}
+
+static void fons__atlasInitLists(FONSatlas* atlas)
+{
+	int i;
+	for (i = 0; i <= FONS_PAGE_CLASSES; i++)
+		atlas->usedHead[i] = atlas->usedTail[i] = -1;
+	for (i = 0; i < FONS_PAGE_CLASSES; i++)
+		atlas->freeHead[i] = atlas->freeTail[i] = -1;
+	atlas->nglyphs = 0;
+	atlas->usedPixels = 0;
+}
+
+static void fons__atlasFreePages(FONSatlas* atlas)
+{
+	int i;
+	if (atlas->pages == NULL) return;
+	for (i = 0; i < atlas->pagesX * atlas->pagesY; i++)
+		free(atlas->pages[i].slots);
+	free(atlas->pages);
+	atlas->pages = NULL;
+}
+
+static int fons__atlasAllocPages(FONSatlas* atlas, int w, int h)
+{
+	atlas->width = w;
+	atlas->height = h;
+	atlas->pagesX = (w + FONS_PAGE_SIZE-1) / FONS_PAGE_SIZE;
+	atlas->pagesY = (h + FONS_PAGE_SIZE-1) / FONS_PAGE_SIZE;
+	atlas->pages = (FONSpage*)malloc(sizeof(FONSpage) * atlas->pagesX * atlas->pagesY);
+	if (atlas->pages == NULL) return 0;
+	fons__atlasInitPages(atlas, 0);
+	fons__atlasInitLists(atlas);
+	return 1;
+}
+
 static void fons__deleteAtlas(FONSatlas* atlas)
 {
 	if (atlas == NULL) return;
-	if (atlas->nodes != NULL) free(atlas->nodes);
+	fons__atlasFreePages(atlas);
 	free(atlas);
 }
 
-static FONSatlas* fons__allocAtlas(int w, int h, int nnodes)
+static FONSatlas* fons__allocAtlas(int w, int h)
 {
 	FONSatlas* atlas = NULL;
 
@@ -546,21 +774,7 @@ static FONSatlas* fons__allocAtlas(int w, int h, int nnodes)
 	if (atlas == NULL) goto error;
 	memset(atlas, 0, sizeof(FONSatlas));
 
-	atlas->width = w;
-	atlas->height = h;
-
-	// Allocate space for skyline nodes
-	atlas->nodes = (FONSatlasNode*)malloc(sizeof(FONSatlasNode) * nnodes);
-	if (atlas->nodes == NULL) goto error;
-	memset(atlas->nodes, 0, sizeof(FONSatlasNode) * nnodes);
-	atlas->nnodes = 0;
-	atlas->cnodes = nnodes;
-
-	// Init root node.
-	atlas->nodes[0].x = 0;
-	atlas->nodes[0].y = 0;
-	atlas->nodes[0].width = (short)w;
-	atlas->nnodes++;
+	if (!fons__atlasAllocPages(atlas, w, h)) goto error;
 
 	return atlas;
 
@@ -569,153 +783,357 @@ error:
 	return NULL;
 }
 
-static int fons__atlasInsertNode(FONSatlas* atlas, int idx, int x, int y, int w)
+// Cells of a class along each side of a page, pages on the right and bottom edges may be cut short.
+static int fons__pageCells(FONSatlas* atlas, int p, int cls, int* nx, int* ny)
 {
-	int i;
-	// Insert node
-	if (atlas->nnodes+1 > atlas->cnodes) {
-		atlas->cnodes = atlas->cnodes == 0 ? 8 : atlas->cnodes * 2;
-		atlas->nodes = (FONSatlasNode*)realloc(atlas->nodes, sizeof(FONSatlasNode) * atlas->cnodes);
-		if (atlas->nodes == NULL)
-			return 0;
-	}
-	for (i = atlas->nnodes; i > idx; i--)
-		atlas->nodes[i] = atlas->nodes[i-1];
-	atlas->nodes[idx].x = (short)x;
-	atlas->nodes[idx].y = (short)y;
-	atlas->nodes[idx].width = (short)w;
-	atlas->nnodes++;
+	int cell = fons__cellSize(cls);
+	int px = (p % atlas->pagesX) * FONS_PAGE_SIZE;
+	int py = (p / atlas->pagesX) * FONS_PAGE_SIZE;
+	*nx = fons__mini(FONS_PAGE_SIZE, atlas->width - px) / cell;
+	*ny = fons__mini(FONS_PAGE_SIZE, atlas->height - py) / cell;
+	return *nx * *ny;
+}
 
-	return 1;
+static int fons__pageLastUsed(FONSatlas* atlas, int p)
+{
+	FONSpage* page = &atlas->pages[p];
+	if (page->cls == FONS_PAGE_SPAN)
+		page = &atlas->pages[page->anchor];
+	return page->cls == FONS_PAGE_FREE ? 0 : page->lastUsed;
 }
 
-static void fons__atlasRemoveNode(FONSatlas* atlas, int idx)
+static int fons__atlasReserveSlots(FONSpage* page, int n)
 {
-	int i;
-	if (atlas->nnodes == 0) return;
-	for (i = idx; i < atlas->nnodes-1; i++)
-		atlas->nodes[i] = atlas->nodes[i+1];
-	atlas->nnodes--;
+	if (n > page->cslots) {
+		FONSslot* slots = (FONSslot*)realloc(page->slots, sizeof(FONSslot) * n);
+		if (slots == NULL) return 0;
+		page->slots = slots;
+		page->cslots = n;
+	}
+	page->nslots = n;
+	return 1;
 }
 
-static void fons__atlasExpand(FONSatlas* atlas, int w, int h)
+// Carves a free page into free cells of a class.
+static int fons__atlasFormatPage(FONSatlas* atlas, int p, int cls)
 {
-	// Insert node for empty space
-	if (w > atlas->width)
-		fons__atlasInsertNode(atlas, atlas->nnodes, atlas->width, 0, w - atlas->width);
-	atlas->width = w;
-	atlas->height = h;
+	FONSpage* page = &atlas->pages[p];
+	int cell = fons__cellSize(cls);
+	int px = (p % atlas->pagesX) * FONS_PAGE_SIZE;
+	int py = (p / atlas->pagesX) * FONS_PAGE_SIZE;
+	int nx, ny, i;
+
+	if (fons__pageCells(atlas, p, cls, &nx, &ny) == 0)
+		return 0;
+	if (!fons__atlasReserveSlots(page, nx*ny))
+		return 0;
+
+	page->cls = cls;
+	page->lastUsed = 0;
+	// Pushed in reverse so cells are handed out from the top left.
+	for (i = nx*ny-1; i >= 0; i--) {
+		FONSslot* slot = &page->slots[i];
+		slot->font = NULL;
+		slot->glyph = -1;
+		slot->lastUsed = 0;
+		slot->x = (short)(px + (i % nx) * cell);
+		slot->y = (short)(py + (i / nx) * cell);
+		slot->w = slot->h = 0;
+		fons__atlasPushFront(atlas, &atlas->freeHead[cls], &atlas->freeTail[cls], (p << 8) | i);
+	}
+	return 1;
 }
 
-static void fons__atlasReset(FONSatlas* atlas, int w, int h)
+static void fons__atlasEvict(FONScontext* stash, int id)
 {
-	atlas->width = w;
-	atlas->height = h;
-	atlas->nnodes = 0;
+	FONSatlas* atlas = stash->atlas;
+	FONSpage* page = &atlas->pages[id >> 8];
+	FONSslot* slot = fons__atlasSlot(atlas, id);
+	int cls = page->cls;
+	int i, j;
 
-	// Init root node.
-	atlas->nodes[0].x = 0;
-	atlas->nodes[0].y = 0;
-	atlas->nodes[0].width = (short)w;
-	atlas->nnodes++;
+	if (slot->font != NULL) {
+		FONSglyph* glyph = &slot->font->glyphs[slot->glyph];
+		glyph->x0 = glyph->y0 = glyph->x1 = glyph->y1 = -1;
+		glyph->slot = -1;
+		atlas->nglyphs--;
+		stash->evictions++;
+	}
+	atlas->usedPixels -= slot->w * slot->h;
+	stash->generation++;
+
+	fons__atlasUnlink(atlas, &atlas->usedHead[cls], &atlas->usedTail[cls], id);
+
+	if (cls == FONS_PAGE_LARGE) {
+		// Give back every page the glyph covered.
+		int p = id >> 8;
+		int kx = (slot->w + FONS_PAGE_SIZE-1) / FONS_PAGE_SIZE;
+		int ky = (slot->h + FONS_PAGE_SIZE-1) / FONS_PAGE_SIZE;
+		for (j = 0; j < ky; j++) {
+			for (i = 0; i < kx; i++) {
+				FONSpage* covered = &atlas->pages[p + j*atlas->pagesX + i];
+				covered->cls = FONS_PAGE_FREE;
+				covered->anchor = -1;
+			}
+		}
+		slot->w = slot->h = 0;
+		slot->font = NULL;
+		return;
+	}
+
+	slot->font = NULL;
+	slot->glyph = -1;
+	slot->w = slot->h = 0;
+	fons__atlasPushFront(atlas, &atlas->freeHead[cls], &atlas->freeTail[cls], id);
 }
 
-static int fons__atlasAddSkylineLevel(FONSatlas* atlas, int idx, int x, int y, int w, int h)
+// Evicts everything on a page and returns it to the free pages.
+static void fons__atlasReclaimPage(FONScontext* stash, int p)
 {
+	FONSatlas* atlas = stash->atlas;
+	FONSpage* page = &atlas->pages[p];
 	int i;
 
-	// Insert new node
-	if (fons__atlasInsertNode(atlas, idx, x, y+h, w) == 0)
-		return 0;
+	if (page->cls == FONS_PAGE_SPAN) {
+		fons__atlasEvict(stash, page->anchor << 8);
+	} else if (page->cls == FONS_PAGE_LARGE) {
+		fons__atlasEvict(stash, p << 8);
+	} else if (page->cls >= 0) {
+		for (i = 0; i < page->nslots; i++) {
+			if (page->slots[i].w > 0)
+				fons__atlasEvict(stash, (p << 8) | i);
+		}
+		for (i = 0; i < page->nslots; i++)
+			fons__atlasUnlink(atlas, &atlas->freeHead[page->cls], &atlas->freeTail[page->cls], (p << 8) | i);
+		page->cls = FONS_PAGE_FREE;
+	}
+}
 
-	// Delete skyline segments that fall under the shadow of the new segment.
-	for (i = idx+1; i < atlas->nnodes; i++) {
-		if (atlas->nodes[i].x < atlas->nodes[i-1].x + atlas->nodes[i-1].width) {
-			int shrink = atlas->nodes[i-1].x + atlas->nodes[i-1].width - atlas->nodes[i].x;
-			atlas->nodes[i].x += (short)shrink;
-			atlas->nodes[i].width -= (short)shrink;
-			if (atlas->nodes[i].width <= 0) {
-				fons__atlasRemoveNode(atlas, i);
-				i--;
-			} else {
-				break;
+// Glyphs larger than a page take the first block of free pages, or else the block whose
+// newest glyph is oldest, as long as nothing in it was used this frame.
+static int fons__atlasAddLarge(FONScontext* stash, int w, int h)
+{
+	FONSatlas* atlas = stash->atlas;
+	int kx = (w + FONS_PAGE_SIZE-1) / FONS_PAGE_SIZE;
+	int ky = (h + FONS_PAGE_SIZE-1) / FONS_PAGE_SIZE;
+	int best = -1, bestLast = 0;
+	int px, py, i, j;
+	FONSpage* anchor;
+	FONSslot* slot;
+
+	for (py = 0; py + ky <= atlas->pagesY && bestLast != -1; py++) {
+		for (px = 0; px + kx <= atlas->pagesX; px++) {
+			int last = -1, fits = 1;
+			if (px * FONS_PAGE_SIZE + w > atlas->width || py * FONS_PAGE_SIZE + h > atlas->height)
+				continue;
+			for (j = 0; j < ky && fits; j++) {
+				for (i = 0; i < kx && fits; i++) {
+					int p = (py+j) * atlas->pagesX + px+i;
+					if (atlas->pages[p].cls == FONS_PAGE_FREE)
+						continue;
+					if (!stash->evict || fons__pageLastUsed(atlas, p) >= stash->frame)
+						fits = 0;
+					else
+						last = fons__maxi(last, fons__pageLastUsed(atlas, p));
+				}
+			}
+			if (fits && (best == -1 || last < bestLast)) {
+				best = py * atlas->pagesX + px;
+				bestLast = last;
+				if (last == -1) break;	// all free
 			}
-		} else {
-			break;
 		}
 	}
+	if (best == -1)
+		return -1;
+
+	for (j = 0; j < ky; j++) {
+		for (i = 0; i < kx; i++)
+			fons__atlasReclaimPage(stash, best + j*atlas->pagesX + i);
+	}
 
-	// Merge same height skyline segments that are next to each other.
-	for (i = 0; i < atlas->nnodes-1; i++) {
-		if (atlas->nodes[i].y == atlas->nodes[i+1].y) {
-			atlas->nodes[i].width += atlas->nodes[i+1].width;
-			fons__atlasRemoveNode(atlas, i+1);
-			i--;
+	anchor = &atlas->pages[best];
+	if (!fons__atlasReserveSlots(anchor, 1))
+		return -1;
+	for (j = 0; j < ky; j++) {
+		for (i = 0; i < kx; i++) {
+			atlas->pages[best + j*atlas->pagesX + i].cls = FONS_PAGE_SPAN;
+			atlas->pages[best + j*atlas->pagesX + i].anchor = best;
 		}
 	}
+	anchor->cls = FONS_PAGE_LARGE;
+	anchor->anchor = -1;
 
-	return 1;
+	slot = &anchor->slots[0];
+	slot->font = NULL;
+	slot->glyph = -1;
+	slot->x = (short)((best % atlas->pagesX) * FONS_PAGE_SIZE);
+	slot->y = (short)((best / atlas->pagesX) * FONS_PAGE_SIZE);
+	fons__atlasPushFront(atlas, &atlas->usedHead[FONS_PAGE_LARGE], &atlas->usedTail[FONS_PAGE_LARGE], best << 8);
+	return best << 8;
 }
 
-static int fons__atlasRectFits(FONSatlas* atlas, int i, int w, int h)
+// Returns the slot id for a w x h bitmap, or -1 if the atlas is full.
+static int fons__atlasAddRect(FONScontext* stash, int w, int h)
 {
-	// Checks if there is enough space at the location of skyline span 'i',
-	// and return the max height of all skyline spans under that at that location,
-	// (think tetris block being dropped at that position). Or -1 if no space found.
-	int x = atlas->nodes[i].x;
-	int y = atlas->nodes[i].y;
-	int spaceLeft;
-	if (x + w > atlas->width)
-		return -1;
-	spaceLeft = w;
-	while (spaceLeft > 0) {
-		if (i == atlas->nnodes) return -1;
-		y = fons__maxi(y, atlas->nodes[i].y);
-		if (y + h > atlas->height) return -1;
-		spaceLeft -= atlas->nodes[i].width;
-		++i;
-	}
-	return y;
-}
-
-static int fons__atlasAddRect(FONSatlas* atlas, int rw, int rh, int* rx, int* ry)
-{
-	int besth = atlas->height, bestw = atlas->width, besti = -1;
-	int bestx = -1, besty = -1, i;
-
-	// Bottom left fit heuristic.
-	for (i = 0; i < atlas->nnodes; i++) {
-		int y = fons__atlasRectFits(atlas, i, rw, rh);
-		if (y != -1) {
-			if (y + rh < besth || (y + rh == besth && atlas->nodes[i].width < bestw)) {
-				besti = i;
-				bestw = atlas->nodes[i].width;
-				besth = y + rh;
-				bestx = atlas->nodes[i].x;
-				besty = y;
+	FONSatlas* atlas = stash->atlas;
+	int npages = atlas->pagesX * atlas->pagesY;
+	int cls, p, id, nx, ny;
+	FONSslot* slot;
+
+	for (cls = 0; cls < FONS_PAGE_CLASSES; cls++) {
+		if (w <= fons__cellSize(cls) && h <= fons__cellSize(cls))
+			break;
+	}
+
+	if (cls == FONS_PAGE_CLASSES) {
+		id = fons__atlasAddLarge(stash, w, h);
+	} else {
+		// A free cell of the class, or a free page to carve into them.
+		for (p = 0; p < npages && atlas->freeHead[cls] == -1; p++) {
+			if (atlas->pages[p].cls == FONS_PAGE_FREE)
+				fons__atlasFormatPage(atlas, p, cls);
+		}
+		// Then the least recently used cell of the class, then the coldest page of any class.
+		if (atlas->freeHead[cls] == -1 && stash->evict) {
+			id = atlas->usedTail[cls];
+			if (id != -1 && fons__atlasSlot(atlas, id)->lastUsed < stash->frame) {
+				fons__atlasEvict(stash, id);
+			} else {
+				int best = -1, bestLast = 0;
+				for (p = 0; p < npages; p++) {
+					int last = fons__pageLastUsed(atlas, p);
+					if (last < stash->frame && fons__pageCells(atlas, p, cls, &nx, &ny) > 0 && (best == -1 || last < bestLast)) {
+						best = p;
+						bestLast = last;
+					}
+				}
+				if (best != -1) {
+					fons__atlasReclaimPage(stash, best);
+					fons__atlasFormatPage(atlas, best, cls);
+				}
 			}
 		}
+		id = atlas->freeHead[cls];
+		if (id != -1) {
+			fons__atlasUnlink(atlas, &atlas->freeHead[cls], &atlas->freeTail[cls], id);
+			fons__atlasPushFront(atlas, &atlas->usedHead[cls], &atlas->usedTail[cls], id);
+		}
 	}
+	if (id == -1)
+		return -1;
 
-	if (besti == -1)
-		return 0;
+	slot = fons__atlasSlot(atlas, id);
+	slot->w = (short)w;
+	slot->h = (short)h;
+	slot->lastUsed = stash->frame;
+	atlas->pages[id >> 8].lastUsed = fons__maxi(atlas->pages[id >> 8].lastUsed, stash->frame);
+	atlas->usedPixels += w*h;
+	return id;
+}
 
-	// Perform the actual packing.
-	if (fons__atlasAddSkylineLevel(atlas, besti, bestx, besty, rw, rh) == 0)
-		return 0;
+static void fons__atlasTouch(FONScontext* stash, int id)
+{
+	FONSatlas* atlas = stash->atlas;
+	FONSpage* page = &atlas->pages[id >> 8];
+	FONSslot* slot = fons__atlasSlot(atlas, id);
 
-	*rx = bestx;
-	*ry = besty;
+	if (slot->lastUsed >= stash->frame)
+		return;
+	slot->lastUsed = stash->frame;
+	page->lastUsed = fons__maxi(page->lastUsed, stash->frame);
+	fons__atlasUnlink(atlas, &atlas->usedHead[page->cls], &atlas->usedTail[page->cls], id);
+	fons__atlasPushFront(atlas, &atlas->usedHead[page->cls], &atlas->usedTail[page->cls], id);
+}
+
+// Grows the page grid, keeping every page and its glyphs where they are.
+static int fons__atlasExpand(FONScontext* stash, int w, int h)
+{
+	FONSatlas* atlas = stash->atlas;
+	int oldX = atlas->pagesX, oldY = atlas->pagesY;
+	int newX = (w + FONS_PAGE_SIZE-1) / FONS_PAGE_SIZE;
+	int newY = (h + FONS_PAGE_SIZE-1) / FONS_PAGE_SIZE;
+	FONSpage* pages;
+	int i, j, p;
+
+	pages = (FONSpage*)malloc(sizeof(FONSpage) * newX * newY);
+	if (pages == NULL) return 0;
+	for (j = 0; j < oldY; j++)
+		memcpy(&pages[j*newX], &atlas->pages[j*oldX], sizeof(FONSpage) * oldX);
+	free(atlas->pages);
+	atlas->pages = pages;
+
+	// Mark the new pages free. Partially covered edge pages keep only the cells they had.
+	for (j = 0; j < newY; j++) {
+		for (i = 0; i < newX; i++) {
+			if (i < oldX && j < oldY) continue;
+			p = j*newX + i;
+			pages[p].cls = FONS_PAGE_FREE;
+			pages[p].anchor = -1;
+			pages[p].lastUsed = 0;
+			pages[p].slots = NULL;
+			pages[p].nslots = pages[p].cslots = 0;
+		}
+	}
 
+	// Slot ids embed the page index, renumber the ones stored in lists and glyphs.
+#define FONS__REMAP(id) ((id) == -1 ? -1 : ((((id) >> 8) / oldX * newX + ((id) >> 8) % oldX) << 8 | ((id) & 0xff)))
+	for (j = 0; j < oldY; j++) {
+		for (i = 0; i < oldX; i++) {
+			FONSpage* page = &pages[j*newX + i];
+			int k;
+			if (page->anchor != -1)
+				page->anchor = page->anchor / oldX * newX + page->anchor % oldX;
+			if (page->cls == FONS_PAGE_FREE || page->cls == FONS_PAGE_SPAN) continue;
+			for (k = 0; k < page->nslots; k++) {
+				FONSslot* slot = &page->slots[k];
+				slot->prev = FONS__REMAP(slot->prev);
+				slot->next = FONS__REMAP(slot->next);
+				if (slot->font != NULL && slot->w > 0)
+					slot->font->glyphs[slot->glyph].slot = ((j*newX + i) << 8) | k;
+			}
+		}
+	}
+	for (i = 0; i <= FONS_PAGE_CLASSES; i++) {
+		atlas->usedHead[i] = FONS__REMAP(atlas->usedHead[i]);
+		atlas->usedTail[i] = FONS__REMAP(atlas->usedTail[i]);
+	}
+	for (i = 0; i < FONS_PAGE_CLASSES; i++) {
+		atlas->freeHead[i] = FONS__REMAP(atlas->freeHead[i]);
+		atlas->freeTail[i] = FONS__REMAP(atlas->freeTail[i]);
+	}
+#undef FONS__REMAP
+
+	atlas->width = w;
+	atlas->height = h;
+	atlas->pagesX = newX;
+	atlas->pagesY = newY;
+	stash->generation++;
 	return 1;
 }
 
+static int fons__atlasReset(FONScontext* stash, int w, int h)
+{
+	fons__atlasFreePages(stash->atlas);
+	stash->generation++;
+	return fons__atlasAllocPages(stash->atlas, w, h);
+}
+
 static void fons__addWhiteRect(FONScontext* stash, int w, int h)
 {
-	int x, y, gx, gy;
+	int x, y, gx, gy, id;
 	unsigned char* dst;
-	if (fons__atlasAddRect(stash->atlas, w, h, &gx, &gy) == 0)
+	FONSslot* slot;
+	id = fons__atlasAddRect(stash, w, h);
+	if (id == -1)
 		return;
+	// Pinned: out of the LRU list and its page never reclaimed.
+	slot = fons__atlasSlot(stash->atlas, id);
+	slot->lastUsed = FONS_SLOT_PINNED;
+	stash->atlas->pages[id >> 8].lastUsed = FONS_SLOT_PINNED;
+	fons__atlasUnlink(stash->atlas, &stash->atlas->usedHead[0], &stash->atlas->usedTail[0], id);
+	gx = slot->x;
+	gy = slot->y;
 
 	// Rasterize
 	dst = &stash->texData[gx + gy * stash->params.width];
@@ -741,6 +1159,7 @@ FONScontext* fonsCreateInternal(FONSparams* params)
 	memset(stash, 0, sizeof(FONScontext));
 
 	stash->params = *params;
+	stash->frame = 1;
 
 	// Allocate scratch buffer.
 	stash->scratch = (unsigned char*)malloc(FONS_SCRATCH_BUF_SIZE);
@@ -754,7 +1173,7 @@ FONScontext* fonsCreateInternal(FONSparams* params)
 			goto error;
 	}
 
-	stash->atlas = fons__allocAtlas(stash->params.width, stash->params.height, FONS_INIT_ATLAS_NODES);
+	stash->atlas = fons__allocAtlas(stash->params.width, stash->params.height);
 	if (stash->atlas == NULL) goto error;
 
 	// Allocate space for fonts.
@@ -835,6 +1254,19 @@ void fonsSetBlur(FONScontext* stash, float blur)
 	fons__getState(stash)->blur = blur;
 }
 
+void fonsSetSDF(FONScontext* stash, int enabled)
+{
+	fons__getState(stash)->sdf = enabled;
+}
+
+float fonsSDFEdgeWidth(FONScontext* stash, float size)
+{
+	FONSstate* state = fons__getState(stash);
+	if (state->sdf == 0 || (short)state->blur != 0 || size <= 0.0f)
+		return 0.0f;
+	return (float)FONS_SDF_ONEDGE / FONS_SDF_PAD / 255.0f * FONS_SDF_SIZE / size;
+}
+
 void fonsSetAlign(FONScontext* stash, int align)
 {
 	fons__getState(stash)->align = align;
@@ -875,6 +1307,7 @@ void fonsClearState(FONScontext* stash)
 	state->font = 0;
 	state->blur = 0;
 	state->spacing = 0;
+	state->sdf = 0;
 	state->align = FONS_ALIGN_LEFT | FONS_ALIGN_BASELINE;
 }
 
@@ -963,6 +1396,7 @@ int fonsAddFontMem(FONScontext* stash, const char* name, unsigned char* data, in
 	font->dataSize = dataSize;
 	font->data = data;
 	font->freeData = (unsigned char)freeData;
+	font->index = fontIndex;
 
 	// Init font
 	stash->nscratch = 0;
@@ -1073,22 +1507,114 @@ static void fons__blur(FONScontext* stash, unsigned char* dst, int w, int h, int
 //	fons__blurcols(dst, w, h, dstStride, alpha);
 }
 
+// Renders a glyph into the cleared gw x gh rect at dst, padding included. Only reads the font,
+// so glyph jobs call it on their own thread with their own copy of the face.
+static void fons__renderGlyph(FONSttFontImpl* face, unsigned char* dst, int gw, int gh, int stride,
+							  int pad, float scale, int g, short iblur)
+{
+	int x, y;
+
+#ifndef FONS_USE_FREETYPE
+	if (iblur == FONS_SDF_BLUR) {
+		// The field covers the padding as well and fades out before its border.
+		fons__tt_renderGlyphSDF(face, dst, gw, gh, stride, scale, g, pad);
+		return;
+	}
+#endif
+
+	// Rasterize
+	fons__tt_renderGlyphBitmap(face, &dst[pad + pad*stride], gw-pad*2,gh-pad*2, stride, scale, scale, g);
+
+	// Make sure there is one pixel empty border.
+	for (y = 0; y < gh; y++) {
+		dst[y*stride] = 0;
+		dst[gw-1 + y*stride] = 0;
+	}
+	for (x = 0; x < gw; x++) {
+		dst[x] = 0;
+		dst[x + (gh-1)*stride] = 0;
+	}
+
+	// Blur
+	if (iblur > 0)
+		fons__blur(NULL, dst, gw, gh, stride, iblur);
+}
+
+static void fons__queueGlyph(FONScontext* stash, FONSfont* font, FONSglyph* glyph,
+							 FONSttFontImpl* face, int gw, int gh, int pad, float scale)
+{
+	FONSglyphJob* job;
+
+	if (stash->njobs+1 > stash->cjobs) {
+		int cjobs = stash->cjobs == 0 ? 64 : stash->cjobs * 2;
+		FONSglyphJob* jobs = (FONSglyphJob*)realloc(stash->jobs, sizeof(FONSglyphJob) * cjobs);
+		// Without room the glyph is queued again on its next lookup.
+		if (jobs == NULL) return;
+		stash->jobs = jobs;
+		stash->cjobs = cjobs;
+	}
+
+	job = &stash->jobs[stash->njobs++];
+	memset(job, 0, sizeof(*job));
+	job->width = gw;
+	job->height = gh;
+	job->face = *face;
+#ifndef FONS_USE_FREETYPE
+	job->face.font.userdata = NULL;
+#endif
+	job->font = font;
+	job->glyph = (int)(glyph - font->glyphs);
+	job->epoch = stash->epoch;
+	job->codepoint = glyph->codepoint;
+	job->size = glyph->size;
+	job->blur = glyph->blur;
+	job->index = glyph->index;
+	job->pad = pad;
+	job->scale = scale;
+
+	glyph->slot = FONS_GLYPH_QUEUED;
+}
+
+// The glyph a job renders, NULL when the atlas was reset since it was queued.
+static FONSglyph* fons__jobGlyph(FONScontext* stash, FONSglyphJob* job)
+{
+	FONSglyph* glyph;
+	if (job->font == NULL || job->epoch != stash->epoch || job->glyph >= job->font->nglyphs)
+		return NULL;
+	glyph = &job->font->glyphs[job->glyph];
+	if (glyph->codepoint != job->codepoint || glyph->size != job->size || glyph->blur != job->blur)
+		return NULL;
+	return glyph;
+}
+
 static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned int codepoint,
 								 short isize, short iblur, int bitmapOption)
 {
-	int i, g, advance, lsb, x0, y0, x1, y1, gw, gh, gx, gy, x, y;
+	int i, g, advance, lsb, x0, y0, x1, y1, gw, gh, gx, gy, y;
 	float scale;
 	FONSglyph* glyph = NULL;
 	unsigned int h;
-	float size = isize/10.0f;
-	int pad, added;
-	unsigned char* bdst;
+	float size;
+	int pad, slot = -1;
 	unsigned char* dst;
 	FONSfont* renderFont = font;
 
+#ifdef FONS_USE_FREETYPE
+	// FreeType faces keep the loaded glyph, they cannot render on another thread.
+	if (bitmapOption == FONS_GLYPH_BITMAP_DEFERRED)
+		bitmapOption = FONS_GLYPH_BITMAP_REQUIRED;
+#endif
+
 	if (isize < 2) return NULL;
-	if (iblur > 20) iblur = 20;
-	pad = iblur+2;
+	if (iblur == FONS_SDF_BLUR) {
+		// One distance field serves every size.
+		isize = FONS_SDF_SIZE*10;
+		pad = FONS_SDF_PAD;
+	} else {
+		if (iblur > 20) iblur = 20;
+		pad = iblur+2;
+	}
+	size = isize/10.0f;
 
 	// Reset allocator.
 	stash->nscratch = 0;
@@ -1099,8 +1625,15 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 	while (i != -1) {
 		if (font->glyphs[i].codepoint == codepoint && font->glyphs[i].size == isize && font->glyphs[i].blur == iblur) {
 			glyph = &font->glyphs[i];
-			if (bitmapOption == FONS_GLYPH_BITMAP_OPTIONAL || (glyph->x0 >= 0 && glyph->y0 >= 0)) {
-			  return glyph;
+			if (bitmapOption == FONS_GLYPH_BITMAP_OPTIONAL) {
+				return glyph;
+			}
+			if (glyph->x0 >= 0 && glyph->y0 >= 0) {
+				fons__atlasTouch(stash, glyph->slot);
+				return glyph;
+			}
+			if (bitmapOption == FONS_GLYPH_BITMAP_DEFERRED && glyph->slot == FONS_GLYPH_QUEUED) {
+				return glyph;
 			}
 			// At this point, glyph exists but the bitmap data is not yet created.
 			break;
@@ -1132,13 +1665,15 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 	// Determines the spot to draw glyph in the atlas.
 	if (bitmapOption == FONS_GLYPH_BITMAP_REQUIRED) {
 		// Find free spot for the rect in the atlas
-		added = fons__atlasAddRect(stash->atlas, gw, gh, &gx, &gy);
-		if (added == 0 && stash->handleError != NULL) {
+		slot = fons__atlasAddRect(stash, gw, gh);
+		if (slot == -1 && stash->handleError != NULL) {
 			// Atlas is full, let the user to resize the atlas (or not), and try again.
 			stash->handleError(stash->errorUptr, FONS_ATLAS_FULL, 0);
-			added = fons__atlasAddRect(stash->atlas, gw, gh, &gx, &gy);
+			slot = fons__atlasAddRect(stash, gw, gh);
 		}
-		if (added == 0) return NULL;
+		if (slot == -1) return NULL;
+		gx = fons__atlasSlot(stash->atlas, slot)->x;
+		gy = fons__atlasSlot(stash->atlas, slot)->y;
 	} else {
 		// Negative coordinate indicates there is no bitmap data created.
 		gx = -1;
@@ -1158,6 +1693,7 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 		font->lut[h] = font->nglyphs-1;
 	}
 	glyph->index = g;
+	glyph->slot = slot;
 	glyph->x0 = (short)gx;
 	glyph->y0 = (short)gy;
 	glyph->x1 = (short)(glyph->x0+gw);
@@ -1169,21 +1705,22 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 	if (bitmapOption == FONS_GLYPH_BITMAP_OPTIONAL) {
 		return glyph;
 	}
+	if (bitmapOption == FONS_GLYPH_BITMAP_DEFERRED) {
+		fons__queueGlyph(stash, font, glyph, &renderFont->font, gw, gh, pad, scale);
+		return glyph;
+	}
 
-	// Rasterize
-	dst = &stash->texData[(glyph->x0+pad) + (glyph->y0+pad) * stash->params.width];
-	fons__tt_renderGlyphBitmap(&renderFont->font, dst, gw-pad*2,gh-pad*2, stash->params.width, scale, scale, g);
+	fons__atlasSlot(stash->atlas, slot)->font = font;
+	fons__atlasSlot(stash->atlas, slot)->glyph = (int)(glyph - font->glyphs);
+	stash->atlas->nglyphs++;
+	stash->rasterizations++;
 
-	// Make sure there is one pixel empty border.
+	// Clear the rect first, a recycled cell still holds the bitmap of the glyph evicted from it.
 	dst = &stash->texData[glyph->x0 + glyph->y0 * stash->params.width];
-	for (y = 0; y < gh; y++) {
-		dst[y*stash->params.width] = 0;
-		dst[gw-1 + y*stash->params.width] = 0;
-	}
-	for (x = 0; x < gw; x++) {
-		dst[x] = 0;
-		dst[x + (gh-1)*stash->params.width] = 0;
-	}
+	for (y = 0; y < gh; y++)
+		memset(&dst[y*stash->params.width], 0, gw);
+
+	fons__renderGlyph(&renderFont->font, dst, gw, gh, stash->params.width, pad, scale, g, iblur);
 
 	// Debug code to color the glyph background
 /*	unsigned char* fdst = &stash->texData[glyph->x0 + glyph->y0 * stash->params.width];
@@ -1195,13 +1732,6 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 		}
 	}*/
 
-	// Blur
-	if (iblur > 0) {
-		stash->nscratch = 0;
-		bdst = &stash->texData[glyph->x0 + glyph->y0 * stash->params.width];
-		fons__blur(stash, bdst, gw, gh, stash->params.width, iblur);
-	}
-
 	stash->dirtyRect[0] = fons__mini(stash->dirtyRect[0], glyph->x0);
 	stash->dirtyRect[1] = fons__mini(stash->dirtyRect[1], glyph->y0);
 	stash->dirtyRect[2] = fons__maxi(stash->dirtyRect[2], glyph->x1);
@@ -1211,14 +1741,18 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 }
 
 static void fons__getQuad(FONScontext* stash, FONSfont* font,
-						   int prevGlyphIndex, FONSglyph* glyph,
+						   int prevGlyphIndex, FONSglyph* glyph, short isize,
 						   float scale, float spacing, float* x, float* y, FONSquad* q)
 {
-	float rx,ry,xoff,yoff,x0,y0,x1,y1;
+	float rx,ry,xoff,yoff,x0,y0,x1,y1,gs;
+	int sdf = glyph->blur == FONS_SDF_BLUR;
 
 	if (prevGlyphIndex != -1) {
 		float adv = fons__tt_getGlyphKernAdvance(&font->font, prevGlyphIndex, glyph->index) * scale;
-		*x += (int)(adv + spacing + 0.5f);
+		if (sdf)
+			*x += adv + spacing;
+		else
+			*x += (int)(adv + spacing + 0.5f);
 	}
 
 	// Each glyph has 2px border to allow good interpolation,
@@ -1231,6 +1765,26 @@ static void fons__getQuad(FONScontext* stash, FONSfont* font,
 	x1 = (float)(glyph->x1-1);
 	y1 = (float)(glyph->y1-1);
 
+	if (sdf) {
+		// Scaled from FONS_SDF_SIZE and left unsnapped, so text keeps its shape at any size.
+		gs = (float)isize / glyph->size;
+		rx = *x + xoff*gs;
+		ry = (stash->params.flags & FONS_ZERO_TOPLEFT) ? *y + yoff*gs : *y - yoff*gs;
+
+		q->x0 = rx;
+		q->y0 = ry;
+		q->x1 = rx + (x1 - x0)*gs;
+		q->y1 = (stash->params.flags & FONS_ZERO_TOPLEFT) ? ry + (y1 - y0)*gs : ry - (y1 - y0)*gs;
+
+		q->s0 = x0 * stash->itw;
+		q->t0 = y0 * stash->ith;
+		q->s1 = x1 * stash->itw;
+		q->t1 = y1 * stash->ith;
+
+		*x += glyph->xadv / 10.0f * gs;
+		return;
+	}
+
 	if (stash->params.flags & FONS_ZERO_TOPLEFT) {
 		rx = floorf(*x + xoff);
 		ry = floorf(*y + yoff);
@@ -1293,6 +1847,16 @@ static __inline void fons__vertex(FONScontext* stash, float x, float y, float s,
 	stash->nverts++;
 }
 
+// Blur key of the glyphs the state draws, FONS_SDF_BLUR for distance fields.
+static short fons__glyphBlur(FONSstate* state)
+{
+#ifndef FONS_USE_FREETYPE
+	if (state->sdf && (short)state->blur == 0)
+		return FONS_SDF_BLUR;
+#endif
+	return (short)state->blur;
+}
+
 static float fons__getVertAlign(FONScontext* stash, FONSfont* font, int align, short isize)
 {
 	if (stash->params.flags & FONS_ZERO_TOPLEFT) {
@@ -1330,7 +1894,7 @@ float fonsDrawText(FONScontext* stash,
 	FONSquad q;
 	int prevGlyphIndex = -1;
 	short isize = (short)(state->size*10.0f);
-	short iblur = (short)state->blur;
+	short iblur = fons__glyphBlur(state);
 	float scale;
 	FONSfont* font;
 	float width;
@@ -1363,7 +1927,7 @@ float fonsDrawText(FONScontext* stash,
 			continue;
 		glyph = fons__getGlyph(stash, font, codepoint, isize, iblur, FONS_GLYPH_BITMAP_REQUIRED);
 		if (glyph != NULL) {
-			fons__getQuad(stash, font, prevGlyphIndex, glyph, scale, state->spacing, &x, &y, &q);
+			fons__getQuad(stash, font, prevGlyphIndex, glyph, isize, scale, state->spacing, &x, &y, &q);
 
 			if (stash->nverts+6 > FONS_VERTEX_COUNT)
 				fons__flush(stash);
@@ -1397,7 +1961,7 @@ int fonsTextIterInit(FONScontext* stash, FONStextIter* iter,
 	if (iter->font->data == NULL) return 0;
 
 	iter->isize = (short)(state->size*10.0f);
-	iter->iblur = (short)state->blur;
+	iter->iblur = fons__glyphBlur(state);
 	iter->scale = fons__tt_getPixelHeightScale(&iter->font->font, (float)iter->isize/10.0f);
 
 	// Align horizontally
@@ -1448,8 +2012,9 @@ int fonsTextIterNext(FONScontext* stash, FONStextIter* iter, FONSquad* quad)
 		glyph = fons__getGlyph(stash, iter->font, iter->codepoint, iter->isize, iter->iblur, iter->bitmapOption);
 		// If the iterator was initialized with FONS_GLYPH_BITMAP_OPTIONAL, then the UV coordinates of the quad will be invalid.
 		if (glyph != NULL)
-			fons__getQuad(stash, iter->font, iter->prevGlyphIndex, glyph, iter->scale, iter->spacing, &iter->nextx, &iter->nexty, quad);
+			fons__getQuad(stash, iter->font, iter->prevGlyphIndex, glyph, iter->isize, iter->scale, iter->spacing, &iter->nextx, &iter->nexty, quad);
 		iter->prevGlyphIndex = glyph != NULL ? glyph->index : -1;
+		iter->slot = glyph != NULL && glyph->x0 >= 0 ? glyph->slot : -1;
 		break;
 	}
 	iter->next = str;
@@ -1486,20 +2051,24 @@ void fonsDrawDebug(FONScontext* stash, float x, float y)
 	fons__vertex(stash, x+0, y+h, 0, 1, 0xffffffff);
 	fons__vertex(stash, x+w, y+h, 1, 1, 0xffffffff);
 
-	// Drawbug draw atlas
-	for (i = 0; i < stash->atlas->nnodes; i++) {
-		FONSatlasNode* n = &stash->atlas->nodes[i];
+	// Drawbug draw atlas, a line along the top of every page in use
+	for (i = 0; i < stash->atlas->pagesX * stash->atlas->pagesY; i++) {
+		float px = (float)(i % stash->atlas->pagesX * FONS_PAGE_SIZE);
+		float py = (float)(i / stash->atlas->pagesX * FONS_PAGE_SIZE);
+		float pw = FONS_PAGE_SIZE;
 
+		if (stash->atlas->pages[i].cls == FONS_PAGE_FREE)
+			continue;
 		if (stash->nverts+6 > FONS_VERTEX_COUNT)
 			fons__flush(stash);
 
-		fons__vertex(stash, x+n->x+0, y+n->y+0, u, v, 0xc00000ff);
-		fons__vertex(stash, x+n->x+n->width, y+n->y+1, u, v, 0xc00000ff);
-		fons__vertex(stash, x+n->x+n->width, y+n->y+0, u, v, 0xc00000ff);
+		fons__vertex(stash, x+px+0, y+py+0, u, v, 0xc00000ff);
+		fons__vertex(stash, x+px+pw, y+py+1, u, v, 0xc00000ff);
+		fons__vertex(stash, x+px+pw, y+py+0, u, v, 0xc00000ff);
 
-		fons__vertex(stash, x+n->x+0, y+n->y+0, u, v, 0xc00000ff);
-		fons__vertex(stash, x+n->x+0, y+n->y+1, u, v, 0xc00000ff);
-		fons__vertex(stash, x+n->x+n->width, y+n->y+1, u, v, 0xc00000ff);
+		fons__vertex(stash, x+px+0, y+py+0, u, v, 0xc00000ff);
+		fons__vertex(stash, x+px+0, y+py+1, u, v, 0xc00000ff);
+		fons__vertex(stash, x+px+pw, y+py+1, u, v, 0xc00000ff);
 	}
 
 	fons__flush(stash);
@@ -1517,7 +2086,7 @@ float fonsTextBounds(FONScontext* stash,
 	FONSglyph* glyph = NULL;
 	int prevGlyphIndex = -1;
 	short isize = (short)(state->size*10.0f);
-	short iblur = (short)state->blur;
+	short iblur = fons__glyphBlur(state);
 	float scale;
 	FONSfont* font;
 	float startx, advance;
@@ -1545,7 +2114,7 @@ float fonsTextBounds(FONScontext* stash,
 			continue;
 		glyph = fons__getGlyph(stash, font, codepoint, isize, iblur, FONS_GLYPH_BITMAP_OPTIONAL);
 		if (glyph != NULL) {
-			fons__getQuad(stash, font, prevGlyphIndex, glyph, scale, state->spacing, &x, &y, &q);
+			fons__getQuad(stash, font, prevGlyphIndex, glyph, isize, scale, state->spacing, &x, &y, &q);
 			if (q.x0 < minx) minx = q.x0;
 			if (q.x1 > maxx) maxx = q.x1;
 			if (stash->params.flags & FONS_ZERO_TOPLEFT) {
@@ -1667,6 +2236,7 @@ void fonsDeleteInternal(FONScontext* stash)
 	if (stash->fonts) free(stash->fonts);
 	if (stash->texData) free(stash->texData);
 	if (stash->scratch) free(stash->scratch);
+	if (stash->jobs) free(stash->jobs);
 	fons__tt_done(stash);
 	free(stash);
 }
@@ -1687,7 +2257,7 @@ void fonsGetAtlasSize(FONScontext* stash, int* width, int* height)
 
 int fonsExpandAtlas(FONScontext* stash, int width, int height)
 {
-	int i, maxy = 0;
+	int i;
 	unsigned char* data = NULL;
 	if (stash == NULL) return 0;
 
@@ -1709,6 +2279,10 @@ int fonsExpandAtlas(FONScontext* stash, int width, int height)
 	data = (unsigned char*)malloc(width * height);
 	if (data == NULL)
 		return 0;
+	if (!fons__atlasExpand(stash, width, height)) {
+		free(data);
+		return 0;
+	}
 	for (i = 0; i < stash->params.height; i++) {
 		unsigned char* dst = &data[i*width];
 		unsigned char* src = &stash->texData[i*stash->params.width];
@@ -1722,16 +2296,11 @@ int fonsExpandAtlas(FONScontext* stash, int width, int height)
 	free(stash->texData);
 	stash->texData = data;
 
-	// Increase atlas size
-	fons__atlasExpand(stash->atlas, width, height);
-
 	// Add existing data as dirty.
-	for (i = 0; i < stash->atlas->nnodes; i++)
-		maxy = fons__maxi(maxy, stash->atlas->nodes[i].y);
 	stash->dirtyRect[0] = 0;
 	stash->dirtyRect[1] = 0;
 	stash->dirtyRect[2] = stash->params.width;
-	stash->dirtyRect[3] = maxy;
+	stash->dirtyRect[3] = stash->params.height;
 
 	stash->params.width = width;
 	stash->params.height = height;
@@ -1756,7 +2325,8 @@ int fonsResetAtlas(FONScontext* stash, int width, int height)
 	}
 
 	// Reset atlas
-	fons__atlasReset(stash->atlas, width, height);
+	if (!fons__atlasReset(stash, width, height))
+		return 0;
 
 	// Clear texture data.
 	stash->texData = (unsigned char*)realloc(stash->texData, width * height);
@@ -1777,6 +2347,10 @@ int fonsResetAtlas(FONScontext* stash, int width, int height)
 			font->lut[j] = -1;
 	}
 
+	// Queued and outstanding jobs lost their glyphs.
+	stash->njobs = 0;
+	stash->epoch++;
+
 	stash->params.width = width;
 	stash->params.height = height;
 	stash->itw = 1.0f/stash->params.width;
@@ -1788,5 +2362,337 @@ int fonsResetAtlas(FONScontext* stash, int width, int height)
 	return 1;
 }
 
+void fonsBeginFrame(FONScontext* stash)
+{
+	if (stash == NULL) return;
+	stash->frame++;
+}
+
+void fonsSetEviction(FONScontext* stash, int enabled)
+{
+	if (stash == NULL) return;
+	stash->evict = enabled;
+}
+
+void fonsTouchGlyphs(FONScontext* stash, const int* slots, int nslots)
+{
+	int i;
+	if (stash == NULL) return;
+	for (i = 0; i < nslots; i++) {
+		if (slots[i] != -1)
+			fons__atlasTouch(stash, slots[i]);
+	}
+}
+
+int fonsAtlasGeneration(FONScontext* stash)
+{
+	if (stash == NULL) return 0;
+	return stash->generation;
+}
+
+void fonsGetAtlasStats(FONScontext* stash, FONSatlasStats* stats)
+{
+	int i;
+	memset(stats, 0, sizeof(*stats));
+	if (stash == NULL) return;
+	stats->width = stash->params.width;
+	stats->height = stash->params.height;
+	stats->pages = stash->atlas->pagesX * stash->atlas->pagesY;
+	for (i = 0; i < stats->pages; i++) {
+		if (stash->atlas->pages[i].cls == FONS_PAGE_FREE)
+			stats->freePages++;
+	}
+	stats->glyphs = stash->atlas->nglyphs;
+	stats->usedPixels = stash->atlas->usedPixels;
+	stats->rasterizations = stash->rasterizations;
+	stats->evictions = stash->evictions;
+	stats->queued = stash->njobs;
+}
+
+static void fons__putInt(unsigned char* p, unsigned int v, int n)
+{
+	int i;
+	for (i = 0; i < n; i++)
+		p[i] = (unsigned char)(v >> (8*i));
+}
+
+static unsigned int fons__getInt(const unsigned char* p, int n)
+{
+	unsigned int v = 0;
+	int i;
+	for (i = 0; i < n; i++)
+		v |= (unsigned int)p[i] << (8*i);
+	return v;
+}
+
+static unsigned int fons__fontHash(FONSfont* font)
+{
+	// FNV-1a, the data does not change once added.
+	if (font->hash == 0) {
+		unsigned int h = 2166136261u;
+		int i;
+		for (i = 0; i < font->dataSize; i++)
+			h = (h ^ font->data[i]) * 16777619u;
+		h = (h ^ (unsigned int)font->index) * 16777619u;
+		font->hash = h != 0 ? h : 1;
+	}
+	return font->hash;
+}
+
+int fonsSaveGlyphCache(FONScontext* stash, unsigned char* data, int ndata)
+{
+	int i, j, y, gw, gh, count = 0, size = FONS_CACHE_HEADER;
+	unsigned char* p;
+
+	if (stash == NULL) return 0;
+
+	for (i = 0; i < stash->nfonts; i++) {
+		FONSfont* font = stash->fonts[i];
+		for (j = 0; j < font->nglyphs; j++) {
+			FONSglyph* glyph = &font->glyphs[j];
+			if (glyph->x0 < 0) continue;
+			size += FONS_CACHE_ENTRY + (glyph->x1-glyph->x0) * (glyph->y1-glyph->y0);
+			count++;
+		}
+	}
+	if (data == NULL || ndata < size) return size;
+
+	memcpy(data, FONS_CACHE_MAGIC, 8);
+	fons__putInt(data+8, FONS_CACHE_VERSION, 4);
+	fons__putInt(data+12, FONS_SDF_SIZE, 4);
+	fons__putInt(data+16, FONS_SDF_PAD, 4);
+	fons__putInt(data+20, (unsigned int)count, 4);
+	p = data + FONS_CACHE_HEADER;
+
+	for (i = 0; i < stash->nfonts; i++) {
+		FONSfont* font = stash->fonts[i];
+		for (j = 0; j < font->nglyphs; j++) {
+			FONSglyph* glyph = &font->glyphs[j];
+			if (glyph->x0 < 0) continue;
+			gw = glyph->x1-glyph->x0;
+			gh = glyph->y1-glyph->y0;
+			fons__putInt(p, fons__fontHash(font), 4);
+			fons__putInt(p+4, glyph->codepoint, 4);
+			fons__putInt(p+8, (unsigned short)glyph->size, 2);
+			fons__putInt(p+10, (unsigned short)glyph->blur, 2);
+			fons__putInt(p+12, (unsigned int)glyph->index, 4);
+			fons__putInt(p+16, (unsigned short)glyph->xadv, 2);
+			fons__putInt(p+18, (unsigned short)glyph->xoff, 2);
+			fons__putInt(p+20, (unsigned short)glyph->yoff, 2);
+			fons__putInt(p+22, (unsigned int)gw, 2);
+			fons__putInt(p+24, (unsigned int)gh, 2);
+			p += FONS_CACHE_ENTRY;
+			for (y = 0; y < gh; y++) {
+				memcpy(p, &stash->texData[glyph->x0 + (glyph->y0+y) * stash->params.width], gw);
+				p += gw;
+			}
+		}
+	}
+
+	return size;
+}
+
+// Places a cached glyph unless it is resident already. Returns 0 when the atlas is full.
+static int fons__loadCachedGlyph(FONScontext* stash, FONSfont* font, const unsigned char* entry, const unsigned char* pixels)
+{
+	unsigned int codepoint = fons__getInt(entry+4, 4);
+	short size = (short)fons__getInt(entry+8, 2);
+	short blur = (short)fons__getInt(entry+10, 2);
+	int gw = (int)fons__getInt(entry+22, 2);
+	int gh = (int)fons__getInt(entry+24, 2);
+	unsigned int h = fons__hashint(codepoint) & (FONS_HASH_LUT_SIZE-1);
+	FONSglyph* glyph = NULL;
+	FONSslot* s;
+	int i, y, slot;
+
+	for (i = font->lut[h]; i != -1; i = font->glyphs[i].next) {
+		if (font->glyphs[i].codepoint == codepoint && font->glyphs[i].size == size && font->glyphs[i].blur == blur) {
+			glyph = &font->glyphs[i];
+			break;
+		}
+	}
+	if (glyph != NULL && glyph->x0 >= 0) return 1;
+
+	slot = fons__atlasAddRect(stash, gw, gh);
+	if (slot == -1) return 0;
+
+	if (glyph == NULL) {
+		glyph = fons__allocGlyph(font);
+		if (glyph == NULL) return 1;
+		glyph->codepoint = codepoint;
+		glyph->size = size;
+		glyph->blur = blur;
+		glyph->next = font->lut[h];
+		font->lut[h] = font->nglyphs-1;
+	}
+	s = fons__atlasSlot(stash->atlas, slot);
+	s->font = font;
+	s->glyph = (int)(glyph - font->glyphs);
+	stash->atlas->nglyphs++;
+
+	glyph->index = (int)fons__getInt(entry+12, 4);
+	glyph->slot = slot;
+	glyph->x0 = s->x;
+	glyph->y0 = s->y;
+	glyph->x1 = (short)(glyph->x0+gw);
+	glyph->y1 = (short)(glyph->y0+gh);
+	glyph->xadv = (short)fons__getInt(entry+16, 2);
+	glyph->xoff = (short)fons__getInt(entry+18, 2);
+	glyph->yoff = (short)fons__getInt(entry+20, 2);
+
+	for (y = 0; y < gh; y++)
+		memcpy(&stash->texData[glyph->x0 + (glyph->y0+y) * stash->params.width], &pixels[y*gw], gw);
+
+	stash->dirtyRect[0] = fons__mini(stash->dirtyRect[0], glyph->x0);
+	stash->dirtyRect[1] = fons__mini(stash->dirtyRect[1], glyph->y0);
+	stash->dirtyRect[2] = fons__maxi(stash->dirtyRect[2], glyph->x1);
+	stash->dirtyRect[3] = fons__maxi(stash->dirtyRect[3], glyph->y1);
+
+	return 1;
+}
+
+int fonsLoadGlyphCache(FONScontext* stash, const unsigned char* data, int ndata, int font)
+{
+	const unsigned char* p;
+	const unsigned char* end;
+	int i, j, count, sdf, npixels;
+
+	if (stash == NULL || data == NULL || ndata < FONS_CACHE_HEADER) return -1;
+	if (memcmp(data, FONS_CACHE_MAGIC, 8) != 0 || fons__getInt(data+8, 4) != FONS_CACHE_VERSION) return -1;
+
+	// Distance fields baked with other parameters would be scaled wrong.
+	sdf = fons__getInt(data+12, 4) == FONS_SDF_SIZE && fons__getInt(data+16, 4) == FONS_SDF_PAD;
+	count = (int)fons__getInt(data+20, 4);
+	p = data + FONS_CACHE_HEADER;
+	end = data + ndata;
+
+	for (i = 0; i < count; i++) {
+		if (end - p < FONS_CACHE_ENTRY) return -1;
+		npixels = (int)fons__getInt(p+22, 2) * (int)fons__getInt(p+24, 2);
+		if (npixels == 0 || end - p - FONS_CACHE_ENTRY < npixels) return -1;
+
+		if (sdf || (short)fons__getInt(p+10, 2) != FONS_SDF_BLUR) {
+			for (j = 0; j < stash->nfonts; j++) {
+				if (font != FONS_INVALID && j != font) continue;
+				if (stash->fonts[j]->data == NULL || fons__fontHash(stash->fonts[j]) != fons__getInt(p, 4)) continue;
+				if (!fons__loadCachedGlyph(stash, stash->fonts[j], p, p + FONS_CACHE_ENTRY)) return 0;
+			}
+		}
+		p += FONS_CACHE_ENTRY + npixels;
+	}
+
+	return 1;
+}
+
+int fonsTakeGlyphJobs(FONScontext* stash, FONSglyphJob* jobs, int maxJobs)
+{
+	int n;
+	if (stash == NULL) return 0;
+	if (jobs == NULL) return stash->njobs;
+	n = fons__mini(maxJobs, stash->njobs);
+	if (n <= 0) return 0;
+	memcpy(jobs, stash->jobs, sizeof(FONSglyphJob) * n);
+	memmove(stash->jobs, &stash->jobs[n], sizeof(FONSglyphJob) * (stash->njobs - n));
+	stash->njobs -= n;
+	return n;
+}
+
+void fonsRasterizeGlyphJob(FONSglyphJob* job)
+{
+	if (job->font == NULL || job->bitmap != NULL) return;
+	job->bitmap = (unsigned char*)calloc((size_t)job->width * job->height, 1);
+	if (job->bitmap == NULL) return;
+	fons__renderGlyph(&job->face, job->bitmap, job->width, job->height, job->width,
+					  job->pad, job->scale, job->index, job->blur);
+}
+
+int fonsCommitGlyphJob(FONScontext* stash, FONSglyphJob* job)
+{
+	FONSglyph* glyph;
+	FONSslot* s;
+	unsigned char* dst;
+	int slot, y;
+
+	if (stash == NULL) return 0;
+	glyph = fons__jobGlyph(stash, job);
+	if (glyph == NULL || glyph->x0 >= 0 || job->bitmap == NULL) {
+		fonsCancelGlyphJob(stash, job);
+		return 0;
+	}
+
+	slot = fons__atlasAddRect(stash, job->width, job->height);
+	if (slot == -1) return -1;
+
+	s = fons__atlasSlot(stash->atlas, slot);
+	s->font = job->font;
+	s->glyph = job->glyph;
+	stash->atlas->nglyphs++;
+	stash->rasterizations++;
+
+	glyph->slot = slot;
+	glyph->x0 = s->x;
+	glyph->y0 = s->y;
+	glyph->x1 = (short)(glyph->x0+job->width);
+	glyph->y1 = (short)(glyph->y0+job->height);
+
+	dst = &stash->texData[glyph->x0 + glyph->y0 * stash->params.width];
+	for (y = 0; y < job->height; y++)
+		memcpy(&dst[y*stash->params.width], &job->bitmap[y*job->width], job->width);
+
+	stash->dirtyRect[0] = fons__mini(stash->dirtyRect[0], glyph->x0);
+	stash->dirtyRect[1] = fons__mini(stash->dirtyRect[1], glyph->y0);
+	stash->dirtyRect[2] = fons__maxi(stash->dirtyRect[2], glyph->x1);
+	stash->dirtyRect[3] = fons__maxi(stash->dirtyRect[3], glyph->y1);
+
+	free(job->bitmap);
+	job->bitmap = NULL;
+	job->font = NULL;
+	return 1;
+}
+
+void fonsCancelGlyphJob(FONScontext* stash, FONSglyphJob* job)
+{
+	FONSglyph* glyph = stash != NULL ? fons__jobGlyph(stash, job) : NULL;
+	if (glyph != NULL && glyph->slot == FONS_GLYPH_QUEUED)
+		glyph->slot = -1;
+	free(job->bitmap);
+	job->bitmap = NULL;
+	job->font = NULL;
+}
+
+int fonsPrewarmGlyphs(FONScontext* stash, unsigned int first, unsigned int last)
+{
+	FONSstate* state = fons__getState(stash);
+	FONSfont* font;
+	unsigned int codepoint;
+	short isize, iblur;
+	int i, g, njobs;
+
+	if (stash == NULL) return 0;
+	if (state->font < 0 || state->font >= stash->nfonts) return 0;
+	font = stash->fonts[state->font];
+	if (font->data == NULL) return 0;
+
+	isize = (short)(state->size*10.0f);
+	iblur = fons__glyphBlur(state);
+	njobs = stash->njobs;
+
+	if (last > FONS_MAX_CODEPOINT) last = FONS_MAX_CODEPOINT;
+	if (first > last) return 0;
+
+	// the counter must not wrap past last, so the loop ends on it rather than after it
+	for (codepoint = first; ; codepoint++) {
+		// Skip codepoints no font has rather than queueing a missing glyph box for each.
+		g = fons__tt_getGlyphIndex(&font->font, codepoint);
+		for (i = 0; g == 0 && i < font->nfallbacks; i++)
+			g = fons__tt_getGlyphIndex(&stash->fonts[font->fallbacks[i]]->font, codepoint);
+		if (g != 0)
+			fons__getGlyph(stash, font, codepoint, isize, iblur, FONS_GLYPH_BITMAP_DEFERRED);
+		if (codepoint == last) break;
+	}
+
+	return stash->njobs - njobs;
+}
+
 
 #endif
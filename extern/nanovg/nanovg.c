@@ -20,6 +20,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <memory.h>
+#include <time.h>
 
 #include "nanovg.h"
 #define FONTSTASH_IMPLEMENTATION
@@ -38,7 +39,9 @@
 #endif
 
 #define NVG_INIT_FONTIMAGE_SIZE  512
-#define NVG_MAX_FONTIMAGE_SIZE   2048
+#ifndef NVG_MAX_FONTIMAGE_SIZE
+#define NVG_MAX_FONTIMAGE_SIZE   2048	// glyphs unused this frame are evicted once the atlas is this big
+#endif
 #define NVG_MAX_FONTIMAGES       4
 
 #define NVG_INIT_COMMANDS_SIZE 256
@@ -46,6 +49,10 @@
 #define NVG_INIT_PATHS_SIZE 16
 #define NVG_INIT_VERTS_SIZE 256
 
+// Limits of the stencil-free fill path, larger fills use the stencil.
+#define NVG_MAX_TRIANGULATE_PATHS 32
+#define NVG_MAX_TRIANGULATE_POINTS 256
+
 #ifndef NVG_MAX_STATES
 #define NVG_MAX_STATES 32
 #endif
@@ -87,6 +94,8 @@ struct NVGstate {
 	float letterSpacing;
 	float lineHeight;
 	float fontBlur;
+	int fontSDF;
+	int textDeferred;
 	int textAlign;
 	int fontId;
 };
@@ -111,6 +120,8 @@ struct NVGpathCache {
 	NVGvertex* verts;
 	int nverts;
 	int cverts;
+	int* indices;	// ear clipping scratch
+	int cindices;
 	float bounds[4];
 };
 typedef struct NVGpathCache NVGpathCache;
@@ -128,15 +139,37 @@ struct NVGcontext {
 	float distTol;
 	float fringeWidth;
 	float devicePxRatio;
+	float viewWidth, viewHeight;
 	struct FONScontext* fs;
 	int fontImages[NVG_MAX_FONTIMAGES];
 	int fontImageIdx;
+	int fontAtlasResets;
+	struct FONSglyphJob* glyphJobs;	// batch taken by nvgTakeGlyphJobs
+	int nglyphJobs;
+	int cglyphJobs;
+	int textSkipped;
 	int drawCallCount;
 	int fillTriCount;
 	int strokeTriCount;
 	int textTriCount;
+	int convexFillCount;
+	int triangulatedFillCount;
+	int stencilFillCount;
+	int culledCount;
+	int textureUploadCount;
+	int textureUploadBytes;
+	double tessTime;
+	double flushTime;
+	NVGallocator allocator;		// per-frame arrays, malloc/realloc when alloc is NULL
 };
 
+static double nvg__time(void)
+{
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
 static float nvg__sqrtf(float a) { return sqrtf(a); }
 static float nvg__modf(float a, float b) { return fmodf(a, b); }
 static float nvg__sinf(float a) { return sinf(a); }
@@ -166,17 +199,58 @@ static float nvg__normalize(float *x, float* y)
 	return d;
 }
 
+// Grows a per-frame array. Frame allocators cannot resize, so the used part is copied to a new
+// block and the old one is left to the allocator's reset.
+static void* nvg__realloc(NVGcontext* ctx, void* ptr, int used, int size)
+{
+	void* p;
+	if (ctx->allocator.alloc == NULL)
+		return realloc(ptr, size);
+	p = ctx->allocator.alloc(ctx->allocator.userPtr, size);
+	if (p != NULL && ptr != NULL && used > 0)
+		memcpy(p, ptr, used);
+	return p;
+}
+
+static void nvg__free(NVGcontext* ctx, void* ptr)
+{
+	if (ctx->allocator.alloc == NULL)
+		free(ptr);
+}
+
+// Replaces an empty per-frame array with a new one of the same capacity.
+static void nvg__reacquire(NVGcontext* ctx, void** ptr, int* capacity, int elemSize)
+{
+	*ptr = *capacity > 0 ? nvg__realloc(ctx, NULL, 0, *capacity * elemSize) : NULL;
+	if (*ptr == NULL)
+		*capacity = 0;
+}
 
-static void nvg__deletePathCache(NVGpathCache* c)
+static void nvg__reacquireFrameArrays(NVGcontext* ctx)
+{
+	NVGpathCache* c = ctx->cache;
+	ctx->ncommands = 0;
+	c->npoints = 0;
+	c->npaths = 0;
+	c->nverts = 0;
+	nvg__reacquire(ctx, (void**)&ctx->commands, &ctx->ccommands, sizeof(float));
+	nvg__reacquire(ctx, (void**)&c->points, &c->cpoints, sizeof(NVGpoint));
+	nvg__reacquire(ctx, (void**)&c->paths, &c->cpaths, sizeof(NVGpath));
+	nvg__reacquire(ctx, (void**)&c->verts, &c->cverts, sizeof(NVGvertex));
+	nvg__reacquire(ctx, (void**)&c->indices, &c->cindices, sizeof(int));
+}
+
+static void nvg__deletePathCache(NVGcontext* ctx, NVGpathCache* c)
 {
 	if (c == NULL) return;
-	if (c->points != NULL) free(c->points);
-	if (c->paths != NULL) free(c->paths);
-	if (c->verts != NULL) free(c->verts);
+	nvg__free(ctx, c->points);
+	nvg__free(ctx, c->paths);
+	nvg__free(ctx, c->verts);
+	nvg__free(ctx, c->indices);
 	free(c);
 }
 
-static NVGpathCache* nvg__allocPathCache(void)
+static NVGpathCache* nvg__allocPathCache(NVGcontext* ctx)
 {
 	NVGpathCache* c = (NVGpathCache*)malloc(sizeof(NVGpathCache));
 	if (c == NULL) goto error;
@@ -199,7 +273,7 @@ static NVGpathCache* nvg__allocPathCache(void)
 
 	return c;
 error:
-	nvg__deletePathCache(c);
+	nvg__deletePathCache(ctx, c);
 	return NULL;
 }
 
@@ -306,7 +380,7 @@ NVGcontext* nvgCreateInternal(NVGparams* params)
 	ctx->ncommands = 0;
 	ctx->ccommands = NVG_INIT_COMMANDS_SIZE;
 
-	ctx->cache = nvg__allocPathCache();
+	ctx->cache = nvg__allocPathCache(ctx);
 	if (ctx->cache == NULL) goto error;
 
 	nvgSave(ctx);
@@ -328,6 +402,7 @@ NVGcontext* nvgCreateInternal(NVGparams* params)
 	fontParams.userPtr = NULL;
 	ctx->fs = fonsCreateInternal(&fontParams);
 	if (ctx->fs == NULL) goto error;
+	fonsSetEviction(ctx->fs, NVG_INIT_FONTIMAGE_SIZE >= NVG_MAX_FONTIMAGE_SIZE);
 
 	// Create font texture
 	ctx->fontImages[0] = ctx->params.renderCreateTexture(ctx->params.userPtr, NVG_TEXTURE_ALPHA, fontParams.width, fontParams.height, 0, NULL);
@@ -350,8 +425,12 @@ void nvgDeleteInternal(NVGcontext* ctx)
 {
 	int i;
 	if (ctx == NULL) return;
-	if (ctx->commands != NULL) free(ctx->commands);
-	if (ctx->cache != NULL) nvg__deletePathCache(ctx->cache);
+	nvg__free(ctx, ctx->commands);
+	if (ctx->cache != NULL) nvg__deletePathCache(ctx, ctx->cache);
+
+	for (i = 0; i < ctx->nglyphJobs; i++)
+		fonsCancelGlyphJob(ctx->fs, &ctx->glyphJobs[i]);
+	free(ctx->glyphJobs);
 
 	if (ctx->fs)
 		fonsDeleteInternal(ctx->fs);
@@ -371,22 +450,33 @@ void nvgDeleteInternal(NVGcontext* ctx)
 
 void nvgBeginFrame(NVGcontext* ctx, float windowWidth, float windowHeight, float devicePixelRatio)
 {
-/*	printf("Tris: draws:%d  fill:%d  stroke:%d  text:%d  TOT:%d\n",
-		ctx->drawCallCount, ctx->fillTriCount, ctx->strokeTriCount, ctx->textTriCount,
-		ctx->fillTriCount+ctx->strokeTriCount+ctx->textTriCount);*/
-
 	ctx->nstates = 0;
 	nvgSave(ctx);
 	nvgReset(ctx);
 
 	nvg__setDevicePixelRatio(ctx, devicePixelRatio);
 
+	// the allocator was reset, last frame's arrays are gone
+	if (ctx->allocator.alloc != NULL)
+		nvg__reacquireFrameArrays(ctx);
+
 	ctx->params.renderViewport(ctx->params.userPtr, windowWidth, windowHeight, devicePixelRatio);
+	fonsBeginFrame(ctx->fs);
+	ctx->viewWidth = windowWidth;
+	ctx->viewHeight = windowHeight;
 
 	ctx->drawCallCount = 0;
 	ctx->fillTriCount = 0;
 	ctx->strokeTriCount = 0;
 	ctx->textTriCount = 0;
+	ctx->convexFillCount = 0;
+	ctx->triangulatedFillCount = 0;
+	ctx->stencilFillCount = 0;
+	ctx->culledCount = 0;
+	ctx->textureUploadCount = 0;
+	ctx->textureUploadBytes = 0;
+	ctx->tessTime = 0.0;
+	ctx->flushTime = 0.0;
 }
 
 void nvgCancelFrame(NVGcontext* ctx)
@@ -396,7 +486,9 @@ void nvgCancelFrame(NVGcontext* ctx)
 
 void nvgEndFrame(NVGcontext* ctx)
 {
+	double start = nvg__time();
 	ctx->params.renderFlush(ctx->params.userPtr);
+	ctx->flushTime += nvg__time() - start;
 	if (ctx->fontImageIdx != 0) {
 		int fontImage = ctx->fontImages[ctx->fontImageIdx];
 		ctx->fontImages[ctx->fontImageIdx] = 0;
@@ -667,6 +759,8 @@ void nvgReset(NVGcontext* ctx)
 	state->letterSpacing = 0.0f;
 	state->lineHeight = 1.0f;
 	state->fontBlur = 0.0f;
+	state->fontSDF = 0;
+	state->textDeferred = 0;
 	state->textAlign = NVG_ALIGN_LEFT | NVG_ALIGN_BASELINE;
 	state->fontId = 0;
 }
@@ -842,6 +936,23 @@ void nvgImageSize(NVGcontext* ctx, int image, int* w, int* h)
 	ctx->params.renderGetTextureSize(ctx->params.userPtr, image, w, h);
 }
 
+void nvgUpdateImageRegion(NVGcontext* ctx, int image, int x, int y, int w, int h, const unsigned char* data)
+{
+	ctx->params.renderUpdateTexture(ctx->params.userPtr, image, x,y, w,h, data);
+}
+
+int nvgCreateImageLevels(NVGcontext* ctx, int w, int h, int nlevels, int imageFlags)
+{
+	if (ctx->params.renderCreateTextureLevels == NULL) return 0;
+	return ctx->params.renderCreateTextureLevels(ctx->params.userPtr, w, h, nlevels, imageFlags);
+}
+
+void nvgUpdateImageLevel(NVGcontext* ctx, int image, int level, const unsigned char* data)
+{
+	if (ctx->params.renderUpdateTextureLevel != NULL)
+		ctx->params.renderUpdateTextureLevel(ctx->params.userPtr, image, level, data);
+}
+
 void nvgDeleteImage(NVGcontext* ctx, int image)
 {
 	ctx->params.renderDeleteTexture(ctx->params.userPtr, image);
@@ -1029,6 +1140,37 @@ void nvgResetScissor(NVGcontext* ctx)
 	state->scissor.extent[1] = -1.0f;
 }
 
+int nvgCullRect(NVGcontext* ctx, float x, float y, float w, float h, float outset)
+{
+	NVGstate* state = nvg__getState(ctx);
+	float* t = state->xform;
+	float* s = state->scissor.xform;
+	float ex = nvg__absf(w)*0.5f + outset;
+	float ey = nvg__absf(h)*0.5f + outset;
+	float cx = x + w*0.5f, cy = y + h*0.5f;
+	float tx, ty, tex, tey, sex, sey;
+	int culled;
+
+	// Axis aligned bounds of the transformed rectangle, in window space.
+	tx = t[0]*cx + t[2]*cy + t[4];
+	ty = t[1]*cx + t[3]*cy + t[5];
+	tex = nvg__absf(t[0])*ex + nvg__absf(t[2])*ey;
+	tey = nvg__absf(t[1])*ex + nvg__absf(t[3])*ey;
+
+	culled = tx+tex <= 0.0f || ty+tey <= 0.0f || tx-tex >= ctx->viewWidth || ty-tey >= ctx->viewHeight;
+
+	// Scissor bounds the same way, its xform already maps to window space.
+	if (!culled && state->scissor.extent[0] >= 0.0f) {
+		sex = nvg__absf(s[0])*state->scissor.extent[0] + nvg__absf(s[2])*state->scissor.extent[1];
+		sey = nvg__absf(s[1])*state->scissor.extent[0] + nvg__absf(s[3])*state->scissor.extent[1];
+		culled = nvg__absf(tx - s[4]) >= tex + sex || nvg__absf(ty - s[5]) >= tey + sey;
+	}
+
+	if (culled)
+		ctx->culledCount++;
+	return culled;
+}
+
 // Global composite operation.
 void nvgGlobalCompositeOperation(NVGcontext* ctx, int op)
 {
@@ -1085,7 +1227,7 @@ static void nvg__appendCommands(NVGcontext* ctx, float* vals, int nvals)
 	if (ctx->ncommands+nvals > ctx->ccommands) {
 		float* commands;
 		int ccommands = ctx->ncommands+nvals + ctx->ccommands/2;
-		commands = (float*)realloc(ctx->commands, sizeof(float)*ccommands);
+		commands = (float*)nvg__realloc(ctx, ctx->commands, sizeof(float)*ctx->ncommands, sizeof(float)*ccommands);
 		if (commands == NULL) return;
 		ctx->commands = commands;
 		ctx->ccommands = ccommands;
@@ -1151,7 +1293,7 @@ static void nvg__addPath(NVGcontext* ctx)
 	if (ctx->cache->npaths+1 > ctx->cache->cpaths) {
 		NVGpath* paths;
 		int cpaths = ctx->cache->npaths+1 + ctx->cache->cpaths/2;
-		paths = (NVGpath*)realloc(ctx->cache->paths, sizeof(NVGpath)*cpaths);
+		paths = (NVGpath*)nvg__realloc(ctx, ctx->cache->paths, sizeof(NVGpath)*ctx->cache->npaths, sizeof(NVGpath)*cpaths);
 		if (paths == NULL) return;
 		ctx->cache->paths = paths;
 		ctx->cache->cpaths = cpaths;
@@ -1188,7 +1330,7 @@ static void nvg__addPoint(NVGcontext* ctx, float x, float y, int flags)
 	if (ctx->cache->npoints+1 > ctx->cache->cpoints) {
 		NVGpoint* points;
 		int cpoints = ctx->cache->npoints+1 + ctx->cache->cpoints/2;
-		points = (NVGpoint*)realloc(ctx->cache->points, sizeof(NVGpoint)*cpoints);
+		points = (NVGpoint*)nvg__realloc(ctx, ctx->cache->points, sizeof(NVGpoint)*ctx->cache->npoints, sizeof(NVGpoint)*cpoints);
 		if (points == NULL) return;
 		ctx->cache->points = points;
 		ctx->cache->cpoints = cpoints;
@@ -1230,7 +1372,7 @@ static NVGvertex* nvg__allocTempVerts(NVGcontext* ctx, int nverts)
 	if (nverts > ctx->cache->cverts) {
 		NVGvertex* verts;
 		int cverts = (nverts + 0xff) & ~0xff; // Round up to prevent allocations when things change just slightly.
-		verts = (NVGvertex*)realloc(ctx->cache->verts, sizeof(NVGvertex)*cverts);
+		verts = (NVGvertex*)nvg__realloc(ctx, ctx->cache->verts, sizeof(NVGvertex)*ctx->cache->nverts, sizeof(NVGvertex)*cverts);
 		if (verts == NULL) return NULL;
 		ctx->cache->verts = verts;
 		ctx->cache->cverts = cverts;
@@ -1849,22 +1991,173 @@ static int nvg__expandStroke(NVGcontext* ctx, float w, float fringe, int lineCap
 	return 1;
 }
 
+static int nvg__segmentsCross(const NVGpoint* a, const NVGpoint* b, const NVGpoint* c, const NVGpoint* d)
+{
+	float d1 = nvg__triarea2(a->x,a->y, b->x,b->y, c->x,c->y);
+	float d2 = nvg__triarea2(a->x,a->y, b->x,b->y, d->x,d->y);
+	float d3 = nvg__triarea2(c->x,c->y, d->x,d->y, a->x,a->y);
+	float d4 = nvg__triarea2(c->x,c->y, d->x,d->y, b->x,b->y);
+	return ((d1 > 0.0f && d2 < 0.0f) || (d1 < 0.0f && d2 > 0.0f)) &&
+		   ((d3 > 0.0f && d4 < 0.0f) || (d3 < 0.0f && d4 > 0.0f));
+}
+
+static int nvg__isSimplePolygon(const NVGpoint* pts, int npts)
+{
+	int i, j;
+	for (i = 0; i < npts; i++) {
+		// skip the neighbouring edges, they share a point
+		for (j = i+2; j < npts; j++) {
+			if (i == 0 && j == npts-1) continue;
+			if (nvg__segmentsCross(&pts[i], &pts[i+1], &pts[j], &pts[(j+1) % npts]))
+				return 0;
+		}
+	}
+	return 1;
+}
+
+// A fill can skip the stencil when its paths are simple solid polygons far enough apart that
+// no fringe reaches another path, then nonzero winding is the same as drawing each on its own.
+static int nvg__canTriangulate(NVGcontext* ctx)
+{
+	NVGpathCache* cache = ctx->cache;
+	float bounds[NVG_MAX_TRIANGULATE_PATHS][4];
+	float margin = ctx->fringeWidth;
+	int i, j, maxcount = 0;
+
+	if (cache->npaths > NVG_MAX_TRIANGULATE_PATHS)
+		return 0;
+
+	for (i = 0; i < cache->npaths; i++) {
+		NVGpath* path = &cache->paths[i];
+		NVGpoint* pts = &cache->points[path->first];
+		float* b = bounds[i];
+
+		if (path->winding != NVG_CCW || path->count > NVG_MAX_TRIANGULATE_POINTS)
+			return 0;
+		if (!path->convex && !nvg__isSimplePolygon(pts, path->count))
+			return 0;
+		// the inset outline of a bevelled concave corner folds over itself, that needs the stencil
+		for (j = 0; j < path->count; j++) {
+			if ((pts[j].flags & NVG_PR_INNERBEVEL) || (pts[j].flags & (NVG_PT_BEVEL | NVG_PT_LEFT)) == NVG_PT_BEVEL)
+				return 0;
+		}
+
+		b[0] = b[2] = pts[0].x;
+		b[1] = b[3] = pts[0].y;
+		for (j = 1; j < path->count; j++) {
+			b[0] = nvg__minf(b[0], pts[j].x);
+			b[1] = nvg__minf(b[1], pts[j].y);
+			b[2] = nvg__maxf(b[2], pts[j].x);
+			b[3] = nvg__maxf(b[3], pts[j].y);
+		}
+		for (j = 0; j < i; j++) {
+			if (b[0] - margin <= bounds[j][2] && b[2] + margin >= bounds[j][0] &&
+				b[1] - margin <= bounds[j][3] && b[3] + margin >= bounds[j][1])
+				return 0;
+		}
+		maxcount = nvg__maxi(maxcount, path->count + path->nbevel + 1);
+	}
+
+	if (maxcount > cache->cindices) {
+		int* indices = (int*)nvg__realloc(ctx, cache->indices, 0, sizeof(int) * maxcount);
+		if (indices == NULL) return 0;
+		cache->indices = indices;
+		cache->cindices = maxcount;
+	}
+	return 1;
+}
+
+static int nvg__isEar(const NVGvertex* poly, const int* indices, int count, int k, float sign)
+{
+	const NVGvertex* a = &poly[indices[(k + count - 1) % count]];
+	const NVGvertex* b = &poly[indices[k]];
+	const NVGvertex* c = &poly[indices[(k + 1) % count]];
+	int i;
+
+	for (i = 0; i < count; i++) {
+		const NVGvertex* p = &poly[indices[i]];
+		if (p == a || p == b || p == c) continue;
+		if ((p->x == a->x && p->y == a->y) || (p->x == b->x && p->y == b->y) || (p->x == c->x && p->y == c->y))
+			continue;
+		if (nvg__triarea2(a->x,a->y, b->x,b->y, p->x,p->y) * sign >= 0.0f &&
+			nvg__triarea2(b->x,b->y, c->x,c->y, p->x,p->y) * sign >= 0.0f &&
+			nvg__triarea2(c->x,c->y, a->x,a->y, p->x,p->y) * sign >= 0.0f)
+			return 0;
+	}
+	return 1;
+}
+
+// Ear clips a simple polygon into a triangle list with the winding of the polygon, returns the
+// number of vertices written to dst. Convex polygons become their fan.
+static int nvg__triangulate(NVGcontext* ctx, const NVGvertex* poly, int npoly, int convex, NVGvertex* dst)
+{
+	int* indices = ctx->cache->indices;
+	int i, k = 0, count = npoly, misses = 0;
+	NVGvertex* start = dst;
+	float area = 0.0f, sign;
+
+	for (i = 0; i < npoly; i++)
+		indices[i] = i;
+
+	if (!convex) {
+		for (i = 2; i < npoly; i++)
+			area += nvg__triarea2(poly[0].x,poly[0].y, poly[i-1].x,poly[i-1].y, poly[i].x,poly[i].y);
+		sign = area < 0.0f ? -1.0f : 1.0f;
+
+		while (count > 3 && misses < count) {
+			const NVGvertex* a = &poly[indices[(k + count - 1) % count]];
+			const NVGvertex* b = &poly[indices[k]];
+			const NVGvertex* c = &poly[indices[(k + 1) % count]];
+			float cross = nvg__triarea2(a->x,a->y, b->x,b->y, c->x,c->y) * sign;
+			if (cross < 0.0f || (cross > 0.0f && !nvg__isEar(poly, indices, count, k, sign))) {
+				k = (k + 1) % count;
+				misses++;
+				continue;
+			}
+			// collinear points are dropped without a triangle
+			if (cross > 0.0f) {
+				*dst++ = *a;
+				*dst++ = *b;
+				*dst++ = *c;
+			}
+			memmove(&indices[k], &indices[k+1], sizeof(int) * (count - k - 1));
+			count--;
+			// the previous point has a new neighbour, look at it again
+			k = (k + count - 1) % count;
+			misses = 0;
+		}
+	}
+
+	// the last triangle, or what is left if rounding stopped the clipping
+	for (i = 1; i+1 < count; i++) {
+		*dst++ = poly[indices[0]];
+		*dst++ = poly[indices[i]];
+		*dst++ = poly[indices[i+1]];
+	}
+	return (int)(dst - start);
+}
+
 static int nvg__expandFill(NVGcontext* ctx, float w, int lineJoin, float miterLimit)
 {
 	NVGpathCache* cache = ctx->cache;
 	NVGvertex* verts;
 	NVGvertex* dst;
-	int cverts, convex, i, j;
+	int cverts, convex, triangulate, i, j;
 	float aa = ctx->fringeWidth;
 	int fringe = w > 0.0f;
 
 	nvg__calculateJoins(ctx, w, lineJoin, miterLimit);
 
+	convex = cache->npaths == 1 && cache->paths[0].convex;
+	triangulate = !convex && nvg__canTriangulate(ctx);
+
 	// Calculate max vertex usage.
 	cverts = 0;
 	for (i = 0; i < cache->npaths; i++) {
 		NVGpath* path = &cache->paths[i];
 		cverts += path->count + path->nbevel + 1;
+		if (triangulate)
+			cverts += (path->count + path->nbevel + 1) * 3;
 		if (fringe)
 			cverts += (path->count + path->nbevel*5 + 1) * 2; // plus one for loop
 	}
@@ -1872,8 +2165,6 @@ static int nvg__expandFill(NVGcontext* ctx, float w, int lineJoin, float miterLi
 	verts = nvg__allocTempVerts(ctx, cverts);
 	if (verts == NULL) return 0;
 
-	convex = cache->npaths == 1 && cache->paths[0].convex;
-
 	for (i = 0; i < cache->npaths; i++) {
 		NVGpath* path = &cache->paths[i];
 		NVGpoint* pts = &cache->points[path->first];
@@ -1924,6 +2215,13 @@ static int nvg__expandFill(NVGcontext* ctx, float w, int lineJoin, float miterLi
 		path->nfill = (int)(dst - verts);
 		verts = dst;
 
+		path->triangles = triangulate;
+		if (triangulate) {
+			path->nfill = nvg__triangulate(ctx, path->fill, path->nfill, path->convex, verts);
+			path->fill = verts;
+			verts += path->nfill;
+		}
+
 		// Calculate fringe
 		if (fringe) {
 			lw = w + woff;
@@ -1935,7 +2233,7 @@ static int nvg__expandFill(NVGcontext* ctx, float w, int lineJoin, float miterLi
 
 			// Create only half a fringe for convex shapes so that
 			// the shape can be rendered without stenciling.
-			if (convex) {
+			if (convex || triangulate) {
 				lw = woff;	// This should generate the same vertex as fill inset above.
 				lu = 0.5f;	// Set outline fade at middle.
 			}
@@ -2229,6 +2527,7 @@ void nvgFill(NVGcontext* ctx)
 	NVGstate* state = nvg__getState(ctx);
 	const NVGpath* path;
 	NVGpaint fillPaint = state->fill;
+	double start = nvg__time();
 	int i;
 
 	nvg__flattenPaths(ctx);
@@ -2244,13 +2543,22 @@ void nvgFill(NVGcontext* ctx)
 	ctx->params.renderFill(ctx->params.userPtr, &fillPaint, state->compositeOperation, &state->scissor, ctx->fringeWidth,
 						   ctx->cache->bounds, ctx->cache->paths, ctx->cache->npaths);
 
+	if (ctx->cache->npaths == 1 && ctx->cache->paths[0].convex)
+		ctx->convexFillCount++;
+	else if (ctx->cache->npaths > 0 && ctx->cache->paths[0].triangles)
+		ctx->triangulatedFillCount++;
+	else if (ctx->cache->npaths > 0)
+		ctx->stencilFillCount++;
+
 	// Count triangles
 	for (i = 0; i < ctx->cache->npaths; i++) {
 		path = &ctx->cache->paths[i];
-		ctx->fillTriCount += path->nfill-2;
+		ctx->fillTriCount += path->triangles ? path->nfill/3 : path->nfill-2;
 		ctx->fillTriCount += path->nstroke-2;
 		ctx->drawCallCount += 2;
 	}
+
+	ctx->tessTime += nvg__time() - start;
 }
 
 void nvgStroke(NVGcontext* ctx)
@@ -2260,9 +2568,9 @@ void nvgStroke(NVGcontext* ctx)
 	float strokeWidth = nvg__clampf(state->strokeWidth * scale, 0.0f, 200.0f);
 	NVGpaint strokePaint = state->stroke;
 	const NVGpath* path;
+	double start = nvg__time();
 	int i;
 
-
 	if (strokeWidth < ctx->fringeWidth) {
 		// If the stroke width is less than pixel size, use alpha to emulate coverage.
 		// Since coverage is area, scale by alpha*alpha.
@@ -2292,6 +2600,8 @@ void nvgStroke(NVGcontext* ctx)
 		ctx->strokeTriCount += path->nstroke-2;
 		ctx->drawCallCount++;
 	}
+
+	ctx->tessTime += nvg__time() - start;
 }
 
 // Add fonts
@@ -2356,6 +2666,18 @@ void nvgFontBlur(NVGcontext* ctx, float blur)
 	state->fontBlur = blur;
 }
 
+void nvgFontSDF(NVGcontext* ctx, int enabled)
+{
+	NVGstate* state = nvg__getState(ctx);
+	state->fontSDF = enabled;
+}
+
+void nvgTextDeferred(NVGcontext* ctx, int enabled)
+{
+	NVGstate* state = nvg__getState(ctx);
+	state->textDeferred = enabled;
+}
+
 void nvgTextLetterSpacing(NVGcontext* ctx, float spacing)
 {
 	NVGstate* state = nvg__getState(ctx);
@@ -2411,16 +2733,19 @@ static void nvg__flushTextTexture(NVGcontext* ctx)
 			int w = dirty[2] - dirty[0];
 			int h = dirty[3] - dirty[1];
 			ctx->params.renderUpdateTexture(ctx->params.userPtr, fontImage, x,y, w,h, data);
+			ctx->textureUploadCount++;
+			ctx->textureUploadBytes += w*h;
 		}
 	}
 }
 
 static int nvg__allocTextAtlas(NVGcontext* ctx)
 {
-	int iw, ih;
+	int iw, ih, cw, ch;
 	nvg__flushTextTexture(ctx);
 	if (ctx->fontImageIdx >= NVG_MAX_FONTIMAGES-1)
 		return 0;
+	nvgImageSize(ctx, ctx->fontImages[ctx->fontImageIdx], &cw, &ch);
 	// if next fontImage already have a texture
 	if (ctx->fontImages[ctx->fontImageIdx+1] != 0)
 		nvgImageSize(ctx, ctx->fontImages[ctx->fontImageIdx+1], &iw, &ih);
@@ -2435,7 +2760,13 @@ static int nvg__allocTextAtlas(NVGcontext* ctx)
 		ctx->fontImages[ctx->fontImageIdx+1] = ctx->params.renderCreateTexture(ctx->params.userPtr, NVG_TEXTURE_ALPHA, iw, ih, 0, NULL);
 	}
 	++ctx->fontImageIdx;
-	fonsResetAtlas(ctx->fs, iw, ih);
+	// A bigger image keeps every glyph where it is and receives them all on the next flush.
+	// At the size limit the glyphs of this frame alone filled the atlas, so start it over.
+	if (!(iw >= cw && ih >= ch && (iw > cw || ih > ch) && fonsExpandAtlas(ctx->fs, iw, ih))) {
+		fonsResetAtlas(ctx->fs, iw, ih);
+		ctx->fontAtlasResets++;
+	}
+	fonsSetEviction(ctx->fs, iw >= NVG_MAX_FONTIMAGE_SIZE && ih >= NVG_MAX_FONTIMAGE_SIZE);
 	return 1;
 }
 
@@ -2443,6 +2774,8 @@ static void nvg__renderText(NVGcontext* ctx, NVGvertex* verts, int nverts)
 {
 	NVGstate* state = nvg__getState(ctx);
 	NVGpaint paint = state->fill;
+	// Distance field glyphs are smoothed over one device pixel at the size they end up drawn.
+	float sdfEdge = fonsSDFEdgeWidth(ctx->fs, state->fontSize * nvg__getAverageScale(state->xform) * ctx->devicePxRatio);
 
 	// Render triangles.
 	paint.image = ctx->fontImages[ctx->fontImageIdx];
@@ -2451,12 +2784,17 @@ static void nvg__renderText(NVGcontext* ctx, NVGvertex* verts, int nverts)
 	paint.innerColor.a *= state->alpha;
 	paint.outerColor.a *= state->alpha;
 
-	ctx->params.renderTriangles(ctx->params.userPtr, &paint, state->compositeOperation, &state->scissor, verts, nverts, ctx->fringeWidth);
+	ctx->params.renderTriangles(ctx->params.userPtr, &paint, state->compositeOperation, &state->scissor, verts, nverts, ctx->fringeWidth, sdfEdge);
 
 	ctx->drawCallCount++;
 	ctx->textTriCount += nverts/3;
 }
 
+static int nvg__glyphBitmap(NVGstate* state)
+{
+	return state->textDeferred ? FONS_GLYPH_BITMAP_DEFERRED : FONS_GLYPH_BITMAP_REQUIRED;
+}
+
 static int nvg__isTransformFlipped(const float *xform)
 {
 	float det = xform[0] * xform[3] - xform[2] * xform[1];
@@ -2474,6 +2812,7 @@ float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char*
 	int cverts = 0;
 	int nverts = 0;
 	int isFlipped = nvg__isTransformFlipped(state->xform);
+	double start = nvg__time();
 
 	if (end == NULL)
 		end = string + strlen(string);
@@ -2483,6 +2822,7 @@ float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char*
 	fonsSetSize(ctx->fs, state->fontSize*scale);
 	fonsSetSpacing(ctx->fs, state->letterSpacing*scale);
 	fonsSetBlur(ctx->fs, state->fontBlur*scale);
+	fonsSetSDF(ctx->fs, state->fontSDF);
 	fonsSetAlign(ctx->fs, state->textAlign);
 	fonsSetFont(ctx->fs, state->fontId);
 
@@ -2490,7 +2830,7 @@ float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char*
 	verts = nvg__allocTempVerts(ctx, cverts);
 	if (verts == NULL) return x;
 
-	fonsTextIterInit(ctx->fs, &iter, x*scale, y*scale, string, end, FONS_GLYPH_BITMAP_REQUIRED);
+	fonsTextIterInit(ctx->fs, &iter, x*scale, y*scale, string, end, nvg__glyphBitmap(state));
 	prevIter = iter;
 	while (fonsTextIterNext(ctx->fs, &iter, &q)) {
 		float c[4*2];
@@ -2507,6 +2847,10 @@ float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char*
 				break;
 		}
 		prevIter = iter;
+		if (iter.slot == -1) { // deferred glyph still being rasterized
+			ctx->textSkipped++;
+			continue;
+		}
 		if(isFlipped) {
 			float tmp;
 
@@ -2534,9 +2878,302 @@ float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char*
 
 	nvg__renderText(ctx, verts, nverts);
 
+	ctx->tessTime += nvg__time() - start;
 	return iter.nextx / scale;
 }
 
+void nvgImageQuad(NVGcontext* ctx, float x, float y, float w, float h, int image, float s0, float t0, float s1, float t1, float alpha)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGpaint paint;
+	NVGvertex* verts;
+	float c[4*2];
+
+	verts = nvg__allocTempVerts(ctx, 6);
+	if (verts == NULL) return;
+
+	// Same paint for every quad of an image, so quads sharing a texture merge like glyphs.
+	memset(&paint, 0, sizeof(paint));
+	nvgTransformIdentity(paint.xform);
+	paint.image = image;
+	paint.innerColor = paint.outerColor = nvgRGBAf(1,1,1,alpha*state->alpha);
+
+	nvgTransformPoint(&c[0],&c[1], state->xform, x, y);
+	nvgTransformPoint(&c[2],&c[3], state->xform, x+w, y);
+	nvgTransformPoint(&c[4],&c[5], state->xform, x+w, y+h);
+	nvgTransformPoint(&c[6],&c[7], state->xform, x, y+h);
+	nvg__vset(&verts[0], c[0], c[1], s0, t0);
+	nvg__vset(&verts[1], c[4], c[5], s1, t1);
+	nvg__vset(&verts[2], c[2], c[3], s1, t0);
+	nvg__vset(&verts[3], c[0], c[1], s0, t0);
+	nvg__vset(&verts[4], c[6], c[7], s0, t1);
+	nvg__vset(&verts[5], c[4], c[5], s1, t1);
+
+	ctx->params.renderTriangles(ctx->params.userPtr, &paint, state->compositeOperation, &state->scissor, verts, 6, ctx->fringeWidth, 0.0f);
+
+	ctx->drawCallCount++;
+	ctx->fillTriCount += 2;
+}
+
+int nvgTextRun(NVGcontext* ctx, const char* string, const char* end, NVGvertex* verts, int* slots, int maxVerts)
+{
+	NVGstate* state = nvg__getState(ctx);
+	FONStextIter iter, prevIter;
+	FONSquad q;
+	float scale = nvg__getFontScale(state) * ctx->devicePxRatio;
+	float invscale = 1.0f / scale;
+	int nverts = 0;
+	double start = nvg__time();
+
+	if (end == NULL)
+		end = string + strlen(string);
+
+	if (state->fontId == FONS_INVALID) return 0;
+
+	fonsSetSize(ctx->fs, state->fontSize*scale);
+	fonsSetSpacing(ctx->fs, state->letterSpacing*scale);
+	fonsSetBlur(ctx->fs, state->fontBlur*scale);
+	fonsSetSDF(ctx->fs, state->fontSDF);
+	fonsSetAlign(ctx->fs, state->textAlign);
+	fonsSetFont(ctx->fs, state->fontId);
+
+	fonsTextIterInit(ctx->fs, &iter, 0, 0, string, end, nvg__glyphBitmap(state));
+	prevIter = iter;
+	while (fonsTextIterNext(ctx->fs, &iter, &q)) {
+		if (iter.prevGlyphIndex == -1) { // can not retrieve glyph?
+			if (!nvg__allocTextAtlas(ctx))
+				break; // no memory :(
+			if (nverts != 0) {
+				// quads emitted so far point into the old atlas, lay out again
+				nverts = 0;
+				fonsTextIterInit(ctx->fs, &iter, 0, 0, string, end, nvg__glyphBitmap(state));
+				prevIter = iter;
+				continue;
+			}
+			iter = prevIter;
+			fonsTextIterNext(ctx->fs, &iter, &q); // try again
+			if (iter.prevGlyphIndex == -1) // still can not find glyph?
+				break;
+		}
+		prevIter = iter;
+		if (iter.slot == -1) { // deferred glyph still being rasterized
+			ctx->textSkipped++;
+			continue;
+		}
+		if (nverts+6 <= maxVerts) {
+			float x0 = q.x0*invscale, y0 = q.y0*invscale;
+			float x1 = q.x1*invscale, y1 = q.y1*invscale;
+			if (slots != NULL)
+				slots[nverts/6] = iter.slot;
+			nvg__vset(&verts[nverts], x0, y0, q.s0, q.t0); nverts++;
+			nvg__vset(&verts[nverts], x1, y1, q.s1, q.t1); nverts++;
+			nvg__vset(&verts[nverts], x1, y0, q.s1, q.t0); nverts++;
+			nvg__vset(&verts[nverts], x0, y0, q.s0, q.t0); nverts++;
+			nvg__vset(&verts[nverts], x0, y1, q.s0, q.t1); nverts++;
+			nvg__vset(&verts[nverts], x1, y1, q.s1, q.t1); nverts++;
+		}
+	}
+
+	nvg__flushTextTexture(ctx);
+
+	ctx->tessTime += nvg__time() - start;
+	return nverts;
+}
+
+void nvgTextRunDraw(NVGcontext* ctx, float x, float y, const NVGvertex* verts, const int* slots, int nverts)
+{
+	NVGstate* state = nvg__getState(ctx);
+	const float* t = state->xform;
+	NVGvertex* dst;
+	double start = nvg__time();
+	int i;
+
+	if (nverts <= 0) return;
+
+	dst = nvg__allocTempVerts(ctx, nverts);
+	if (dst == NULL) return;
+
+	// the run may have been laid out under another text style
+	fonsSetBlur(ctx->fs, state->fontBlur*nvg__getFontScale(state)*ctx->devicePxRatio);
+	fonsSetSDF(ctx->fs, state->fontSDF);
+
+	// bitmap glyphs snap to whole pixels like nvgText, the run's own offsets already are
+	if (!state->fontSDF) {
+		float scale = nvg__getFontScale(state) * ctx->devicePxRatio;
+		x = floorf(x*scale) / scale;
+		y = floorf(y*scale) / scale;
+	}
+
+	if (t[0] == 1.0f && t[1] == 0.0f && t[2] == 0.0f && t[3] == 1.0f) {
+		// translation only, the common case for UI labels
+		float ox = x + t[4], oy = y + t[5];
+		for (i = 0; i < nverts; i++) {
+			nvg__vset(&dst[i], verts[i].x + ox, verts[i].y + oy, verts[i].u, verts[i].v);
+		}
+	} else {
+		for (i = 0; i < nverts; i++) {
+			float px, py;
+			nvgTransformPoint(&px, &py, t, verts[i].x + x, verts[i].y + y);
+			nvg__vset(&dst[i], px, py, verts[i].u, verts[i].v);
+		}
+	}
+
+	// keep the glyphs from being evicted for the rest of the frame
+	if (slots != NULL)
+		fonsTouchGlyphs(ctx->fs, slots, nverts/6);
+
+	nvg__flushTextTexture(ctx);
+
+	nvg__renderText(ctx, dst, nverts);
+
+	ctx->tessTime += nvg__time() - start;
+}
+
+int nvgTextAtlasGeneration(NVGcontext* ctx)
+{
+	return fonsAtlasGeneration(ctx->fs);
+}
+
+void nvgTextAtlasStats(NVGcontext* ctx, NVGtextAtlasStats* stats)
+{
+	FONSatlasStats fs;
+	fonsGetAtlasStats(ctx->fs, &fs);
+	memset(stats, 0, sizeof(*stats));
+	stats->width = fs.width;
+	stats->height = fs.height;
+	stats->glyphs = fs.glyphs;
+	stats->usedPixels = fs.usedPixels;
+	stats->rasterizations = fs.rasterizations;
+	stats->evictions = fs.evictions;
+	stats->resets = ctx->fontAtlasResets;
+	stats->generation = fonsAtlasGeneration(ctx->fs);
+	stats->pending = fs.queued + ctx->nglyphJobs;
+}
+
+int nvgTextSkippedGlyphs(NVGcontext* ctx)
+{
+	return ctx->textSkipped;
+}
+
+int nvgTextPrewarm(NVGcontext* ctx, unsigned int first, unsigned int last)
+{
+	NVGstate* state = nvg__getState(ctx);
+	float scale = nvg__getFontScale(state) * ctx->devicePxRatio;
+
+	if (state->fontId == FONS_INVALID) return 0;
+
+	fonsSetSize(ctx->fs, state->fontSize*scale);
+	fonsSetBlur(ctx->fs, state->fontBlur*scale);
+	fonsSetSDF(ctx->fs, state->fontSDF);
+	fonsSetFont(ctx->fs, state->fontId);
+
+	return fonsPrewarmGlyphs(ctx->fs, first, last);
+}
+
+int nvgSaveGlyphCache(NVGcontext* ctx, unsigned char* data, int ndata)
+{
+	return fonsSaveGlyphCache(ctx->fs, data, ndata);
+}
+
+int nvgLoadGlyphCache(NVGcontext* ctx, const unsigned char* data, int ndata, int font)
+{
+	int result;
+
+	// Grow the atlas as drawing would until the cached glyphs fit.
+	while ((result = fonsLoadGlyphCache(ctx->fs, data, ndata, font)) == 0) {
+		if (!nvg__allocTextAtlas(ctx))
+			break;
+	}
+
+	nvg__flushTextTexture(ctx);
+
+	return result;
+}
+
+int nvgTakeGlyphJobs(NVGcontext* ctx)
+{
+	int n = fonsTakeGlyphJobs(ctx->fs, NULL, 0);
+
+	if (ctx->nglyphJobs != 0 || n == 0) return 0;
+
+	if (n > ctx->cglyphJobs) {
+		FONSglyphJob* jobs = (FONSglyphJob*)realloc(ctx->glyphJobs, sizeof(FONSglyphJob) * n);
+		if (jobs == NULL) return 0;
+		ctx->glyphJobs = jobs;
+		ctx->cglyphJobs = n;
+	}
+
+	ctx->nglyphJobs = fonsTakeGlyphJobs(ctx->fs, ctx->glyphJobs, n);
+	return ctx->nglyphJobs;
+}
+
+void nvgRasterizeGlyphJob(NVGcontext* ctx, int index)
+{
+	if (index < 0 || index >= ctx->nglyphJobs) return;
+	fonsRasterizeGlyphJob(&ctx->glyphJobs[index]);
+}
+
+int nvgCommitGlyphJobs(NVGcontext* ctx)
+{
+	int i, placed = 0;
+
+	for (i = 0; i < ctx->nglyphJobs; i++) {
+		FONSglyphJob* job = &ctx->glyphJobs[i];
+		int result = fonsCommitGlyphJob(ctx->fs, job);
+		if (result < 0 && nvg__allocTextAtlas(ctx))
+			result = fonsCommitGlyphJob(ctx->fs, job);
+		if (result < 0) // the glyph gets queued again when next drawn
+			fonsCancelGlyphJob(ctx->fs, job);
+		if (result > 0)
+			placed++;
+	}
+	ctx->nglyphJobs = 0;
+
+	nvg__flushTextTexture(ctx);
+
+	return placed;
+}
+
+void nvgFrameStats(NVGcontext* ctx, NVGframeStats* stats)
+{
+	memset(stats, 0, sizeof(*stats));
+	stats->drawCallCount = ctx->drawCallCount;
+	stats->fillTriCount = ctx->fillTriCount;
+	stats->strokeTriCount = ctx->strokeTriCount;
+	stats->textTriCount = ctx->textTriCount;
+	stats->convexFillCount = ctx->convexFillCount;
+	stats->triangulatedFillCount = ctx->triangulatedFillCount;
+	stats->stencilFillCount = ctx->stencilFillCount;
+	stats->culledCount = ctx->culledCount;
+	stats->textureUploadCount = ctx->textureUploadCount;
+	stats->textureUploadBytes = ctx->textureUploadBytes;
+	stats->tessTime = ctx->tessTime;
+	stats->flushTime = ctx->flushTime;
+
+	if (ctx->params.renderGetStats != NULL)
+		ctx->params.renderGetStats(ctx->params.userPtr, stats);
+}
+
+void nvgSetFrameAllocator(NVGcontext* ctx, const NVGallocator* allocator)
+{
+	NVGpathCache* c = ctx->cache;
+
+	nvg__free(ctx, ctx->commands);
+	nvg__free(ctx, c->points);
+	nvg__free(ctx, c->paths);
+	nvg__free(ctx, c->verts);
+	nvg__free(ctx, c->indices);
+
+	if (allocator != NULL)
+		ctx->allocator = *allocator;
+	else
+		memset(&ctx->allocator, 0, sizeof(ctx->allocator));
+	nvg__reacquireFrameArrays(ctx);
+
+	if (ctx->params.renderSetFrameAllocator != NULL)
+		ctx->params.renderSetFrameAllocator(ctx->params.userPtr, allocator);
+}
+
 void nvgTextBox(NVGcontext* ctx, float x, float y, float breakRowWidth, const char* string, const char* end)
 {
 	NVGstate* state = nvg__getState(ctx);
@@ -2590,6 +3227,7 @@ int nvgTextGlyphPositions(NVGcontext* ctx, float x, float y, const char* string,
 	fonsSetSize(ctx->fs, state->fontSize*scale);
 	fonsSetSpacing(ctx->fs, state->letterSpacing*scale);
 	fonsSetBlur(ctx->fs, state->fontBlur*scale);
+	fonsSetSDF(ctx->fs, state->fontSDF);
 	fonsSetAlign(ctx->fs, state->textAlign);
 	fonsSetFont(ctx->fs, state->fontId);
 
@@ -2654,6 +3292,7 @@ int nvgTextBreakLines(NVGcontext* ctx, const char* string, const char* end, floa
 	fonsSetSize(ctx->fs, state->fontSize*scale);
 	fonsSetSpacing(ctx->fs, state->letterSpacing*scale);
 	fonsSetBlur(ctx->fs, state->fontBlur*scale);
+	fonsSetSDF(ctx->fs, state->fontSDF);
 	fonsSetAlign(ctx->fs, state->textAlign);
 	fonsSetFont(ctx->fs, state->fontId);
 
@@ -2838,6 +3477,7 @@ float nvgTextBounds(NVGcontext* ctx, float x, float y, const char* string, const
 	fonsSetSize(ctx->fs, state->fontSize*scale);
 	fonsSetSpacing(ctx->fs, state->letterSpacing*scale);
 	fonsSetBlur(ctx->fs, state->fontBlur*scale);
+	fonsSetSDF(ctx->fs, state->fontSDF);
 	fonsSetAlign(ctx->fs, state->textAlign);
 	fonsSetFont(ctx->fs, state->fontId);
 
@@ -2882,6 +3522,7 @@ void nvgTextBoxBounds(NVGcontext* ctx, float x, float y, float breakRowWidth, co
 	fonsSetSize(ctx->fs, state->fontSize*scale);
 	fonsSetSpacing(ctx->fs, state->letterSpacing*scale);
 	fonsSetBlur(ctx->fs, state->fontBlur*scale);
+	fonsSetSDF(ctx->fs, state->fontSDF);
 	fonsSetAlign(ctx->fs, state->textAlign);
 	fonsSetFont(ctx->fs, state->fontId);
 	fonsLineBounds(ctx->fs, 0, &rminy, &rmaxy);
@@ -2933,6 +3574,7 @@ void nvgTextMetrics(NVGcontext* ctx, float* ascender, float* descender, float* l
 	fonsSetSize(ctx->fs, state->fontSize*scale);
 	fonsSetSpacing(ctx->fs, state->letterSpacing*scale);
 	fonsSetBlur(ctx->fs, state->fontBlur*scale);
+	fonsSetSDF(ctx->fs, state->fontSDF);
 	fonsSetAlign(ctx->fs, state->textAlign);
 	fonsSetFont(ctx->fs, state->fontId);
 
@@ -382,12 +382,32 @@ int nvgCreateImageRGBA(NVGcontext* ctx, int w, int h, int imageFlags, const unsi
 // Updates image data specified by image handle.
 void nvgUpdateImage(NVGcontext* ctx, int image, const unsigned char* data);
 
+// Updates the w,h region at x,y of the image. Like nvgUpdateImage, data holds the whole image
+// and only the pixels of the region are read from it.
+void nvgUpdateImageRegion(NVGcontext* ctx, int image, int x, int y, int w, int h, const unsigned char* data);
+
+// Creates an RGBA image with nlevels mipmap levels supplied by the caller instead of generated,
+// each half the size of the one before, rounded down to at least 1 pixel. Nothing is uploaded:
+// fill the levels with nvgUpdateImageLevel from the smallest up, the image samples the finest
+// level filled in so far. Returns 0 when the renderer does not support it.
+int nvgCreateImageLevels(NVGcontext* ctx, int w, int h, int nlevels, int imageFlags);
+
+// Uploads a whole mipmap level of an image created with nvgCreateImageLevels.
+void nvgUpdateImageLevel(NVGcontext* ctx, int image, int level, const unsigned char* data);
+
 // Returns the dimensions of a created image.
 void nvgImageSize(NVGcontext* ctx, int image, int* w, int* h);
 
 // Deletes created image.
 void nvgDeleteImage(NVGcontext* ctx, int image);
 
+// Draws the rectangle x,y,w,h textured with the region (s0,t0)-(s1,t1) of the image, in
+// normalized image coordinates, tinted by alpha and the global alpha. The rectangle is
+// transformed by the current transform and drawn as two triangles without anti-aliased edges,
+// so quads from the same image, such as icons packed into one atlas, merge into one draw.
+// It does not touch the current path or fill.
+void nvgImageQuad(NVGcontext* ctx, float x, float y, float w, float h, int image, float s0, float t0, float s1, float t1, float alpha);
+
 //
 // Paints
 //
@@ -441,6 +461,12 @@ void nvgIntersectScissor(NVGcontext* ctx, float x, float y, float w, float h);
 // Reset and disables scissoring.
 void nvgResetScissor(NVGcontext* ctx);
 
+// Returns 1 if nothing drawn inside the rectangle, grown by outset on every side, can reach
+// a pixel inside the current scissor and frame, so the caller can skip building the shape.
+// The rectangle is transformed by the current transform. Culled rectangles are counted in
+// NVGframeStats culledCount.
+int nvgCullRect(NVGcontext* ctx, float x, float y, float w, float h, float outset);
+
 //
 // Paths
 //
@@ -577,6 +603,16 @@ void nvgFontSize(NVGcontext* ctx, float size);
 // Sets the blur of current text style.
 void nvgFontBlur(NVGcontext* ctx, float blur);
 
+// Sets whether the current text style draws glyphs from signed distance fields. One distance
+// field per glyph serves every size and scale, and glyphs are placed without pixel snapping.
+// Blurred text always uses bitmaps.
+void nvgFontSDF(NVGcontext* ctx, int enabled);
+
+// Sets whether the current text style leaves glyphs missing from the atlas out instead of
+// rasterizing them on the spot. They are queued as glyph jobs, see nvgTakeGlyphJobs(), and
+// drawn once committed.
+void nvgTextDeferred(NVGcontext* ctx, int enabled);
+
 // Sets the letter spacing of current text style.
 void nvgTextLetterSpacing(NVGcontext* ctx, float spacing);
 
@@ -654,9 +690,42 @@ struct NVGpath {
 	int nstroke;
 	int winding;
 	int convex;
+	int triangles;	// fill is a triangle list with a half fringe, drawn without the stencil like a convex fill
 };
 typedef struct NVGpath NVGpath;
 
+// Counters for the frame since the last nvgBeginFrame. Renderer counters cover the most
+// recent flush and stay zero for renderers without renderGetStats.
+struct NVGframeStats {
+	int drawCallCount;
+	int fillTriCount;
+	int strokeTriCount;
+	int textTriCount;
+	int convexFillCount;		// fills drawn without the stencil as a single convex fan
+	int triangulatedFillCount;	// fills drawn without the stencil as triangle lists
+	int stencilFillCount;		// fills that needed the stencil, e.g. self-intersecting or with holes
+	int culledCount;			// nvgCullRect calls that rejected their rectangle
+	int textureUploadCount;		// font atlas updates
+	int textureUploadBytes;
+	double tessTime;			// seconds spent building paths and text
+	double flushTime;			// seconds spent in renderFlush
+	// renderer
+	int rendererDrawCount;		// draw calls issued to the graphics API
+	int rendererStateChanges;	// texture, blend, stencil and uniform binds issued
+	int rendererUploadBytes;	// vertex and uniform data uploaded
+};
+typedef struct NVGframeStats NVGframeStats;
+
+// Source of the arrays rebuilt every frame: path commands, the path cache and the renderer's
+// calls and vertices. A block only has to stay valid until the next nvgBeginFrame, which takes
+// new ones at the size the last frame ended with, and blocks are never freed one by one, so a
+// linear arena reset before each nvgBeginFrame is enough.
+struct NVGallocator {
+	void* userPtr;
+	void* (*alloc)(void* uptr, int size);	// returns NULL when out of memory
+};
+typedef struct NVGallocator NVGallocator;
+
 struct NVGparams {
 	void* userPtr;
 	int edgeAntiAlias;
@@ -670,8 +739,12 @@ struct NVGparams {
 	void (*renderFlush)(void* uptr);
 	void (*renderFill)(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe, const float* bounds, const NVGpath* paths, int npaths);
 	void (*renderStroke)(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe, float strokeWidth, const NVGpath* paths, int npaths);
-	void (*renderTriangles)(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, const NVGvertex* verts, int nverts, float fringe);
+	void (*renderTriangles)(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, const NVGvertex* verts, int nverts, float fringe, float sdfEdge); // sdfEdge > 0 for distance field glyphs, see fonsSDFEdgeWidth
 	void (*renderDelete)(void* uptr);
+	void (*renderGetStats)(void* uptr, NVGframeStats* stats); // optional
+	void (*renderSetFrameAllocator)(void* uptr, const NVGallocator* allocator); // optional
+	int (*renderCreateTextureLevels)(void* uptr, int w, int h, int nlevels, int imageFlags); // optional, see nvgCreateImageLevels
+	int (*renderUpdateTextureLevel)(void* uptr, int image, int level, const unsigned char* data); // optional
 };
 typedef struct NVGparams NVGparams;
 
@@ -681,6 +754,73 @@ void nvgDeleteInternal(NVGcontext* ctx);
 
 NVGparams* nvgInternalParams(NVGcontext* ctx);
 
+// Lays out a single-line text string at the origin with the current text style without drawing it.
+// Writes six vertices per glyph (untransformed, atlas UVs) to verts, at most maxVerts, and returns the count.
+// Glyphs are rasterized into the font atlas as needed; the vertices remain valid until
+// nvgTextAtlasGeneration() changes. Six vertices per byte of text is always enough.
+// Deferred text leaves glyphs that are not rasterized yet out, see nvgTextSkippedGlyphs().
+// When slots is not NULL it receives the atlas slot of every glyph, one per six vertices.
+int nvgTextRun(NVGcontext* ctx, const char* string, const char* end, NVGvertex* verts, int* slots, int maxVerts);
+
+// Draws vertices from nvgTextRun() at the specified location with the current fill paint and transform.
+// Bitmap glyphs are moved by whole pixels, so left aligned text draws exactly as nvgText would.
+// Pass the run's slots to keep its glyphs from being evicted during the frame; they can only be
+// NULL when the run was laid out in the same frame.
+void nvgTextRunDraw(NVGcontext* ctx, float x, float y, const NVGvertex* verts, const int* slots, int nverts);
+
+// Returns a counter that changes whenever glyphs are evicted from, moved in or reset out of the
+// font atlas and previously laid out runs go stale.
+int nvgTextAtlasGeneration(NVGcontext* ctx);
+
+// Glyph atlas occupancy, counters are cumulative since creation.
+struct NVGtextAtlasStats {
+	int width, height;
+	int glyphs;				// glyph bitmaps resident in the atlas
+	int usedPixels;			// atlas area they cover, padding included
+	int rasterizations;		// glyph bitmaps rendered
+	int evictions;			// glyphs unused this frame dropped for others once the atlas stopped growing
+	int resets;				// times the glyphs of a single frame overflowed the atlas and it was cleared
+	int generation;			// nvgTextAtlasGeneration()
+	int pending;			// glyphs waiting on jobs, queued or taken
+};
+typedef struct NVGtextAtlasStats NVGtextAtlasStats;
+
+void nvgTextAtlasStats(NVGcontext* ctx, NVGtextAtlasStats* stats);
+
+// Counts the glyphs deferred text left out because they were not rasterized yet. Runs laid out
+// while it changed are incomplete and should not be kept.
+int nvgTextSkippedGlyphs(NVGcontext* ctx);
+
+// Queues glyph jobs for the codepoints first..last with the current font, size, blur and SDF
+// setting, as text drawn under the current transform would need them. last is inclusive, and
+// UINT_MAX prewarms up to the last Unicode codepoint. Returns the jobs added.
+int nvgTextPrewarm(NVGcontext* ctx, unsigned int first, unsigned int last);
+
+// Glyph caches store the rendered glyphs of the font atlas keyed by font data, codepoint, size
+// and blur. nvgSaveGlyphCache() writes them to data when ndata is enough and returns the size
+// needed. nvgLoadGlyphCache() puts the cached glyphs of font, or of all fonts when -1, into
+// the atlas without rasterizing, growing it as needed. Returns 1 when all of them fit, 0 when
+// the atlas is full and -1 when data is not a glyph cache.
+int nvgSaveGlyphCache(NVGcontext* ctx, unsigned char* data, int ndata);
+int nvgLoadGlyphCache(NVGcontext* ctx, const unsigned char* data, int ndata, int font);
+
+// Glyph jobs rasterize deferred glyphs off the rendering thread. nvgTakeGlyphJobs() moves the
+// queued jobs into a batch and returns its size, 0 while the previous batch is uncommitted.
+// nvgRasterizeGlyphJob() renders job index of the batch; it may run on any thread, concurrently
+// with other jobs and with drawing on ctx. nvgCommitGlyphJobs() places the finished batch in
+// the atlas and returns the glyphs placed. Call it on the rendering thread inside a frame,
+// once no job is running.
+int nvgTakeGlyphJobs(NVGcontext* ctx);
+void nvgRasterizeGlyphJob(NVGcontext* ctx, int index);
+int nvgCommitGlyphJobs(NVGcontext* ctx);
+
+// Returns the statistics of the current frame, complete after nvgEndFrame().
+void nvgFrameStats(NVGcontext* ctx, NVGframeStats* stats);
+
+// Moves the per-frame arrays of the context and its renderer to allocator, or back to
+// malloc/realloc for NULL. Call between frames. The allocator is copied.
+void nvgSetFrameAllocator(NVGcontext* ctx, const NVGallocator* allocator);
+
 // Debug function to dump cached path data.
 void nvgDebugDumpPathCache(NVGcontext* ctx);
 
@@ -32,6 +32,9 @@ enum NVGcreateFlags {
 	NVG_STENCIL_STROKES	= 1<<1,
 	// Flag indicating that additional debug checks are done.
 	NVG_DEBUG 			= 1<<2,
+	// Flag indicating that vertices and uniforms are written straight into triple-buffered mapped
+	// GPU buffers instead of being copied with glBufferData at flush. GL3 only, ignored elsewhere.
+	NVG_STREAM_BUFFERS	= 1<<3,
 };
 
 #if defined NANOVG_GL2_IMPLEMENTATION
@@ -51,6 +54,18 @@ enum NVGcreateFlags {
 
 #define NANOVG_GL_USE_STATE_FILTER (1)
 
+// Streamed buffers are persistently mapped when GL_ARB_buffer_storage is available. Set to 0 to
+// always map each frame's segment with glMapBufferRange instead.
+#ifndef NANOVG_GL_USE_BUFFER_STORAGE
+#define NANOVG_GL_USE_BUFFER_STORAGE (1)
+#endif
+
+// Adjacent convex fills and triangle calls that differ only in a solid colour are drawn
+// together at flush, with the colour moved into a vertex attribute.
+#ifndef NANOVG_GL_MERGE_CALLS
+#define NANOVG_GL_MERGE_CALLS (1)
+#endif
+
 // Creates NanoVG contexts for different OpenGL (ES) versions.
 // Flags should be combination of the create flags above.
 
@@ -141,12 +156,23 @@ struct GLNVGshader {
 };
 typedef struct GLNVGshader GLNVGshader;
 
+// Image ids are the texture's slot + 1 in the low bits and the slot's generation above them,
+// so lookups index the slot directly and ids of deleted images never match the slot's next
+// texture, until the generation wraps.
+#define GLNVG_TEXTURE_INDEX_BITS 20
+#define GLNVG_TEXTURE_INDEX_MASK ((1 << GLNVG_TEXTURE_INDEX_BITS) - 1)
+#define GLNVG_TEXTURE_GENERATION_MASK ((1 << (31 - GLNVG_TEXTURE_INDEX_BITS)) - 1)
+
 struct GLNVGtexture {
 	int id;
 	GLuint tex;
 	int width, height;
 	int type;
 	int flags;
+	int generation;
+	int nextFree;	// slot + 1 of the next free slot, 0 ends the list
+	int levels;		// mipmap levels of nvgCreateImageLevels images, 0 otherwise
+	int baseLevel;	// finest of them uploaded
 };
 typedef struct GLNVGtexture GLNVGtexture;
 
@@ -165,6 +191,7 @@ enum GLNVGcallType {
 	GLNVG_CONVEXFILL,
 	GLNVG_STROKE,
 	GLNVG_TRIANGLES,
+	GLNVG_MERGED,
 };
 
 struct GLNVGcall {
@@ -176,6 +203,12 @@ struct GLNVGcall {
 	int triangleCount;
 	int uniformOffset;
 	GLNVGblend blendFunc;
+	int merge;			// same state as the previous call apart from the solid colour
+	NVGcolor color;		// premultiplied
+	int vertOffset;		// vertex range, for merging
+	int vertCount;
+	int indexOffset;	// GLNVG_MERGED: triangleCount indices and vertCount colours
+	int colorOffset;
 };
 typedef struct GLNVGcall GLNVGcall;
 
@@ -184,6 +217,7 @@ struct GLNVGpath {
 	int fillCount;
 	int strokeOffset;
 	int strokeCount;
+	GLenum fillMode;	// GL_TRIANGLES for triangulated fills
 };
 typedef struct GLNVGpath GLNVGpath;
 
@@ -228,13 +262,32 @@ struct GLNVGfragUniforms {
 };
 typedef struct GLNVGfragUniforms GLNVGfragUniforms;
 
+#if defined NANOVG_GL3
+#define GLNVG_RING_SEGMENTS 3
+
+// Buffer split into equal segments. Each frame writes one while the GPU may still read the
+// previous ones; a fence per segment tells when it can be written again.
+struct GLNVGring {
+	GLuint buf;
+	GLenum target;
+	int segmentSize;	// bytes
+	int segment;		// being written, -1 between frames
+	int next;
+	int persistent;
+	unsigned char* map;	// whole buffer when persistent
+	unsigned char* ptr;	// segment being written
+	GLsync fences[GLNVG_RING_SEGMENTS];
+};
+typedef struct GLNVGring GLNVGring;
+#endif
+
 struct GLNVGcontext {
 	GLNVGshader shader;
 	GLNVGtexture* textures;
 	float view[2];
 	int ntextures;
 	int ctextures;
-	int textureId;
+	int freeTexture;	// slot + 1 of the first free slot, 0 when none
 	GLuint vertBuf;
 #if defined NANOVG_GL3
 	GLuint vertArr;
@@ -270,11 +323,118 @@ struct GLNVGcontext {
 	#endif
 
 	int dummyTex;
+
+#if defined NANOVG_GL3
+	// NVG_STREAM_BUFFERS
+	int streaming;
+	int bufferStorage;
+	GLNVGring vertRing;
+	GLNVGring fragRing;
+#endif
+	int vertBase;	// byte offsets of the frame's data in vertBuf and fragBuf
+	int fragBase;
+
+	// merged calls, see glnvg__mergeCalls
+	int mergeCall;					// call later ones may merge into, -1 for none
+	GLNVGfragUniforms mergeKey;		// its uniforms with the colours cleared
+	GLuint colorBuf;
+	GLuint indexBuf;
+	NVGcolor* colors;
+	int ccolors;
+	int ncolors;
+	GLushort* indices;
+	int cindices;
+	int nindices;
+
+	// counters of the last flush
+	int drawCount;
+	int stateChanges;
+	int uploadBytes;
+
+	NVGallocator allocator;		// per frame buffers, malloc/realloc when alloc is NULL
 };
 typedef struct GLNVGcontext GLNVGcontext;
 
 static int glnvg__maxi(int a, int b) { return a > b ? a : b; }
 
+// Grows a per frame buffer, copying the used part when the frame allocator cannot resize.
+static void* glnvg__realloc(GLNVGcontext* gl, void* ptr, int used, int size)
+{
+	void* p;
+	if (gl->allocator.alloc == NULL)
+		return realloc(ptr, size);
+	p = gl->allocator.alloc(gl->allocator.userPtr, size);
+	if (p != NULL && ptr != NULL && used > 0)
+		memcpy(p, ptr, used);
+	return p;
+}
+
+static void glnvg__free(GLNVGcontext* gl, void* ptr)
+{
+	if (gl->allocator.alloc == NULL)
+		free(ptr);
+}
+
+static void glnvg__reacquire(GLNVGcontext* gl, void** ptr, int* capacity, int elemSize)
+{
+	*ptr = *capacity > 0 ? glnvg__realloc(gl, NULL, 0, *capacity * elemSize) : NULL;
+	if (*ptr == NULL)
+		*capacity = 0;
+}
+
+static int glnvg__vertsInRing(GLNVGcontext* gl)
+{
+#if defined NANOVG_GL3
+	return gl->vertRing.ptr != NULL && (unsigned char*)gl->verts == gl->vertRing.ptr;
+#else
+	NVG_NOTUSED(gl);
+	return 0;
+#endif
+}
+
+static int glnvg__uniformsInRing(GLNVGcontext* gl)
+{
+#if defined NANOVG_GL3
+	return gl->fragRing.ptr != NULL && gl->uniforms == gl->fragRing.ptr;
+#else
+	NVG_NOTUSED(gl);
+	return 0;
+#endif
+}
+
+// Replaces the per frame buffers with empty ones of the same capacity. Ring segments are kept,
+// streamBegin moves on to the next one.
+static void glnvg__reacquireFrameBuffers(GLNVGcontext* gl)
+{
+	gl->ncalls = 0;
+	gl->npaths = 0;
+	gl->ncolors = 0;
+	gl->nindices = 0;
+	gl->mergeCall = -1;
+	glnvg__reacquire(gl, (void**)&gl->calls, &gl->ccalls, sizeof(GLNVGcall));
+	glnvg__reacquire(gl, (void**)&gl->paths, &gl->cpaths, sizeof(GLNVGpath));
+	glnvg__reacquire(gl, (void**)&gl->colors, &gl->ccolors, sizeof(NVGcolor));
+	glnvg__reacquire(gl, (void**)&gl->indices, &gl->cindices, sizeof(GLushort));
+	if (!glnvg__vertsInRing(gl)) {
+		gl->nverts = 0;
+		glnvg__reacquire(gl, (void**)&gl->verts, &gl->cverts, sizeof(NVGvertex));
+	}
+	if (!glnvg__uniformsInRing(gl)) {
+		gl->nuniforms = 0;
+		glnvg__reacquire(gl, (void**)&gl->uniforms, &gl->cuniforms, gl->fragSize);
+	}
+}
+
+static int glnvg__isStreaming(GLNVGcontext* gl)
+{
+#if defined NANOVG_GL3
+	return gl->streaming;
+#else
+	NVG_NOTUSED(gl);
+	return 0;
+#endif
+}
+
 #ifdef NANOVG_GLES2
 static unsigned int glnvg__nearestPow2(unsigned int num)
 {
@@ -295,9 +455,11 @@ static void glnvg__bindTexture(GLNVGcontext* gl, GLuint tex)
 	if (gl->boundTexture != tex) {
 		gl->boundTexture = tex;
 		glBindTexture(GL_TEXTURE_2D, tex);
+		gl->stateChanges++;
 	}
 #else
 	glBindTexture(GL_TEXTURE_2D, tex);
+	gl->stateChanges++;
 #endif
 }
 
@@ -307,9 +469,11 @@ static void glnvg__stencilMask(GLNVGcontext* gl, GLuint mask)
 	if (gl->stencilMask != mask) {
 		gl->stencilMask = mask;
 		glStencilMask(mask);
+		gl->stateChanges++;
 	}
 #else
 	glStencilMask(mask);
+	gl->stateChanges++;
 #endif
 }
 
@@ -324,9 +488,11 @@ static void glnvg__stencilFunc(GLNVGcontext* gl, GLenum func, GLint ref, GLuint
 		gl->stencilFuncRef = ref;
 		gl->stencilFuncMask = mask;
 		glStencilFunc(func, ref, mask);
+		gl->stateChanges++;
 	}
 #else
 	glStencilFunc(func, ref, mask);
+	gl->stateChanges++;
 #endif
 }
 static void glnvg__blendFuncSeparate(GLNVGcontext* gl, const GLNVGblend* blend)
@@ -339,24 +505,31 @@ static void glnvg__blendFuncSeparate(GLNVGcontext* gl, const GLNVGblend* blend)
 
 		gl->blendFunc = *blend;
 		glBlendFuncSeparate(blend->srcRGB, blend->dstRGB, blend->srcAlpha,blend->dstAlpha);
+		gl->stateChanges++;
 	}
 #else
 	glBlendFuncSeparate(blend->srcRGB, blend->dstRGB, blend->srcAlpha,blend->dstAlpha);
+	gl->stateChanges++;
 #endif
 }
 
+static void glnvg__drawArrays(GLNVGcontext* gl, GLenum mode, GLint first, GLsizei count)
+{
+	glDrawArrays(mode, first, count);
+	gl->drawCount++;
+}
+
 static GLNVGtexture* glnvg__allocTexture(GLNVGcontext* gl)
 {
 	GLNVGtexture* tex = NULL;
-	int i;
+	int generation = 0;
 
-	for (i = 0; i < gl->ntextures; i++) {
-		if (gl->textures[i].id == 0) {
-			tex = &gl->textures[i];
-			break;
-		}
-	}
-	if (tex == NULL) {
+	if (gl->freeTexture != 0) {
+		tex = &gl->textures[gl->freeTexture-1];
+		gl->freeTexture = tex->nextFree;
+		generation = tex->generation;
+	} else {
+		if (gl->ntextures >= GLNVG_TEXTURE_INDEX_MASK) return NULL; // slot + 1 must fit the index bits
 		if (gl->ntextures+1 > gl->ctextures) {
 			GLNVGtexture* textures;
 			int ctextures = glnvg__maxi(gl->ntextures+1, 4) +  gl->ctextures/2; // 1.5x Overallocate
@@ -369,32 +542,36 @@ static GLNVGtexture* glnvg__allocTexture(GLNVGcontext* gl)
 	}
 
 	memset(tex, 0, sizeof(*tex));
-	tex->id = ++gl->textureId;
+	tex->generation = generation;
+	tex->id = (generation << GLNVG_TEXTURE_INDEX_BITS) | (int)(tex - gl->textures + 1);
 
 	return tex;
 }
 
 static GLNVGtexture* glnvg__findTexture(GLNVGcontext* gl, int id)
 {
-	int i;
-	for (i = 0; i < gl->ntextures; i++)
-		if (gl->textures[i].id == id)
-			return &gl->textures[i];
-	return NULL;
+	int i = (id & GLNVG_TEXTURE_INDEX_MASK) - 1;
+	if (id <= 0 || i < 0 || i >= gl->ntextures || gl->textures[i].id != id)
+		return NULL;
+	return &gl->textures[i];
 }
 
 static int glnvg__deleteTexture(GLNVGcontext* gl, int id)
 {
-	int i;
-	for (i = 0; i < gl->ntextures; i++) {
-		if (gl->textures[i].id == id) {
-			if (gl->textures[i].tex != 0 && (gl->textures[i].flags & NVG_IMAGE_NODELETE) == 0)
-				glDeleteTextures(1, &gl->textures[i].tex);
-			memset(&gl->textures[i], 0, sizeof(gl->textures[i]));
-			return 1;
-		}
-	}
-	return 0;
+	GLNVGtexture* tex = glnvg__findTexture(gl, id);
+	int generation;
+
+	if (tex == NULL) return 0;
+	if (tex->tex != 0 && (tex->flags & NVG_IMAGE_NODELETE) == 0)
+		glDeleteTextures(1, &tex->tex);
+
+	// The next texture in the slot gets a new id, stale ones stop matching.
+	generation = (tex->generation + 1) & GLNVG_TEXTURE_GENERATION_MASK;
+	memset(tex, 0, sizeof(*tex));
+	tex->generation = generation;
+	tex->nextFree = gl->freeTexture;
+	gl->freeTexture = (int)(tex - gl->textures + 1);
+	return 1;
 }
 
 static void glnvg__dumpShaderError(GLuint shader, const char* name, const char* type)
@@ -465,6 +642,7 @@ static int glnvg__createShader(GLNVGshader* shader, const char* name, const char
 
 	glBindAttribLocation(prog, 0, "vertex");
 	glBindAttribLocation(prog, 1, "tcoord");
+	glBindAttribLocation(prog, 2, "tint");
 
 	glLinkProgram(prog);
 	glGetProgramiv(prog, GL_LINK_STATUS, &status);
@@ -504,6 +682,217 @@ static void glnvg__getUniforms(GLNVGshader* shader)
 
 static int glnvg__renderCreateTexture(void* uptr, int type, int w, int h, int imageFlags, const unsigned char* data);
 
+#if defined NANOVG_GL3
+static int glnvg__hasExtension(const char* name)
+{
+	GLint i, count = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+	for (i = 0; i < count; i++) {
+		const char* ext = (const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+		if (ext != NULL && strcmp(ext, name) == 0)
+			return 1;
+	}
+	return 0;
+}
+
+static int glnvg__ringInit(GLNVGcontext* gl, GLNVGring* ring, GLenum target, int segmentSize)
+{
+	GLsizeiptr size = (GLsizeiptr)segmentSize * GLNVG_RING_SEGMENTS;
+
+	memset(ring, 0, sizeof(*ring));
+	ring->target = target;
+	ring->segmentSize = segmentSize;
+	ring->segment = -1;
+
+	glGenBuffers(1, &ring->buf);
+	glBindBuffer(target, ring->buf);
+#if NANOVG_GL_USE_BUFFER_STORAGE && defined GL_MAP_PERSISTENT_BIT
+	if (gl->bufferStorage) {
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage(target, size, NULL, flags);
+		ring->map = (unsigned char*)glMapBufferRange(target, 0, size, flags);
+		ring->persistent = ring->map != NULL;
+		if (!ring->persistent) {
+			// storage is immutable, start over with a mutable buffer
+			glBindBuffer(target, 0);
+			glDeleteBuffers(1, &ring->buf);
+			glGenBuffers(1, &ring->buf);
+			glBindBuffer(target, ring->buf);
+		}
+	}
+#else
+	NVG_NOTUSED(gl);
+#endif
+	if (!ring->persistent)
+		glBufferData(target, size, NULL, GL_STREAM_DRAW);
+	glBindBuffer(target, 0);
+
+	return ring->buf != 0;
+}
+
+static void glnvg__ringDelete(GLNVGring* ring)
+{
+	int i;
+	for (i = 0; i < GLNVG_RING_SEGMENTS; i++) {
+		if (ring->fences[i] != NULL)
+			glDeleteSync(ring->fences[i]);
+	}
+	if (ring->buf != 0) {
+		if (ring->persistent || ring->ptr != NULL) {
+			glBindBuffer(ring->target, ring->buf);
+			glUnmapBuffer(ring->target);
+			glBindBuffer(ring->target, 0);
+		}
+		glDeleteBuffers(1, &ring->buf);
+	}
+	memset(ring, 0, sizeof(*ring));
+	ring->segment = -1;
+}
+
+// Waits until the GPU is done with the next segment and maps it for writing.
+static unsigned char* glnvg__ringBegin(GLNVGring* ring)
+{
+	int segment = ring->next;
+	GLsync fence = ring->fences[segment];
+
+	if (fence != NULL) {
+		GLenum status;
+		do {
+			status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+		} while (status == GL_TIMEOUT_EXPIRED);
+		glDeleteSync(fence);
+		ring->fences[segment] = NULL;
+	}
+
+	ring->segment = segment;
+	if (ring->persistent) {
+		ring->ptr = ring->map + segment * ring->segmentSize;
+	} else {
+		// the fence already guarantees the GPU is done, so skip the driver's own sync
+		glBindBuffer(ring->target, ring->buf);
+		ring->ptr = (unsigned char*)glMapBufferRange(ring->target, segment * ring->segmentSize, ring->segmentSize,
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		glBindBuffer(ring->target, 0);
+	}
+	return ring->ptr;
+}
+
+// Makes the segment's writes visible to draws. Leaves the buffer bound.
+static void glnvg__ringUnmap(GLNVGring* ring)
+{
+	glBindBuffer(ring->target, ring->buf);
+	if (!ring->persistent && ring->ptr != NULL)
+		glUnmapBuffer(ring->target);
+}
+
+// Fences the segment after the draws reading it.
+static void glnvg__ringEnd(GLNVGring* ring)
+{
+	ring->fences[ring->segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	ring->next = (ring->segment + 1) % GLNVG_RING_SEGMENTS;
+	ring->segment = -1;
+	ring->ptr = NULL;
+}
+
+// Goes back to glBufferData uploads. Mapped memory is write-only, so calls whose data is still in
+// a ring are dropped.
+static void glnvg__streamStop(GLNVGcontext* gl)
+{
+	int dropped = 0;
+
+	if (glnvg__vertsInRing(gl)) {
+		gl->verts = NULL;
+		gl->cverts = 0;
+		dropped = 1;
+	}
+	if (glnvg__uniformsInRing(gl)) {
+		gl->uniforms = NULL;
+		gl->cuniforms = 0;
+		dropped = 1;
+	}
+	if (dropped) {
+		gl->nverts = 0;
+		gl->npaths = 0;
+		gl->ncalls = 0;
+		gl->nuniforms = 0;
+	}
+
+	glnvg__ringDelete(&gl->vertRing);
+	glnvg__ringDelete(&gl->fragRing);
+	glGenBuffers(1, &gl->vertBuf);
+	glGenBuffers(1, &gl->fragBuf);
+	gl->vertBase = 0;
+	gl->fragBase = 0;
+	gl->streaming = 0;
+}
+
+// Points verts and uniforms at the next ring segments, at the start of a frame.
+static void glnvg__streamBegin(GLNVGcontext* gl)
+{
+	if (!gl->streaming || gl->vertRing.segment >= 0)
+		return; // not streaming, or still on the segment of a frame that was never flushed
+
+	if (glnvg__ringBegin(&gl->vertRing) == NULL || glnvg__ringBegin(&gl->fragRing) == NULL) {
+		glnvg__streamStop(gl);
+		return;
+	}
+
+	// anything allocated between frames is empty and on the heap
+	glnvg__free(gl, gl->verts);
+	glnvg__free(gl, gl->uniforms);
+
+	gl->verts = (NVGvertex*)gl->vertRing.ptr;
+	gl->cverts = gl->vertRing.segmentSize / (int)sizeof(NVGvertex);
+	gl->uniforms = gl->fragRing.ptr;
+	gl->cuniforms = gl->fragRing.segmentSize / gl->fragSize;
+}
+
+// Replaces a ring the frame outgrew with one of the given segment size and moves the frame's
+// data from the heap into it. The heap copy is kept if that fails.
+static unsigned char* glnvg__ringGrow(GLNVGcontext* gl, GLNVGring* ring, void* data, int used, int segmentSize)
+{
+	GLenum target = ring->target;
+
+	glnvg__ringDelete(ring);
+	if (!glnvg__ringInit(gl, ring, target, segmentSize) || glnvg__ringBegin(ring) == NULL)
+		return NULL;
+	memcpy(ring->ptr, data, used);
+	glnvg__free(gl, data);
+	return ring->ptr;
+}
+
+// Readies the frame's segments for drawing. Returns 0 if streaming had to stop.
+static int glnvg__streamFlush(GLNVGcontext* gl)
+{
+	unsigned char* ptr;
+
+	if ((unsigned char*)gl->verts != gl->vertRing.ptr) {
+		ptr = glnvg__ringGrow(gl, &gl->vertRing, gl->verts, gl->nverts * (int)sizeof(NVGvertex), gl->cverts * (int)sizeof(NVGvertex));
+		if (ptr == NULL) {
+			glnvg__streamStop(gl);
+			return 0;
+		}
+		gl->verts = (NVGvertex*)ptr;
+	}
+	if (gl->uniforms != gl->fragRing.ptr) {
+		ptr = glnvg__ringGrow(gl, &gl->fragRing, gl->uniforms, gl->nuniforms * gl->fragSize, gl->cuniforms * gl->fragSize);
+		if (ptr == NULL) {
+			glnvg__streamStop(gl);
+			return 0;
+		}
+		gl->uniforms = ptr;
+	}
+
+	glnvg__ringUnmap(&gl->fragRing);
+	glnvg__ringUnmap(&gl->vertRing);
+	gl->vertBuf = gl->vertRing.buf;
+	gl->fragBuf = gl->fragRing.buf;
+	gl->vertBase = gl->vertRing.segment * gl->vertRing.segmentSize;
+	gl->fragBase = gl->fragRing.segment * gl->fragRing.segmentSize;
+	return 1;
+}
+#endif
+
 static int glnvg__renderCreate(void* uptr)
 {
 	GLNVGcontext* gl = (GLNVGcontext*)uptr;
@@ -537,17 +926,22 @@ static int glnvg__renderCreate(void* uptr)
 		"	uniform vec2 viewSize;\n"
 		"	in vec2 vertex;\n"
 		"	in vec2 tcoord;\n"
+		"	in vec4 tint;\n"
 		"	out vec2 ftcoord;\n"
 		"	out vec2 fpos;\n"
+		"	flat out vec4 ftint;\n"
 		"#else\n"
 		"	uniform vec2 viewSize;\n"
 		"	attribute vec2 vertex;\n"
 		"	attribute vec2 tcoord;\n"
+		"	attribute vec4 tint;\n"
 		"	varying vec2 ftcoord;\n"
 		"	varying vec2 fpos;\n"
+		"	varying vec4 ftint;\n"
 		"#endif\n"
 		"void main(void) {\n"
 		"	ftcoord = tcoord;\n"
+		"	ftint = tint;\n"
 		"	fpos = vertex;\n"
 		"	gl_Position = vec4(2.0*vertex.x/viewSize.x - 1.0, 1.0 - 2.0*vertex.y/viewSize.y, 0, 1);\n"
 		"}\n";
@@ -583,12 +977,14 @@ static int glnvg__renderCreate(void* uptr)
 		"	uniform sampler2D tex;\n"
 		"	in vec2 ftcoord;\n"
 		"	in vec2 fpos;\n"
+		"	flat in vec4 ftint;\n"
 		"	out vec4 outColor;\n"
 		"#else\n" // !NANOVG_GL3
 		"	uniform vec4 frag[UNIFORMARRAY_SIZE];\n"
 		"	uniform sampler2D tex;\n"
 		"	varying vec2 ftcoord;\n"
 		"	varying vec2 fpos;\n"
+		"	varying vec4 ftint;\n"
 		"#endif\n"
 		"#ifndef USE_UNIFORMBUFFER\n"
 		"	#define scissorMat mat3(frag[0].xyz, frag[1].xyz, frag[2].xyz)\n"
@@ -667,9 +1063,13 @@ static int glnvg__renderCreate(void* uptr)
 		"#endif\n"
 		"		if (texType == 1) color = vec4(color.xyz*color.w,color.w);"
 		"		if (texType == 2) color = vec4(color.x);"
+		"		// Distance field glyph, the outline at 0.5 smoothed over feather\n"
+		"		if (texType == 3) color = vec4(clamp((color.x - 0.5) / feather + 0.5, 0.0, 1.0));\n"
 		"		color *= scissor;\n"
 		"		result = color * innerCol;\n"
 		"	}\n"
+		"	// colour of merged calls, white otherwise\n"
+		"	result *= ftint;\n"
 		"#ifdef NANOVG_GL3\n"
 		"	outColor = result;\n"
 		"#else\n"
@@ -695,6 +1095,11 @@ static int glnvg__renderCreate(void* uptr)
 	glGenVertexArrays(1, &gl->vertArr);
 #endif
 	glGenBuffers(1, &gl->vertBuf);
+#if NANOVG_GL_MERGE_CALLS
+	glGenBuffers(1, &gl->colorBuf);
+	glGenBuffers(1, &gl->indexBuf);
+#endif
+	gl->mergeCall = -1;
 
 #if NANOVG_GL_USE_UNIFORMBUFFER
 	// Create UBOs
@@ -704,6 +1109,23 @@ static int glnvg__renderCreate(void* uptr)
 #endif
 	gl->fragSize = sizeof(GLNVGfragUniforms) + align - sizeof(GLNVGfragUniforms) % align;
 
+#if defined NANOVG_GL3
+	if (gl->flags & NVG_STREAM_BUFFERS) {
+		gl->bufferStorage = glnvg__hasExtension("GL_ARB_buffer_storage");
+		glDeleteBuffers(1, &gl->vertBuf);
+		glDeleteBuffers(1, &gl->fragBuf);
+		gl->vertBuf = gl->fragBuf = 0;
+		gl->streaming = glnvg__ringInit(gl, &gl->vertRing, GL_ARRAY_BUFFER, 16384 * (int)sizeof(NVGvertex)) &&
+						glnvg__ringInit(gl, &gl->fragRing, GL_UNIFORM_BUFFER, 256 * gl->fragSize);
+		if (gl->streaming) {
+			gl->vertBuf = gl->vertRing.buf;
+			gl->fragBuf = gl->fragRing.buf;
+		} else {
+			glnvg__streamStop(gl);
+		}
+	}
+#endif
+
 	// Some platforms does not allow to have samples to unset textures.
 	// Create empty one which is bound when there's no texture specified.
 	gl->dummyTex = glnvg__renderCreateTexture(gl, NVG_TEXTURE_ALPHA, 1, 1, 0, NULL);
@@ -821,6 +1243,82 @@ static int glnvg__renderCreateTexture(void* uptr, int type, int w, int h, int im
 }
 
 
+static int glnvg__renderCreateTextureLevels(void* uptr, int w, int h, int nlevels, int imageFlags)
+{
+#if defined(NANOVG_GLES2)
+	// No GL_TEXTURE_BASE_LEVEL to hide the levels still missing.
+	NVG_NOTUSED(uptr); NVG_NOTUSED(w); NVG_NOTUSED(h); NVG_NOTUSED(nlevels); NVG_NOTUSED(imageFlags);
+	return 0;
+#else
+	GLNVGcontext* gl = (GLNVGcontext*)uptr;
+	GLNVGtexture* tex;
+	int i;
+
+	if (nlevels < 1 || w < 1 || h < 1) return 0;
+	tex = glnvg__allocTexture(gl);
+	if (tex == NULL) return 0;
+
+	glGenTextures(1, &tex->tex);
+	tex->width = w;
+	tex->height = h;
+	tex->type = NVG_TEXTURE_RGBA;
+	tex->flags = imageFlags & ~NVG_IMAGE_GENERATE_MIPMAPS;
+	tex->levels = nlevels;
+	tex->baseLevel = nlevels;
+	glnvg__bindTexture(gl, tex->tex);
+
+	// Storage for every level up front, so the texture is complete as levels arrive.
+	for (i = 0; i < nlevels; i++) {
+		int lw = glnvg__maxi(1, w >> i), lh = glnvg__maxi(1, h >> i);
+		glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA, lw, lh, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	}
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, nlevels-1);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, nlevels-1);
+	if (imageFlags & NVG_IMAGE_NEAREST) {
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	} else {
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	}
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, (imageFlags & NVG_IMAGE_REPEATX) ? GL_REPEAT : GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, (imageFlags & NVG_IMAGE_REPEATY) ? GL_REPEAT : GL_CLAMP_TO_EDGE);
+
+	glnvg__checkError(gl, "create tex levels");
+	glnvg__bindTexture(gl, 0);
+
+	return tex->id;
+#endif
+}
+
+static int glnvg__renderUpdateTextureLevel(void* uptr, int image, int level, const unsigned char* data)
+{
+#if defined(NANOVG_GLES2)
+	NVG_NOTUSED(uptr); NVG_NOTUSED(image); NVG_NOTUSED(level); NVG_NOTUSED(data);
+	return 0;
+#else
+	GLNVGcontext* gl = (GLNVGcontext*)uptr;
+	GLNVGtexture* tex = glnvg__findTexture(gl, image);
+
+	if (tex == NULL || level < 0 || level >= tex->levels) return 0;
+	glnvg__bindTexture(gl, tex->tex);
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT,1);
+	glTexSubImage2D(GL_TEXTURE_2D, level, 0,0, glnvg__maxi(1, tex->width >> level), glnvg__maxi(1, tex->height >> level), GL_RGBA, GL_UNSIGNED_BYTE, data);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	// Sample down from the finest level in so far.
+	if (level < tex->baseLevel) {
+		tex->baseLevel = level;
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+	}
+
+	glnvg__bindTexture(gl, 0);
+	return 1;
+#endif
+}
+
 static int glnvg__renderDeleteTexture(void* uptr, int image)
 {
 	GLNVGcontext* gl = (GLNVGcontext*)uptr;
@@ -983,11 +1481,13 @@ static void glnvg__setUniforms(GLNVGcontext* gl, int uniformOffset, int image)
 {
 	GLNVGtexture* tex = NULL;
 #if NANOVG_GL_USE_UNIFORMBUFFER
-	glBindBufferRange(GL_UNIFORM_BUFFER, GLNVG_FRAG_BINDING, gl->fragBuf, uniformOffset, sizeof(GLNVGfragUniforms));
+	glBindBufferRange(GL_UNIFORM_BUFFER, GLNVG_FRAG_BINDING, gl->fragBuf, gl->fragBase + uniformOffset, sizeof(GLNVGfragUniforms));
 #else
 	GLNVGfragUniforms* frag = nvg__fragUniformPtr(gl, uniformOffset);
 	glUniform4fv(gl->shader.loc[GLNVG_LOC_FRAG], NANOVG_GL_UNIFORMARRAY_SIZE, &(frag->uniformArray[0][0]));
+	gl->uploadBytes += (int)sizeof(GLNVGfragUniforms);
 #endif
+	gl->stateChanges++;
 
 	if (image != 0) {
 		tex = glnvg__findTexture(gl, image);
@@ -1006,6 +1506,12 @@ static void glnvg__renderViewport(void* uptr, float width, float height, float d
 	GLNVGcontext* gl = (GLNVGcontext*)uptr;
 	gl->view[0] = width;
 	gl->view[1] = height;
+	// the allocator was reset, last frame's buffers are gone
+	if (gl->allocator.alloc != NULL)
+		glnvg__reacquireFrameBuffers(gl);
+#if defined NANOVG_GL3
+	glnvg__streamBegin(gl);
+#endif
 }
 
 static void glnvg__fill(GLNVGcontext* gl, GLNVGcall* call)
@@ -1027,7 +1533,7 @@ static void glnvg__fill(GLNVGcontext* gl, GLNVGcall* call)
 	glStencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_DECR_WRAP);
 	glDisable(GL_CULL_FACE);
 	for (i = 0; i < npaths; i++)
-		glDrawArrays(GL_TRIANGLE_FAN, paths[i].fillOffset, paths[i].fillCount);
+		glnvg__drawArrays(gl, GL_TRIANGLE_FAN, paths[i].fillOffset, paths[i].fillCount);
 	glEnable(GL_CULL_FACE);
 
 	// Draw anti-aliased pixels
@@ -1041,13 +1547,13 @@ static void glnvg__fill(GLNVGcontext* gl, GLNVGcall* call)
 		glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
 		// Draw fringes
 		for (i = 0; i < npaths; i++)
-			glDrawArrays(GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+			glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
 	}
 
 	// Draw fill
 	glnvg__stencilFunc(gl, GL_NOTEQUAL, 0x0, 0xff);
 	glStencilOp(GL_ZERO, GL_ZERO, GL_ZERO);
-	glDrawArrays(GL_TRIANGLE_STRIP, call->triangleOffset, call->triangleCount);
+	glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, call->triangleOffset, call->triangleCount);
 
 	glDisable(GL_STENCIL_TEST);
 }
@@ -1061,10 +1567,10 @@ static void glnvg__convexFill(GLNVGcontext* gl, GLNVGcall* call)
 	glnvg__checkError(gl, "convex fill");
 
 	for (i = 0; i < npaths; i++) {
-		glDrawArrays(GL_TRIANGLE_FAN, paths[i].fillOffset, paths[i].fillCount);
+		glnvg__drawArrays(gl, paths[i].fillMode, paths[i].fillOffset, paths[i].fillCount);
 		// Draw fringes
 		if (paths[i].strokeCount > 0) {
-			glDrawArrays(GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+			glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
 		}
 	}
 }
@@ -1085,14 +1591,14 @@ static void glnvg__stroke(GLNVGcontext* gl, GLNVGcall* call)
 		glnvg__setUniforms(gl, call->uniformOffset + gl->fragSize, call->image);
 		glnvg__checkError(gl, "stroke fill 0");
 		for (i = 0; i < npaths; i++)
-			glDrawArrays(GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+			glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
 
 		// Draw anti-aliased pixels.
 		glnvg__setUniforms(gl, call->uniformOffset, call->image);
 		glnvg__stencilFunc(gl, GL_EQUAL, 0x00, 0xff);
 		glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
 		for (i = 0; i < npaths; i++)
-			glDrawArrays(GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+			glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
 
 		// Clear stencil buffer.
 		glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
@@ -1100,7 +1606,7 @@ static void glnvg__stroke(GLNVGcontext* gl, GLNVGcall* call)
 		glStencilOp(GL_ZERO, GL_ZERO, GL_ZERO);
 		glnvg__checkError(gl, "stroke fill 1");
 		for (i = 0; i < npaths; i++)
-			glDrawArrays(GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+			glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
 		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 
 		glDisable(GL_STENCIL_TEST);
@@ -1112,7 +1618,7 @@ static void glnvg__stroke(GLNVGcontext* gl, GLNVGcall* call)
 		glnvg__checkError(gl, "stroke fill");
 		// Draw Strokes
 		for (i = 0; i < npaths; i++)
-			glDrawArrays(GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+			glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
 	}
 }
 
@@ -1121,8 +1627,181 @@ static void glnvg__triangles(GLNVGcontext* gl, GLNVGcall* call)
 	glnvg__setUniforms(gl, call->uniformOffset, call->image);
 	glnvg__checkError(gl, "triangles fill");
 
-	glDrawArrays(GL_TRIANGLES, call->triangleOffset, call->triangleCount);
+	glnvg__drawArrays(gl, GL_TRIANGLES, call->triangleOffset, call->triangleCount);
+}
+
+#if NANOVG_GL_MERGE_CALLS
+static void glnvg__merged(GLNVGcontext* gl, GLNVGcall* call)
+{
+	size_t vertOffset = gl->vertBase + call->vertOffset * sizeof(NVGvertex);
+
+	glnvg__setUniforms(gl, call->uniformOffset, call->image);
+	glnvg__checkError(gl, "merged fill");
+
+	// indices are relative to the first vertex of the run so they fit in 16 bits
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(NVGvertex), (const GLvoid*)vertOffset);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(NVGvertex), (const GLvoid*)(vertOffset + 2*sizeof(float)));
+	glBindBuffer(GL_ARRAY_BUFFER, gl->colorBuf);
+	glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(NVGcolor), (const GLvoid*)(call->colorOffset * sizeof(NVGcolor)));
+	glEnableVertexAttribArray(2);
+	glBindBuffer(GL_ARRAY_BUFFER, gl->vertBuf);
+
+	glDrawElements(GL_TRIANGLES, call->triangleCount, GL_UNSIGNED_SHORT, (const GLvoid*)(call->indexOffset * sizeof(GLushort)));
+	gl->drawCount++;
+
+	glDisableVertexAttribArray(2);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(NVGvertex), (const GLvoid*)(size_t)gl->vertBase);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(NVGvertex), (const GLvoid*)(gl->vertBase + 2*sizeof(float)));
+}
+
+static int glnvg__mergeVertCount(GLNVGcontext* gl, GLNVGcall* call)
+{
+	int i, count = 0;
+	if (call->type == GLNVG_TRIANGLES)
+		return call->triangleCount;
+	for (i = 0; i < call->pathCount; i++) {
+		GLNVGpath* path = &gl->paths[call->pathOffset + i];
+		if (path->fillMode == GL_TRIANGLES)
+			count += path->fillCount;
+		else
+			count += glnvg__maxi(path->fillCount - 2, 0) * 3;
+		count += glnvg__maxi(path->strokeCount - 2, 0) * 3;
+	}
+	return count;
+}
+
+static GLushort* glnvg__mergeList(GLushort* dst, int offset, int count)
+{
+	int i;
+	for (i = 0; i < count; i++)
+		*dst++ = (GLushort)(offset + i);
+	return dst;
+}
+
+static GLushort* glnvg__mergeFan(GLushort* dst, int offset, int count)
+{
+	int i;
+	for (i = 1; i+1 < count; i++) {
+		*dst++ = (GLushort)offset;
+		*dst++ = (GLushort)(offset + i);
+		*dst++ = (GLushort)(offset + i + 1);
+	}
+	return dst;
+}
+
+static GLushort* glnvg__mergeStrip(GLushort* dst, int offset, int count)
+{
+	int i;
+	// odd triangles swap their first two vertices to keep the winding of the strip
+	for (i = 0; i+2 < count; i++) {
+		*dst++ = (GLushort)(offset + i + (i & 1));
+		*dst++ = (GLushort)(offset + i + 1 - (i & 1));
+		*dst++ = (GLushort)(offset + i + 2);
+	}
+	return dst;
+}
+
+// Remembers the state of a call recorded with frag, so the next call can merge into it when
+// only the solid colour differs.
+static void glnvg__mergeKey(GLNVGcontext* gl, GLNVGcall* call, const GLNVGfragUniforms* frag, int vertOffset, int vertCount)
+{
+	GLNVGfragUniforms key = *frag;
+	int index = (int)(call - gl->calls);
+
+	if (memcmp(&frag->innerCol, &frag->outerCol, sizeof(NVGcolor)) != 0) {
+		gl->mergeCall = -1;
+		return;
+	}
+	memset(&key.innerCol, 0, sizeof(key.innerCol));
+	memset(&key.outerCol, 0, sizeof(key.outerCol));
+
+	call->merge = gl->mergeCall == index-1 && memcmp(&key, &gl->mergeKey, sizeof(key)) == 0;
+	call->color = frag->innerCol;
+	call->vertOffset = vertOffset;
+	call->vertCount = vertCount;
+	gl->mergeCall = index;
+	gl->mergeKey = key;
+}
+
+static int glnvg__allocMerge(GLNVGcontext* gl, int ncolors, int nindices)
+{
+	if (gl->ncolors+ncolors > gl->ccolors) {
+		NVGcolor* colors;
+		int ccolors = glnvg__maxi(gl->ncolors+ncolors, 4096) + gl->ccolors/2; // 1.5x Overallocate
+		colors = (NVGcolor*)glnvg__realloc(gl, gl->colors, sizeof(NVGcolor) * gl->ncolors, sizeof(NVGcolor) * ccolors);
+		if (colors == NULL) return 0;
+		gl->colors = colors;
+		gl->ccolors = ccolors;
+	}
+	if (gl->nindices+nindices > gl->cindices) {
+		GLushort* indices;
+		int cindices = glnvg__maxi(gl->nindices+nindices, 4096) + gl->cindices/2; // 1.5x Overallocate
+		indices = (GLushort*)glnvg__realloc(gl, gl->indices, sizeof(GLushort) * gl->nindices, sizeof(GLushort) * cindices);
+		if (indices == NULL) return 0;
+		gl->indices = indices;
+		gl->cindices = cindices;
+	}
+	return 1;
+}
+
+// Joins runs of calls marked by glnvg__mergeKey into one indexed draw of the first call's
+// uniforms, with white in place of its colour and each call's colour per vertex. Only call
+// metadata is read, the vertices stay where they were written.
+static void glnvg__mergeCalls(GLNVGcontext* gl)
+{
+	int i, j, k, p;
+	for (i = 0; i < gl->ncalls; i = j) {
+		GLNVGcall* first = &gl->calls[i];
+		GLNVGfragUniforms* frag;
+		GLushort* dst;
+		int nverts = first->vertCount, nindices = glnvg__mergeVertCount(gl, first);
+
+		for (j = i+1; j < gl->ncalls; j++) {
+			GLNVGcall* call = &gl->calls[j];
+			if (!call->merge || call->image != first->image ||
+				memcmp(&call->blendFunc, &first->blendFunc, sizeof(GLNVGblend)) != 0 ||
+				call->vertOffset != first->vertOffset + nverts || nverts + call->vertCount > 65536)
+				break;
+			nverts += call->vertCount;
+			nindices += glnvg__mergeVertCount(gl, call);
+		}
+		if (j - i < 2 || glnvg__allocMerge(gl, nverts, nindices) == 0)
+			continue;
+
+		dst = &gl->indices[gl->nindices];
+		for (k = i; k < j; k++) {
+			GLNVGcall* call = &gl->calls[k];
+			int base = first->vertOffset;
+			if (call->type == GLNVG_TRIANGLES) {
+				dst = glnvg__mergeList(dst, call->triangleOffset - base, call->triangleCount);
+			} else {
+				for (p = 0; p < call->pathCount; p++) {
+					GLNVGpath* path = &gl->paths[call->pathOffset + p];
+					if (path->fillMode == GL_TRIANGLES)
+						dst = glnvg__mergeList(dst, path->fillOffset - base, path->fillCount);
+					else
+						dst = glnvg__mergeFan(dst, path->fillOffset - base, path->fillCount);
+					dst = glnvg__mergeStrip(dst, path->strokeOffset - base, path->strokeCount);
+				}
+			}
+			for (p = 0; p < call->vertCount; p++)
+				gl->colors[gl->ncolors + call->vertOffset - base + p] = call->color;
+			if (k > i)
+				call->type = GLNVG_NONE;
+		}
+
+		frag = nvg__fragUniformPtr(gl, first->uniformOffset);
+		frag->innerCol = frag->outerCol = nvgRGBAf(1.0f, 1.0f, 1.0f, 1.0f);
+		first->type = GLNVG_MERGED;
+		first->vertCount = nverts;
+		first->indexOffset = gl->nindices;
+		first->triangleCount = nindices;
+		first->colorOffset = gl->ncolors;
+		gl->nindices += nindices;
+		gl->ncolors += nverts;
+	}
 }
+#endif
 
 static void glnvg__renderCancel(void* uptr) {
 	GLNVGcontext* gl = (GLNVGcontext*)uptr;
@@ -1130,6 +1809,7 @@ static void glnvg__renderCancel(void* uptr) {
 	gl->npaths = 0;
 	gl->ncalls = 0;
 	gl->nuniforms = 0;
+	gl->mergeCall = -1;
 }
 
 static GLenum glnvg_convertBlendFuncFactor(int factor)
@@ -1181,6 +1861,22 @@ static void glnvg__renderFlush(void* uptr)
 	GLNVGcontext* gl = (GLNVGcontext*)uptr;
 	int i;
 
+	gl->drawCount = 0;
+	gl->stateChanges = 0;
+	gl->uploadBytes = 0;
+
+#if NANOVG_GL_MERGE_CALLS
+	// before the ring is unmapped, the first call of each run gets new uniforms
+	gl->ncolors = 0;
+	gl->nindices = 0;
+	glnvg__mergeCalls(gl);
+#endif
+
+#if defined NANOVG_GL3
+	if (gl->ncalls > 0 && gl->streaming)
+		glnvg__streamFlush(gl);
+#endif
+
 	if (gl->ncalls > 0) {
 
 		// Setup require GL state.
@@ -1213,7 +1909,9 @@ static void glnvg__renderFlush(void* uptr)
 #if NANOVG_GL_USE_UNIFORMBUFFER
 		// Upload ubo for frag shaders
 		glBindBuffer(GL_UNIFORM_BUFFER, gl->fragBuf);
-		glBufferData(GL_UNIFORM_BUFFER, gl->nuniforms * gl->fragSize, gl->uniforms, GL_STREAM_DRAW);
+		if (!glnvg__isStreaming(gl))
+			glBufferData(GL_UNIFORM_BUFFER, gl->nuniforms * gl->fragSize, gl->uniforms, GL_STREAM_DRAW);
+		gl->uploadBytes += gl->nuniforms * gl->fragSize;
 #endif
 
 		// Upload vertex data
@@ -1221,11 +1919,25 @@ static void glnvg__renderFlush(void* uptr)
 		glBindVertexArray(gl->vertArr);
 #endif
 		glBindBuffer(GL_ARRAY_BUFFER, gl->vertBuf);
-		glBufferData(GL_ARRAY_BUFFER, gl->nverts * sizeof(NVGvertex), gl->verts, GL_STREAM_DRAW);
+		if (!glnvg__isStreaming(gl))
+			glBufferData(GL_ARRAY_BUFFER, gl->nverts * sizeof(NVGvertex), gl->verts, GL_STREAM_DRAW);
+		gl->uploadBytes += gl->nverts * (int)sizeof(NVGvertex);
 		glEnableVertexAttribArray(0);
 		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(NVGvertex), (const GLvoid*)(size_t)0);
-		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(NVGvertex), (const GLvoid*)(0 + 2*sizeof(float)));
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(NVGvertex), (const GLvoid*)(size_t)gl->vertBase);
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(NVGvertex), (const GLvoid*)(gl->vertBase + 2*sizeof(float)));
+		glVertexAttrib4f(2, 1.0f, 1.0f, 1.0f, 1.0f);
+
+#if NANOVG_GL_MERGE_CALLS
+		if (gl->nindices > 0) {
+			glBindBuffer(GL_ARRAY_BUFFER, gl->colorBuf);
+			glBufferData(GL_ARRAY_BUFFER, gl->ncolors * sizeof(NVGcolor), gl->colors, GL_STREAM_DRAW);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gl->indexBuf);
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, gl->nindices * sizeof(GLushort), gl->indices, GL_STREAM_DRAW);
+			glBindBuffer(GL_ARRAY_BUFFER, gl->vertBuf);
+			gl->uploadBytes += gl->ncolors * (int)sizeof(NVGcolor) + gl->nindices * (int)sizeof(GLushort);
+		}
+#endif
 
 		// Set view and texture just once per frame.
 		glUniform1i(gl->shader.loc[GLNVG_LOC_TEX], 0);
@@ -1246,6 +1958,10 @@ static void glnvg__renderFlush(void* uptr)
 				glnvg__stroke(gl, call);
 			else if (call->type == GLNVG_TRIANGLES)
 				glnvg__triangles(gl, call);
+#if NANOVG_GL_MERGE_CALLS
+			else if (call->type == GLNVG_MERGED)
+				glnvg__merged(gl, call);
+#endif
 		}
 
 		glDisableVertexAttribArray(0);
@@ -1255,8 +1971,23 @@ static void glnvg__renderFlush(void* uptr)
 #endif
 		glDisable(GL_CULL_FACE);
 			glBindBuffer(GL_ARRAY_BUFFER, 0);
+#if NANOVG_GL_MERGE_CALLS && !defined NANOVG_GL3
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+#endif
 		glUseProgram(0);
 		glnvg__bindTexture(gl, 0);
+
+#if defined NANOVG_GL3
+		if (gl->streaming) {
+			// the segments belong to the GPU until their fences pass
+			glnvg__ringEnd(&gl->vertRing);
+			glnvg__ringEnd(&gl->fragRing);
+			gl->verts = NULL;
+			gl->cverts = 0;
+			gl->uniforms = NULL;
+			gl->cuniforms = 0;
+		}
+#endif
 	}
 
 	// Reset calls
@@ -1264,6 +1995,7 @@ static void glnvg__renderFlush(void* uptr)
 	gl->npaths = 0;
 	gl->ncalls = 0;
 	gl->nuniforms = 0;
+	gl->mergeCall = -1;
 }
 
 static int glnvg__maxVertCount(const NVGpath* paths, int npaths)
@@ -1282,7 +2014,7 @@ static GLNVGcall* glnvg__allocCall(GLNVGcontext* gl)
 	if (gl->ncalls+1 > gl->ccalls) {
 		GLNVGcall* calls;
 		int ccalls = glnvg__maxi(gl->ncalls+1, 128) + gl->ccalls/2; // 1.5x Overallocate
-		calls = (GLNVGcall*)realloc(gl->calls, sizeof(GLNVGcall) * ccalls);
+		calls = (GLNVGcall*)glnvg__realloc(gl, gl->calls, sizeof(GLNVGcall) * gl->ncalls, sizeof(GLNVGcall) * ccalls);
 		if (calls == NULL) return NULL;
 		gl->calls = calls;
 		gl->ccalls = ccalls;
@@ -1298,7 +2030,7 @@ static int glnvg__allocPaths(GLNVGcontext* gl, int n)
 	if (gl->npaths+n > gl->cpaths) {
 		GLNVGpath* paths;
 		int cpaths = glnvg__maxi(gl->npaths + n, 128) + gl->cpaths/2; // 1.5x Overallocate
-		paths = (GLNVGpath*)realloc(gl->paths, sizeof(GLNVGpath) * cpaths);
+		paths = (GLNVGpath*)glnvg__realloc(gl, gl->paths, sizeof(GLNVGpath) * gl->npaths, sizeof(GLNVGpath) * cpaths);
 		if (paths == NULL) return -1;
 		gl->paths = paths;
 		gl->cpaths = cpaths;
@@ -1314,7 +2046,13 @@ static int glnvg__allocVerts(GLNVGcontext* gl, int n)
 	if (gl->nverts+n > gl->cverts) {
 		NVGvertex* verts;
 		int cverts = glnvg__maxi(gl->nverts + n, 4096) + gl->cverts/2; // 1.5x Overallocate
-		verts = (NVGvertex*)realloc(gl->verts, sizeof(NVGvertex) * cverts);
+		if (glnvg__vertsInRing(gl)) {
+			// outgrew the ring segment, continue on the heap until the flush grows the ring
+			verts = (NVGvertex*)glnvg__realloc(gl, NULL, 0, sizeof(NVGvertex) * cverts);
+			if (verts == NULL) return -1;
+			memcpy(verts, gl->verts, sizeof(NVGvertex) * gl->nverts);
+		} else
+		verts = (NVGvertex*)glnvg__realloc(gl, gl->verts, sizeof(NVGvertex) * gl->nverts, sizeof(NVGvertex) * cverts);
 		if (verts == NULL) return -1;
 		gl->verts = verts;
 		gl->cverts = cverts;
@@ -1330,7 +2068,12 @@ static int glnvg__allocFragUniforms(GLNVGcontext* gl, int n)
 	if (gl->nuniforms+n > gl->cuniforms) {
 		unsigned char* uniforms;
 		int cuniforms = glnvg__maxi(gl->nuniforms+n, 128) + gl->cuniforms/2; // 1.5x Overallocate
-		uniforms = (unsigned char*)realloc(gl->uniforms, structSize * cuniforms);
+		if (glnvg__uniformsInRing(gl)) {
+			uniforms = (unsigned char*)glnvg__realloc(gl, NULL, 0, structSize * cuniforms);
+			if (uniforms == NULL) return -1;
+			memcpy(uniforms, gl->uniforms, structSize * gl->nuniforms);
+		} else
+		uniforms = (unsigned char*)glnvg__realloc(gl, gl->uniforms, structSize * gl->nuniforms, structSize * cuniforms);
 		if (uniforms == NULL) return -1;
 		gl->uniforms = uniforms;
 		gl->cuniforms = cuniforms;
@@ -1360,6 +2103,7 @@ static void glnvg__renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperation
 	GLNVGcall* call = glnvg__allocCall(gl);
 	NVGvertex* quad;
 	GLNVGfragUniforms* frag;
+	GLNVGfragUniforms fill;
 	int i, maxverts, offset;
 
 	if (call == NULL) return;
@@ -1372,7 +2116,7 @@ static void glnvg__renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperation
 	call->image = paint->image;
 	call->blendFunc = glnvg__blendCompositeOperation(compositeOperation);
 
-	if (npaths == 1 && paths[0].convex)
+	if ((npaths == 1 && paths[0].convex) || (npaths > 0 && paths[0].triangles))
 	{
 		call->type = GLNVG_CONVEXFILL;
 		call->triangleCount = 0;	// Bounding box fill quad not needed for convex fill
@@ -1387,6 +2131,7 @@ static void glnvg__renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperation
 		GLNVGpath* copy = &gl->paths[call->pathOffset + i];
 		const NVGpath* path = &paths[i];
 		memset(copy, 0, sizeof(GLNVGpath));
+		copy->fillMode = path->triangles ? GL_TRIANGLES : GL_TRIANGLE_FAN;
 		if (path->nfill > 0) {
 			copy->fillOffset = offset;
 			copy->fillCount = path->nfill;
@@ -1423,8 +2168,12 @@ static void glnvg__renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperation
 	} else {
 		call->uniformOffset = glnvg__allocFragUniforms(gl, 1);
 		if (call->uniformOffset == -1) goto error;
-		// Fill shader
-		glnvg__convertPaint(gl, nvg__fragUniformPtr(gl, call->uniformOffset), paint, scissor, fringe, fringe, -1.0f);
+		// Fill shader, built locally since the destination may be write-only mapped memory
+		glnvg__convertPaint(gl, &fill, paint, scissor, fringe, fringe, -1.0f);
+#if NANOVG_GL_MERGE_CALLS
+		glnvg__mergeKey(gl, call, &fill, offset - maxverts, maxverts);
+#endif
+		memcpy(nvg__fragUniformPtr(gl, call->uniformOffset), &fill, sizeof(fill));
 	}
 
 	return;
@@ -1492,11 +2241,11 @@ error:
 }
 
 static void glnvg__renderTriangles(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor,
-								   const NVGvertex* verts, int nverts, float fringe)
+								   const NVGvertex* verts, int nverts, float fringe, float sdfEdge)
 {
 	GLNVGcontext* gl = (GLNVGcontext*)uptr;
 	GLNVGcall* call = glnvg__allocCall(gl);
-	GLNVGfragUniforms* frag;
+	GLNVGfragUniforms frag;
 
 	if (call == NULL) return;
 
@@ -1514,9 +2263,16 @@ static void glnvg__renderTriangles(void* uptr, NVGpaint* paint, NVGcompositeOper
 	// Fill shader
 	call->uniformOffset = glnvg__allocFragUniforms(gl, 1);
 	if (call->uniformOffset == -1) goto error;
-	frag = nvg__fragUniformPtr(gl, call->uniformOffset);
-	glnvg__convertPaint(gl, frag, paint, scissor, 1.0f, fringe, -1.0f);
-	frag->type = NSVG_SHADER_IMG;
+	glnvg__convertPaint(gl, &frag, paint, scissor, 1.0f, fringe, -1.0f);
+	frag.type = NSVG_SHADER_IMG;
+	if (sdfEdge > 0.0f) {
+		frag.texType = 3;
+		frag.feather = sdfEdge;
+	}
+#if NANOVG_GL_MERGE_CALLS
+	glnvg__mergeKey(gl, call, &frag, call->triangleOffset, nverts);
+#endif
+	memcpy(nvg__fragUniformPtr(gl, call->uniformOffset), &frag, sizeof(frag));
 
 	return;
 
@@ -1526,6 +2282,34 @@ error:
 	if (gl->ncalls > 0) gl->ncalls--;
 }
 
+static void glnvg__renderGetStats(void* uptr, NVGframeStats* stats)
+{
+	GLNVGcontext* gl = (GLNVGcontext*)uptr;
+	stats->rendererDrawCount = gl->drawCount;
+	stats->rendererStateChanges = gl->stateChanges;
+	stats->rendererUploadBytes = gl->uploadBytes;
+}
+
+static void glnvg__renderSetFrameAllocator(void* uptr, const NVGallocator* allocator)
+{
+	GLNVGcontext* gl = (GLNVGcontext*)uptr;
+
+	glnvg__free(gl, gl->calls);
+	glnvg__free(gl, gl->paths);
+	glnvg__free(gl, gl->colors);
+	glnvg__free(gl, gl->indices);
+	if (!glnvg__vertsInRing(gl))
+		glnvg__free(gl, gl->verts);
+	if (!glnvg__uniformsInRing(gl))
+		glnvg__free(gl, gl->uniforms);
+
+	if (allocator != NULL)
+		gl->allocator = *allocator;
+	else
+		memset(&gl->allocator, 0, sizeof(gl->allocator));
+	glnvg__reacquireFrameBuffers(gl);
+}
+
 static void glnvg__renderDelete(void* uptr)
 {
 	GLNVGcontext* gl = (GLNVGcontext*)uptr;
@@ -1535,6 +2319,16 @@ static void glnvg__renderDelete(void* uptr)
 	glnvg__deleteShader(&gl->shader);
 
 #if NANOVG_GL3
+	if (gl->streaming) {
+		// the rings own the buffers and the memory verts and uniforms may point into
+		if ((unsigned char*)gl->verts == gl->vertRing.ptr)
+			gl->verts = NULL;
+		if (gl->uniforms == gl->fragRing.ptr)
+			gl->uniforms = NULL;
+		glnvg__ringDelete(&gl->vertRing);
+		glnvg__ringDelete(&gl->fragRing);
+		gl->vertBuf = gl->fragBuf = 0;
+	}
 #if NANOVG_GL_USE_UNIFORMBUFFER
 	if (gl->fragBuf != 0)
 		glDeleteBuffers(1, &gl->fragBuf);
@@ -1544,6 +2338,10 @@ static void glnvg__renderDelete(void* uptr)
 #endif
 	if (gl->vertBuf != 0)
 		glDeleteBuffers(1, &gl->vertBuf);
+	if (gl->colorBuf != 0)
+		glDeleteBuffers(1, &gl->colorBuf);
+	if (gl->indexBuf != 0)
+		glDeleteBuffers(1, &gl->indexBuf);
 
 	for (i = 0; i < gl->ntextures; i++) {
 		if (gl->textures[i].tex != 0 && (gl->textures[i].flags & NVG_IMAGE_NODELETE) == 0)
@@ -1551,10 +2349,12 @@ static void glnvg__renderDelete(void* uptr)
 	}
 	free(gl->textures);
 
-	free(gl->paths);
-	free(gl->verts);
-	free(gl->uniforms);
-	free(gl->calls);
+	glnvg__free(gl, gl->paths);
+	glnvg__free(gl, gl->verts);
+	glnvg__free(gl, gl->uniforms);
+	glnvg__free(gl, gl->calls);
+	glnvg__free(gl, gl->colors);
+	glnvg__free(gl, gl->indices);
 
 	free(gl);
 }
@@ -1589,6 +2389,10 @@ NVGcontext* nvgCreateGLES3(int flags)
 	params.renderStroke = glnvg__renderStroke;
 	params.renderTriangles = glnvg__renderTriangles;
 	params.renderDelete = glnvg__renderDelete;
+	params.renderGetStats = glnvg__renderGetStats;
+	params.renderSetFrameAllocator = glnvg__renderSetFrameAllocator;
+	params.renderCreateTextureLevels = glnvg__renderCreateTextureLevels;
+	params.renderUpdateTextureLevel = glnvg__renderUpdateTextureLevel;
 	params.userPtr = gl;
 	params.edgeAntiAlias = flags & NVG_ANTIALIAS ? 1 : 0;
 
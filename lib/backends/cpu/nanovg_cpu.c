@@ -0,0 +1,1956 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nanovg_cpu.c
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-05 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Software NanoVG renderer
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanovg_cpu.h"
+#include "nanovg_cpu_kernels.h"
+
+#include "../../nkthreadpool.h"
+
+/* NVGcreateFlags only, no GL implementation is compiled in */
+#include <extern/nanovg/nanovg_gl.h>
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/* vertices are snapped to 1/256 px, like most GL rasterisers */
+#define NK_CPU_SUBPIXEL_BITS (8)
+#define NK_CPU_SUBPIXEL_ONE (1 << NK_CPU_SUBPIXEL_BITS)
+#define NK_CPU_SUBPIXEL_HALF (NK_CPU_SUBPIXEL_ONE / 2)
+
+/* keeps edge function products inside 64 bits */
+#define NK_CPU_MAX_COORD (1048576.0f)
+
+/* flushes are split into square tiles of this many pixels, drawn in parallel */
+#define NK_CPU_TILE_SIZE (64)
+
+/* image ids hold the texture's slot + 1 below the slot's generation, as in nanovg_gl.h */
+#define NK_CPU_TEXTURE_INDEX_BITS (20)
+#define NK_CPU_TEXTURE_INDEX_MASK ((1 << NK_CPU_TEXTURE_INDEX_BITS) - 1)
+#define NK_CPU_TEXTURE_GENERATION_MASK ((1 << (31 - NK_CPU_TEXTURE_INDEX_BITS)) - 1)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* same numbering as the nanovg_gl.h fragment shader */
+typedef enum
+{
+    NK_CPU_SHADER_FILLGRAD,
+    NK_CPU_SHADER_FILLIMG,
+    NK_CPU_SHADER_SIMPLE,
+    NK_CPU_SHADER_IMG
+} nkCpuShader_t;
+
+typedef enum
+{
+    NK_CPU_CALL_NONE = 0,
+    NK_CPU_CALL_FILL,
+    NK_CPU_CALL_CONVEXFILL,
+    NK_CPU_CALL_STROKE,
+    NK_CPU_CALL_TRIANGLES
+} nkCpuCallType_t;
+
+/* the stencil configurations nanovg_gl.h uses, one per pass */
+typedef enum
+{
+    NK_CPU_STENCIL_NONE,        /* no test, no write */
+    NK_CPU_STENCIL_WINDING,     /* no colour, front faces increment, back faces decrement */
+    NK_CPU_STENCIL_EQUAL_ZERO,  /* drawn where zero, kept */
+    NK_CPU_STENCIL_COVER,       /* drawn where non-zero, then zeroed */
+    NK_CPU_STENCIL_STROKE_BASE, /* drawn where zero, then incremented */
+    NK_CPU_STENCIL_CLEAR        /* no colour, zeroed */
+} nkCpuStencil_t;
+
+typedef struct
+{
+    int id;
+    int type;
+    int width;
+    int height;
+    int flags;
+    unsigned char *data;
+    int generation;
+    int nextFree; /* slot + 1 of the next free slot, 0 ends the list */
+    int levels;    /* mipmap levels stored one after the other in data, 0 without */
+    int baseLevel; /* finest of them uploaded */
+} nkCpuTexture_t;
+
+/* pixel rectangle, max exclusive */
+typedef struct
+{
+    int minX;
+    int minY;
+    int maxX;
+    int maxY;
+} nkCpuRect_t;
+
+typedef struct
+{
+    int type;
+    int image;
+    int pathOffset;
+    int pathCount;
+    int triangleOffset;
+    int triangleCount;
+    int fragOffset;
+    NVGcompositeOperationState blend;
+    nkCpuRect_t bounds; /* every pixel any pass of the call can touch */
+    float lod;          /* log2 of texels per pixel, picks the mipmap level */
+} nkCpuCall_t;
+
+typedef struct
+{
+    int fillOffset;
+    int fillCount;
+    int strokeOffset;
+    int strokeCount;
+    int fillTriangles; /* triangulated fill, a triangle list rather than a fan */
+} nkCpuPath_t;
+
+/* range of tileCalls drawn into one tile */
+typedef struct
+{
+    int offset;
+    int count;
+} nkCpuTile_t;
+
+/* state of one pass, the equivalent of the GL pipeline state between draws */
+typedef struct
+{
+    const nkCpuFrag_t *frag;
+    const nkCpuTexture_t *texture;
+    NVGcompositeOperationState blend;
+    nkCpuStencil_t stencil;
+    int sourceOver; /* blend is premultiplied source-over, the vector kernel applies */
+    int cull;
+    int edgeAntiAlias;
+    nkCpuRect_t clip;
+} nkCpuPass_t;
+
+typedef struct
+{
+    int flags;
+    const nkCpuKernels_t *kernels;
+
+    nkCpuTexture_t *textures;
+    int textureCount;
+    int textureCapacity;
+    int freeTexture; /* slot + 1 of the first free slot, 0 when none */
+
+    nkCpuCall_t *calls;
+    int callCount;
+    int callCapacity;
+
+    nkCpuPath_t *paths;
+    int pathCount;
+    int pathCapacity;
+
+    NVGvertex *verts;
+    int vertCount;
+    int vertCapacity;
+
+    nkCpuFrag_t *frags;
+    int fragCount;
+    int fragCapacity;
+
+    unsigned char *pixels;
+    int width;
+    int height;
+    int stride;
+
+    unsigned char *stencil; /* one byte per target pixel, zero between calls */
+
+    nkThreadPool_t *pool; /* NULL draws every tile on the calling thread */
+
+    nkCpuTile_t *tiles;
+    int tileColumns;
+    int tileCount;
+    int tileCapacity;
+
+    int *tileCalls; /* call indices per tile, in submission order */
+    int tileCallCapacity;
+
+    NVGallocator allocator; /* calls, paths, verts, frags and tileCalls, heap when alloc is NULL */
+} nkCpuContext_t;
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static int nkCpu_RenderCreate(void *uptr);
+static int nkCpu_RenderCreateTexture(void *uptr, int type, int w, int h, int imageFlags, const unsigned char *data);
+static int nkCpu_RenderDeleteTexture(void *uptr, int image);
+static int nkCpu_RenderUpdateTexture(void *uptr, int image, int x, int y, int w, int h, const unsigned char *data);
+static int nkCpu_RenderCreateTextureLevels(void *uptr, int w, int h, int nlevels, int imageFlags);
+static int nkCpu_RenderUpdateTextureLevel(void *uptr, int image, int level, const unsigned char *data);
+static int nkCpu_RenderGetTextureSize(void *uptr, int image, int *w, int *h);
+static void nkCpu_RenderViewport(void *uptr, float width, float height, float devicePixelRatio);
+static void nkCpu_RenderCancel(void *uptr);
+static void nkCpu_RenderFlush(void *uptr);
+static void nkCpu_RenderFill(void *uptr, NVGpaint *paint, NVGcompositeOperationState compositeOperation, NVGscissor *scissor, float fringe, const float *bounds, const NVGpath *paths, int npaths);
+static void nkCpu_RenderStroke(void *uptr, NVGpaint *paint, NVGcompositeOperationState compositeOperation, NVGscissor *scissor, float fringe, float strokeWidth, const NVGpath *paths, int npaths);
+static void nkCpu_RenderTriangles(void *uptr, NVGpaint *paint, NVGcompositeOperationState compositeOperation, NVGscissor *scissor, const NVGvertex *verts, int nverts, float fringe, float sdfEdge);
+static void nkCpu_RenderDelete(void *uptr);
+static void nkCpu_RenderSetFrameAllocator(void *uptr, const NVGallocator *allocator);
+
+static void *nkCpu_Realloc(nkCpuContext_t *cpu, void *ptr, size_t used, size_t size);
+static void nkCpu_Free(nkCpuContext_t *cpu, void *ptr);
+static void nkCpu_Reacquire(nkCpuContext_t *cpu, void **ptr, int *capacity, size_t elementSize);
+static void nkCpu_ReacquireFrameBuffers(nkCpuContext_t *cpu);
+
+static nkCpuTexture_t *nkCpu_FindTexture(nkCpuContext_t *cpu, int id);
+static size_t nkCpu_LevelOffset(const nkCpuTexture_t *texture, int level);
+static float nkCpu_PaintLod(nkCpuContext_t *cpu, const NVGpaint *paint);
+static float nkCpu_TriangleLod(nkCpuContext_t *cpu, int image, const NVGvertex *verts, int nverts);
+static NVGcompositeOperationState nkCpu_BlendState(NVGcompositeOperationState op);
+static bool nkCpu_ConvertPaint(nkCpuContext_t *cpu, nkCpuFrag_t *frag, NVGpaint *paint, NVGscissor *scissor, float width, float fringe, float strokeThr);
+static nkCpuCall_t *nkCpu_AllocCall(nkCpuContext_t *cpu);
+static int nkCpu_AllocPaths(nkCpuContext_t *cpu, int count);
+static int nkCpu_AllocVerts(nkCpuContext_t *cpu, int count);
+static int nkCpu_AllocFrags(nkCpuContext_t *cpu, int count);
+static int nkCpu_MaxVertCount(const NVGpath *paths, int npaths);
+static int64_t nkCpu_Fixed(float value);
+static void nkCpu_SetBounds(nkCpuCall_t *call, const NVGvertex *verts, int count);
+static bool nkCpu_BinCalls(nkCpuContext_t *cpu);
+static void nkCpu_RenderTile(void *user, size_t index);
+
+static void nkCpu_RenderCall(nkCpuContext_t *cpu, const nkCpuCall_t *call, nkCpuRect_t target);
+static void nkCpu_DrawFan(nkCpuContext_t *cpu, const nkCpuPass_t *pass, const NVGvertex *verts, int count);
+static void nkCpu_DrawStrip(nkCpuContext_t *cpu, const nkCpuPass_t *pass, const NVGvertex *verts, int count);
+static void nkCpu_DrawTriangle(nkCpuContext_t *cpu, const nkCpuPass_t *pass, const NVGvertex *a, const NVGvertex *b, const NVGvertex *c);
+static void nkCpu_DrawSpan(nkCpuContext_t *cpu, const nkCpuPass_t *pass, const nkCpuSpan_t *span, int front);
+static void nkCpu_ShadeImage(const nkCpuPass_t *pass, const nkCpuSpan_t *span, const float *coverage, const uint8_t *mask, float *rgba);
+static void nkCpu_Sample(const nkCpuTexture_t *texture, float u, float v, float color[4]);
+static void nkCpu_Blend(const NVGcompositeOperationState *blend, const float src[4], unsigned char *dst);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+NVGcontext* nvgCreateCPU(int flags)
+{
+    NVGparams params;
+    NVGcontext *ctx = NULL;
+    nkCpuContext_t *cpu = (nkCpuContext_t*)calloc(1, sizeof(nkCpuContext_t));
+
+    if (cpu == NULL)
+    {
+        fprintf(stderr, "ERROR: Failed to allocate CPU renderer.\n");
+        return NULL;
+    }
+
+    memset(&params, 0, sizeof(params));
+    params.renderCreate = nkCpu_RenderCreate;
+    params.renderCreateTexture = nkCpu_RenderCreateTexture;
+    params.renderDeleteTexture = nkCpu_RenderDeleteTexture;
+    params.renderUpdateTexture = nkCpu_RenderUpdateTexture;
+    params.renderGetTextureSize = nkCpu_RenderGetTextureSize;
+    params.renderViewport = nkCpu_RenderViewport;
+    params.renderCancel = nkCpu_RenderCancel;
+    params.renderFlush = nkCpu_RenderFlush;
+    params.renderFill = nkCpu_RenderFill;
+    params.renderStroke = nkCpu_RenderStroke;
+    params.renderTriangles = nkCpu_RenderTriangles;
+    params.renderDelete = nkCpu_RenderDelete;
+    params.renderSetFrameAllocator = nkCpu_RenderSetFrameAllocator;
+    params.renderCreateTextureLevels = nkCpu_RenderCreateTextureLevels;
+    params.renderUpdateTextureLevel = nkCpu_RenderUpdateTextureLevel;
+    params.userPtr = cpu;
+    params.edgeAntiAlias = (flags & NVG_ANTIALIAS) ? 1 : 0;
+
+    cpu->flags = flags;
+    cpu->kernels = nkCpu_SelectKernels(NVG_CPU_SIMD_AVX2);
+
+    /* nvgCreateInternal calls renderDelete on failure */
+    ctx = nvgCreateInternal(&params);
+
+    if (ctx == NULL)
+    {
+        fprintf(stderr, "ERROR: Failed to create CPU NanoVG context.\n");
+        return NULL;
+    }
+
+    return ctx;
+}
+
+void nvgDeleteCPU(NVGcontext* ctx)
+{
+    nvgDeleteInternal(ctx);
+}
+
+void nvgCPUSetTarget(NVGcontext* ctx, unsigned char* pixels, int width, int height, int stride)
+{
+    nkCpuContext_t *cpu = (nkCpuContext_t*)nvgInternalParams(ctx)->userPtr;
+
+    if (pixels == NULL || width <= 0 || height <= 0)
+    {
+        pixels = NULL;
+        width = 0;
+        height = 0;
+    }
+
+    if (width * height != cpu->width * cpu->height)
+    {
+        free(cpu->stencil);
+        cpu->stencil = NULL;
+
+        if (width > 0 && (cpu->stencil = (unsigned char*)calloc((size_t)width * (size_t)height, 1)) == NULL)
+        {
+            fprintf(stderr, "ERROR: Failed to allocate %dx%d stencil buffer.\n", width, height);
+            pixels = NULL;
+            width = 0;
+            height = 0;
+        }
+    }
+
+    cpu->pixels = pixels;
+    cpu->width = width;
+    cpu->height = height;
+    cpu->stride = stride;
+}
+
+int nvgCPUSetSimd(NVGcontext* ctx, int level)
+{
+    nkCpuContext_t *cpu = (nkCpuContext_t*)nvgInternalParams(ctx)->userPtr;
+
+    cpu->kernels = nkCpu_SelectKernels(level);
+    return cpu->kernels->level;
+}
+
+int nvgCPUSetThreads(NVGcontext* ctx, int threads)
+{
+    nkCpuContext_t *cpu = (nkCpuContext_t*)nvgInternalParams(ctx)->userPtr;
+
+    nkThreadPool_Destroy(cpu->pool);
+    cpu->pool = nkThreadPool_Create(threads > 0 ? (size_t)threads : 0);
+
+    return (int)nkThreadPool_ThreadCount(cpu->pool);
+}
+
+void nvgCPUClear(NVGcontext* ctx, NVGcolor color)
+{
+    nkCpuContext_t *cpu = (nkCpuContext_t*)nvgInternalParams(ctx)->userPtr;
+
+    nvgCPUClearRect(ctx, color, 0, 0, cpu->width, cpu->height);
+}
+
+void nvgCPUClearRect(NVGcontext* ctx, NVGcolor color, int x, int y, int w, int h)
+{
+    nkCpuContext_t *cpu = (nkCpuContext_t*)nvgInternalParams(ctx)->userPtr;
+    unsigned char texel[4];
+
+    int x0 = NK_CPU_MAX(x, 0);
+    int y0 = NK_CPU_MAX(y, 0);
+    int x1 = NK_CPU_MIN(x + w, cpu->width);
+    int y1 = NK_CPU_MIN(y + h, cpu->height);
+
+    if (cpu->pixels == NULL || x0 >= x1 || y0 >= y1)
+    {
+        return;
+    }
+
+    texel[0] = (unsigned char)(NK_CPU_CLAMP(color.r * color.a, 0.0f, 1.0f) * 255.0f + 0.5f);
+    texel[1] = (unsigned char)(NK_CPU_CLAMP(color.g * color.a, 0.0f, 1.0f) * 255.0f + 0.5f);
+    texel[2] = (unsigned char)(NK_CPU_CLAMP(color.b * color.a, 0.0f, 1.0f) * 255.0f + 0.5f);
+    texel[3] = (unsigned char)(NK_CPU_CLAMP(color.a, 0.0f, 1.0f) * 255.0f + 0.5f);
+
+    for (int row = y0; row < y1; row++)
+    {
+        unsigned char *pixel = cpu->pixels + (size_t)row * (size_t)cpu->stride;
+
+        for (int column = x0; column < x1; column++)
+        {
+            memcpy(pixel + column * 4, texel, 4);
+        }
+
+        memset(cpu->stencil + (size_t)row * (size_t)cpu->width + x0, 0, (size_t)(x1 - x0));
+    }
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static int nkCpu_RenderCreate(void *uptr)
+{
+    (void)uptr;
+    return 1;
+}
+
+static int nkCpu_RenderCreateTexture(void *uptr, int type, int w, int h, int imageFlags, const unsigned char *data)
+{
+    nkCpuContext_t *cpu = (nkCpuContext_t*)uptr;
+    nkCpuTexture_t *texture = NULL;
+    size_t bytes = (size_t)w * (size_t)h * (type == NVG_TEXTURE_RGBA ? 4 : 1);
+    int generation = 0;
+
+    if (cpu->freeTexture != 0)
+    {
+        texture = &cpu->textures[cpu->freeTexture - 1];
+        generation = texture->generation;
+    }
+    else
+    {
+        if (cpu->textureCount >= NK_CPU_TEXTURE_INDEX_MASK)
+        {
+            return 0;
+        }
+
+        if (cpu->textureCount + 1 > cpu->textureCapacity)
+        {
+            int capacity = NK_CPU_MAX(cpu->textureCount + 1, 4) + cpu->textureCapacity / 2;
+            nkCpuTexture_t *textures = (nkCpuTexture_t*)realloc(cpu->textures, sizeof(nkCpuTexture_t) * (size_t)capacity);
+
+            if (textures == NULL)
+            {
+                return 0;
+            }
+
+            cpu->textures = textures;
+            cpu->textureCapacity = capacity;
+        }
+
+        texture = &cpu->textures[cpu->textureCount];
+    }
+
+    unsigned char *pixels = (unsigned char*)calloc(bytes > 0 ? bytes : 1, 1);
+
+    if (pixels == NULL)
+    {
+        fprintf(stderr, "ERROR: Failed to allocate %dx%d texture.\n", w, h);
+        return 0;
+    }
+
+    /* the slot is only taken once nothing can fail */
+    if (cpu->freeTexture != 0)
+    {
+        cpu->freeTexture = texture->nextFree;
+    }
+    else
+    {
+        cpu->textureCount++;
+    }
+
+    memset(texture, 0, sizeof(*texture));
+    texture->data = pixels;
+
+    if (data != NULL)
+    {
+        memcpy(texture->data, data, bytes);
+    }
+
+    /* mipmaps are not built; GENERATE_MIPMAPS images sample the base level */
+    texture->generation = generation;
+    texture->id = (generation << NK_CPU_TEXTURE_INDEX_BITS) | (int)(texture - cpu->textures + 1);
+    texture->type = type;
+    texture->width = w;
+    texture->height = h;
+    texture->flags = imageFlags;
+
+    return texture->id;
+}
+
+static int nkCpu_RenderDeleteTexture(void *uptr, int image)
+{
+    nkCpuContext_t *cpu = (nkCpuContext_t*)uptr;
+    nkCpuTexture_t *texture = nkCpu_FindTexture(cpu, image);
+
+    if (texture == NULL)
+    {
+        return 0;
+    }
+
+    /* the next texture in the slot gets a new id, stale ones stop matching */
+    int generation = (texture->generation + 1) & NK_CPU_TEXTURE_GENERATION_MASK;
+
+    free(texture->data);
+    memset(texture, 0, sizeof(*texture));
+    texture->generation = generation;
+    texture->nextFree = cpu->freeTexture;
+    cpu->freeTexture = (int)(texture - cpu->textures + 1);
+    return 1;
+}
+
+static int nkCpu_RenderUpdateTexture(void *uptr, int image, int x, int y, int w, int h, const unsigned char *data)
+{
+    nkCpuContext_t *cpu = (nkCpuContext_t*)uptr;
+    nkCpuTexture_t *texture = nkCpu_FindTexture(cpu, image);
+
+    if (texture == NULL)
+    {
+        return 0;
+    }
+
+    /* data is the whole image, rows of texture->width, as with GL_UNPACK_ROW_LENGTH */
+    size_t bpp = texture->type == NVG_TEXTURE_RGBA ? 4 : 1;
+    size_t rowBytes = (size_t)texture->width * bpp;
+
+    for (int row = y; row < y + h; row++)
+    {
+        size_t offset = (size_t)row * rowBytes + (size_t)x * bpp;
+        memcpy(texture->data + offset, data + offset, (size_t)w * bpp);
+    }
+
+    return 1;
+}
+
+static int nkCpu_RenderCreateTextureLevels(void *uptr, int w, int h, int nlevels, int imageFlags)
+{
+    nkCpuContext_t *cpu = (nkCpuContext_t*)uptr;
+
+    if (nlevels < 1 || w < 1 || h < 1)
+    {
+        return 0;
+    }
+
+    int image = nkCpu_RenderCreateTexture(uptr, NVG_TEXTURE_RGBA, w, h, imageFlags & ~NVG_IMAGE_GENERATE_MIPMAPS, NULL);
+    nkCpuTexture_t *texture = image ? nkCpu_FindTexture(cpu, image) : NULL;
+
+    if (texture == NULL)
+    {
+        return 0;
+    }
+
+    /* levels follow level 0 in the same block, offsets come from nkCpu_LevelOffset */
+    texture->levels = nlevels;
+    texture->baseLevel = nlevels;
+
+    unsigned char *data = (unsigned char*)realloc(texture->data, nkCpu_LevelOffset(texture, nlevels));
+
+    if (data == NULL)
+    {
+        fprintf(stderr, "ERROR: Failed to allocate %d mipmap levels.\n", nlevels);
+        nkCpu_RenderDeleteTexture(uptr, image);
+        return 0;
+    }
+
+    texture->data = data;
+    return image;
+}
+
+static int nkCpu_RenderUpdateTextureLevel(void *uptr, int image, int level, const unsigned char *data)
+{
+    nkCpuTexture_t *texture = nkCpu_FindTexture((nkCpuContext_t*)uptr, image);
+
+    if (texture == NULL || level < 0 || level >= texture->levels)
+    {
+        return 0;
+    }
+
+    memcpy(texture->data + nkCpu_LevelOffset(texture, level), data, nkCpu_LevelOffset(texture, level + 1) - nkCpu_LevelOffset(texture, level));
+    texture->baseLevel = NK_CPU_MIN(texture->baseLevel, level);
+    return 1;
+}
+
+static int nkCpu_RenderGetTextureSize(void *uptr, int image, int *w, int *h)
+{
+    nkCpuTexture_t *texture = nkCpu_FindTexture((nkCpuContext_t*)uptr, image);
+
+    if (texture == NULL)
+    {
+        return 0;
+    }
+
+    *w = texture->width;
+    *h = texture->height;
+    return 1;
+}
+
+static void nkCpu_RenderViewport(void *uptr, float width, float height, float devicePixelRatio)
+{
+    nkCpuContext_t *cpu = (nkCpuContext_t*)uptr;
+
+    /* the frame allocator was reset, last frame's buffers are gone */
+    if (cpu->allocator.alloc != NULL)
+    {
+        nkCpu_ReacquireFrameBuffers(cpu);
+    }
+
+    /* geometry arrives in target pixels, there is no projection to update */
+    (void)width;
+    (void)height;
+    (void)devicePixelRatio;
+}
+
+static void nkCpu_RenderCancel(void *uptr)
+{
+    nkCpuContext_t *cpu = (nkCpuContext_t*)uptr;
+
+    cpu->callCount = 0;
+    cpu->pathCount = 0;
+    cpu->vertCount = 0;
+    cpu->fragCount = 0;
+}
+
+/* tiles share no pixels or stencil and each draws its calls in submission order, so the
+** result does not depend on how many threads run them */
+static void nkCpu_RenderFlush(void *uptr)
+{
+    nkCpuContext_t *cpu = (nkCpuContext_t*)uptr;
+    nkCpuRect_t target = { 0, 0, cpu->width, cpu->height };
+
+    if (cpu->pixels != NULL && cpu->callCount > 0)
+    {
+        if (nkCpu_BinCalls(cpu))
+        {
+            nkThreadPool_ParallelFor(cpu->pool, (size_t)cpu->tileCount, nkCpu_RenderTile, cpu);
+        }
+        else
+        {
+            /* no memory for the bins, the whole target is one tile */
+            for (int i = 0; i < cpu->callCount; i++)
+            {
+                nkCpu_RenderCall(cpu, &cpu->calls[i], target);
+            }
+        }
+    }
+
+    nkCpu_RenderCancel(cpu);
+}
+
+static void nkCpu_RenderFill(void *uptr, NVGpaint *paint, NVGcompositeOperationState compositeOperation, NVGscissor *scissor, float fringe, const float *bounds, const NVGpath *paths, int npaths)
+{
+    nkCpuContext_t *cpu = (nkCpuContext_t*)uptr;
+    nkCpuCall_t *call = nkCpu_AllocCall(cpu);
+    int offset = 0;
+    int first = 0;
+
+    if (call == NULL)
+    {
+        return;
+    }
+
+    call->type = NK_CPU_CALL_FILL;
+    call->triangleCount = 4;
+    call->image = paint->image;
+    call->lod = nkCpu_PaintLod(cpu, paint);
+    call->blend = nkCpu_BlendState(compositeOperation);
+
+    if ((npaths == 1 && paths[0].convex) || (npaths > 0 && paths[0].triangles))
+    {
+        call->type = NK_CPU_CALL_CONVEXFILL;
+        call->triangleCount = 0;
+    }
+
+    if ((call->pathOffset = nkCpu_AllocPaths(cpu, npaths)) < 0 ||
+        (offset = nkCpu_AllocVerts(cpu, nkCpu_MaxVertCount(paths, npaths) + call->triangleCount)) < 0)
+    {
+        goto error;
+    }
+
+    call->pathCount = npaths;
+    first = offset;
+
+    for (int i = 0; i < npaths; i++)
+    {
+        nkCpuPath_t *copy = &cpu->paths[call->pathOffset + i];
+        memset(copy, 0, sizeof(*copy));
+        copy->fillTriangles = paths[i].triangles;
+
+        if (paths[i].nfill > 0)
+        {
+            copy->fillOffset = offset;
+            copy->fillCount = paths[i].nfill;
+            memcpy(&cpu->verts[offset], paths[i].fill, sizeof(NVGvertex) * (size_t)paths[i].nfill);
+            offset += paths[i].nfill;
+        }
+
+        if (paths[i].nstroke > 0)
+        {
+            copy->strokeOffset = offset;
+            copy->strokeCount = paths[i].nstroke;
+            memcpy(&cpu->verts[offset], paths[i].stroke, sizeof(NVGvertex) * (size_t)paths[i].nstroke);
+            offset += paths[i].nstroke;
+        }
+    }
+
+    if (call->type == NK_CPU_CALL_FILL)
+    {
+        /* cover quad, same winding as nanovg_gl.h */
+        NVGvertex *quad = &cpu->verts[offset];
+        const float corners[4][2] = {
+            { bounds[2], bounds[3] }, { bounds[2], bounds[1] },
+            { bounds[0], bounds[3] }, { bounds[0], bounds[1] }
+        };
+
+        for (int i = 0; i < 4; i++)
+        {
+            quad[i].x = corners[i][0];
+            quad[i].y = corners[i][1];
+            quad[i].u = 0.5f;
+            quad[i].v = 1.0f;
+        }
+
+        call->triangleOffset = offset;
+        offset += call->triangleCount;
+
+        if ((call->fragOffset = nkCpu_AllocFrags(cpu, 2)) < 0)
+        {
+            goto error;
+        }
+
+        nkCpuFrag_t *simple = &cpu->frags[call->fragOffset];
+        memset(simple, 0, sizeof(*simple));
+        simple->strokeThr = -1.0f;
+        simple->type = NK_CPU_SHADER_SIMPLE;
+
+        if (!nkCpu_ConvertPaint(cpu, &cpu->frags[call->fragOffset + 1], paint, scissor, fringe, fringe, -1.0f))
+        {
+            goto error;
+        }
+    }
+    else
+    {
+        if ((call->fragOffset = nkCpu_AllocFrags(cpu, 1)) < 0 ||
+            !nkCpu_ConvertPaint(cpu, &cpu->frags[call->fragOffset], paint, scissor, fringe, fringe, -1.0f))
+        {
+            goto error;
+        }
+    }
+
+    nkCpu_SetBounds(call, &cpu->verts[first], offset - first);
+    return;
+
+error:
+    /* the call is the last one allocated, drop it */
+    if (cpu->callCount > 0)
+    {
+        cpu->callCount--;
+    }
+}
+
+static void nkCpu_RenderStroke(void *uptr, NVGpaint *paint, NVGcompositeOperationState compositeOperation, NVGscissor *scissor, float fringe, float strokeWidth, const NVGpath *paths, int npaths)
+{
+    nkCpuContext_t *cpu = (nkCpuContext_t*)uptr;
+    nkCpuCall_t *call = nkCpu_AllocCall(cpu);
+    int offset = 0;
+    int first = 0;
+
+    if (call == NULL)
+    {
+        return;
+    }
+
+    call->type = NK_CPU_CALL_STROKE;
+    call->image = paint->image;
+    call->lod = nkCpu_PaintLod(cpu, paint);
+    call->blend = nkCpu_BlendState(compositeOperation);
+
+    if ((call->pathOffset = nkCpu_AllocPaths(cpu, npaths)) < 0 ||
+        (offset = nkCpu_AllocVerts(cpu, nkCpu_MaxVertCount(paths, npaths))) < 0)
+    {
+        goto error;
+    }
+
+    call->pathCount = npaths;
+    first = offset;
+
+    for (int i = 0; i < npaths; i++)
+    {
+        nkCpuPath_t *copy = &cpu->paths[call->pathOffset + i];
+        memset(copy, 0, sizeof(*copy));
+
+        if (paths[i].nstroke > 0)
+        {
+            copy->strokeOffset = offset;
+            copy->strokeCount = paths[i].nstroke;
+            memcpy(&cpu->verts[offset], paths[i].stroke, sizeof(NVGvertex) * (size_t)paths[i].nstroke);
+            offset += paths[i].nstroke;
+        }
+    }
+
+    if (cpu->flags & NVG_STENCIL_STROKES)
+    {
+        if ((call->fragOffset = nkCpu_AllocFrags(cpu, 2)) < 0 ||
+            !nkCpu_ConvertPaint(cpu, &cpu->frags[call->fragOffset], paint, scissor, strokeWidth, fringe, -1.0f) ||
+            !nkCpu_ConvertPaint(cpu, &cpu->frags[call->fragOffset + 1], paint, scissor, strokeWidth, fringe, 1.0f - 0.5f / 255.0f))
+        {
+            goto error;
+        }
+    }
+    else
+    {
+        if ((call->fragOffset = nkCpu_AllocFrags(cpu, 1)) < 0 ||
+            !nkCpu_ConvertPaint(cpu, &cpu->frags[call->fragOffset], paint, scissor, strokeWidth, fringe, -1.0f))
+        {
+            goto error;
+        }
+    }
+
+    nkCpu_SetBounds(call, &cpu->verts[first], offset - first);
+    return;
+
+error:
+    if (cpu->callCount > 0)
+    {
+        cpu->callCount--;
+    }
+}
+
+static void nkCpu_RenderTriangles(void *uptr, NVGpaint *paint, NVGcompositeOperationState compositeOperation, NVGscissor *scissor, const NVGvertex *verts, int nverts, float fringe, float sdfEdge)
+{
+    nkCpuContext_t *cpu = (nkCpuContext_t*)uptr;
+    nkCpuCall_t *call = nkCpu_AllocCall(cpu);
+
+    if (call == NULL)
+    {
+        return;
+    }
+
+    call->type = NK_CPU_CALL_TRIANGLES;
+    call->image = paint->image;
+    call->lod = nkCpu_TriangleLod(cpu, paint->image, verts, nverts);
+    call->blend = nkCpu_BlendState(compositeOperation);
+
+    if ((call->triangleOffset = nkCpu_AllocVerts(cpu, nverts)) < 0 ||
+        (call->fragOffset = nkCpu_AllocFrags(cpu, 1)) < 0 ||
+        !nkCpu_ConvertPaint(cpu, &cpu->frags[call->fragOffset], paint, scissor, 1.0f, fringe, -1.0f))
+    {
+        cpu->callCount--;
+        return;
+    }
+
+    call->triangleCount = nverts;
+    memcpy(&cpu->verts[call->triangleOffset], verts, sizeof(NVGvertex) * (size_t)nverts);
+    cpu->frags[call->fragOffset].type = NK_CPU_SHADER_IMG;
+
+    if (sdfEdge > 0.0f)
+    {
+        cpu->frags[call->fragOffset].texType = 3;
+        cpu->frags[call->fragOffset].feather = sdfEdge;
+    }
+
+    nkCpu_SetBounds(call, verts, nverts);
+}
+
+static void nkCpu_RenderDelete(void *uptr)
+{
+    nkCpuContext_t *cpu = (nkCpuContext_t*)uptr;
+
+    if (cpu == NULL)
+    {
+        return;
+    }
+
+    for (int i = 0; i < cpu->textureCount; i++)
+    {
+        free(cpu->textures[i].data);
+    }
+
+    free(cpu->textures);
+    nkCpu_Free(cpu, cpu->calls);
+    nkCpu_Free(cpu, cpu->paths);
+    nkCpu_Free(cpu, cpu->verts);
+    nkCpu_Free(cpu, cpu->frags);
+    free(cpu->stencil);
+    free(cpu->tiles);
+    nkCpu_Free(cpu, cpu->tileCalls);
+    nkThreadPool_Destroy(cpu->pool);
+    free(cpu);
+}
+
+static void nkCpu_RenderSetFrameAllocator(void *uptr, const NVGallocator *allocator)
+{
+    nkCpuContext_t *cpu = (nkCpuContext_t*)uptr;
+
+    nkCpu_Free(cpu, cpu->calls);
+    nkCpu_Free(cpu, cpu->paths);
+    nkCpu_Free(cpu, cpu->verts);
+    nkCpu_Free(cpu, cpu->frags);
+    nkCpu_Free(cpu, cpu->tileCalls);
+
+    if (allocator != NULL)
+    {
+        cpu->allocator = *allocator;
+    }
+    else
+    {
+        memset(&cpu->allocator, 0, sizeof(cpu->allocator));
+    }
+
+    nkCpu_ReacquireFrameBuffers(cpu);
+}
+
+/* frame allocators cannot resize, the used part is copied and the old block left to their reset */
+static void *nkCpu_Realloc(nkCpuContext_t *cpu, void *ptr, size_t used, size_t size)
+{
+    if (cpu->allocator.alloc == NULL)
+    {
+        return realloc(ptr, size);
+    }
+
+    void *block = cpu->allocator.alloc(cpu->allocator.userPtr, (int)size);
+
+    if (block != NULL && ptr != NULL && used > 0)
+    {
+        memcpy(block, ptr, used);
+    }
+
+    return block;
+}
+
+static void nkCpu_Free(nkCpuContext_t *cpu, void *ptr)
+{
+    if (cpu->allocator.alloc == NULL)
+    {
+        free(ptr);
+    }
+}
+
+static void nkCpu_Reacquire(nkCpuContext_t *cpu, void **ptr, int *capacity, size_t elementSize)
+{
+    *ptr = *capacity > 0 ? nkCpu_Realloc(cpu, NULL, 0, elementSize * (size_t)*capacity) : NULL;
+
+    if (*ptr == NULL)
+    {
+        *capacity = 0;
+    }
+}
+
+/* empty buffers of the capacity the last frame ended with */
+static void nkCpu_ReacquireFrameBuffers(nkCpuContext_t *cpu)
+{
+    cpu->callCount = 0;
+    cpu->pathCount = 0;
+    cpu->vertCount = 0;
+    cpu->fragCount = 0;
+
+    nkCpu_Reacquire(cpu, (void**)&cpu->calls, &cpu->callCapacity, sizeof(nkCpuCall_t));
+    nkCpu_Reacquire(cpu, (void**)&cpu->paths, &cpu->pathCapacity, sizeof(nkCpuPath_t));
+    nkCpu_Reacquire(cpu, (void**)&cpu->verts, &cpu->vertCapacity, sizeof(NVGvertex));
+    nkCpu_Reacquire(cpu, (void**)&cpu->frags, &cpu->fragCapacity, sizeof(nkCpuFrag_t));
+    nkCpu_Reacquire(cpu, (void**)&cpu->tileCalls, &cpu->tileCallCapacity, sizeof(int));
+}
+
+/* bytes before level in a mipmapped texture's data, or of the whole texture for level levels */
+static size_t nkCpu_LevelOffset(const nkCpuTexture_t *texture, int level)
+{
+    size_t offset = 0;
+
+    for (int i = 0; i < level; i++)
+    {
+        offset += (size_t)NK_CPU_MAX(texture->width >> i, 1) * (size_t)NK_CPU_MAX(texture->height >> i, 1) * 4;
+    }
+
+    return offset;
+}
+
+/* image patterns scale the image by the paint transform */
+static float nkCpu_PaintLod(nkCpuContext_t *cpu, const NVGpaint *paint)
+{
+    const nkCpuTexture_t *texture = paint->image != 0 ? nkCpu_FindTexture(cpu, paint->image) : NULL;
+    float area = fabsf(paint->xform[0] * paint->xform[3] - paint->xform[1] * paint->xform[2]) * paint->extent[0] * paint->extent[1];
+
+    if (texture == NULL || texture->levels <= 1 || area <= 0.0f)
+    {
+        return 0.0f;
+    }
+
+    return 0.5f * log2f((float)texture->width * (float)texture->height / area);
+}
+
+/* the texel rate of the first triangle, as GL takes it from the UV derivatives */
+static float nkCpu_TriangleLod(nkCpuContext_t *cpu, int image, const NVGvertex *verts, int nverts)
+{
+    const nkCpuTexture_t *texture = image != 0 ? nkCpu_FindTexture(cpu, image) : NULL;
+
+    if (texture == NULL || texture->levels <= 1 || nverts < 3)
+    {
+        return 0.0f;
+    }
+
+    float ex1 = verts[1].x - verts[0].x, ey1 = verts[1].y - verts[0].y;
+    float ex2 = verts[2].x - verts[0].x, ey2 = verts[2].y - verts[0].y;
+    float du1 = (verts[1].u - verts[0].u) * (float)texture->width, dv1 = (verts[1].v - verts[0].v) * (float)texture->height;
+    float du2 = (verts[2].u - verts[0].u) * (float)texture->width, dv2 = (verts[2].v - verts[0].v) * (float)texture->height;
+    float det = ex1 * ey2 - ex2 * ey1;
+
+    if (fabsf(det) < 1e-6f)
+    {
+        return 0.0f;
+    }
+
+    float dudx = (du1 * ey2 - du2 * ey1) / det, dvdx = (dv1 * ey2 - dv2 * ey1) / det;
+    float dudy = (du2 * ex1 - du1 * ex2) / det, dvdy = (dv2 * ex1 - dv1 * ex2) / det;
+    float rho = NK_CPU_MAX(dudx * dudx + dvdx * dvdx, dudy * dudy + dvdy * dvdy);
+
+    return rho > 0.0f ? 0.5f * log2f(rho) : 0.0f;
+}
+
+static nkCpuTexture_t *nkCpu_FindTexture(nkCpuContext_t *cpu, int id)
+{
+    int index = (id & NK_CPU_TEXTURE_INDEX_MASK) - 1;
+
+    if (id <= 0 || index < 0 || index >= cpu->textureCount || cpu->textures[index].id != id)
+    {
+        return NULL;
+    }
+
+    return &cpu->textures[index];
+}
+
+static bool nkCpu_ValidBlendFactor(int factor)
+{
+    return factor >= NVG_ZERO && factor <= NVG_SRC_ALPHA_SATURATE && (factor & (factor - 1)) == 0;
+}
+
+/* unknown factors fall back to premultiplied source-over, as glnvg__blendCompositeOperation does */
+static NVGcompositeOperationState nkCpu_BlendState(NVGcompositeOperationState op)
+{
+    if (!nkCpu_ValidBlendFactor(op.srcRGB) || !nkCpu_ValidBlendFactor(op.dstRGB) ||
+        !nkCpu_ValidBlendFactor(op.srcAlpha) || !nkCpu_ValidBlendFactor(op.dstAlpha))
+    {
+        op.srcRGB = NVG_ONE;
+        op.dstRGB = NVG_ONE_MINUS_SRC_ALPHA;
+        op.srcAlpha = NVG_ONE;
+        op.dstAlpha = NVG_ONE_MINUS_SRC_ALPHA;
+    }
+
+    return op;
+}
+
+static NVGcolor nkCpu_PremulColor(NVGcolor c)
+{
+    c.r *= c.a;
+    c.g *= c.a;
+    c.b *= c.a;
+    return c;
+}
+
+static bool nkCpu_ConvertPaint(nkCpuContext_t *cpu, nkCpuFrag_t *frag, NVGpaint *paint, NVGscissor *scissor, float width, float fringe, float strokeThr)
+{
+    float invxform[6];
+
+    memset(frag, 0, sizeof(*frag));
+
+    frag->innerCol = nkCpu_PremulColor(paint->innerColor);
+    frag->outerCol = nkCpu_PremulColor(paint->outerColor);
+
+    if (scissor->extent[0] < -0.5f || scissor->extent[1] < -0.5f)
+    {
+        frag->scissorExt[0] = 1.0f;
+        frag->scissorExt[1] = 1.0f;
+        frag->scissorScale[0] = 1.0f;
+        frag->scissorScale[1] = 1.0f;
+    }
+    else
+    {
+        nvgTransformInverse(frag->scissorMat, scissor->xform);
+        frag->scissorExt[0] = scissor->extent[0];
+        frag->scissorExt[1] = scissor->extent[1];
+        frag->scissorScale[0] = sqrtf(scissor->xform[0] * scissor->xform[0] + scissor->xform[2] * scissor->xform[2]) / fringe;
+        frag->scissorScale[1] = sqrtf(scissor->xform[1] * scissor->xform[1] + scissor->xform[3] * scissor->xform[3]) / fringe;
+    }
+
+    frag->extent[0] = paint->extent[0];
+    frag->extent[1] = paint->extent[1];
+    frag->strokeMult = (width * 0.5f + fringe * 0.5f) / fringe;
+    frag->strokeThr = strokeThr;
+
+    if (paint->image != 0)
+    {
+        nkCpuTexture_t *texture = nkCpu_FindTexture(cpu, paint->image);
+
+        if (texture == NULL)
+        {
+            return false;
+        }
+
+        if (texture->flags & NVG_IMAGE_FLIPY)
+        {
+            float m1[6], m2[6];
+            nvgTransformTranslate(m1, 0.0f, frag->extent[1] * 0.5f);
+            nvgTransformMultiply(m1, paint->xform);
+            nvgTransformScale(m2, 1.0f, -1.0f);
+            nvgTransformMultiply(m2, m1);
+            nvgTransformTranslate(m1, 0.0f, -frag->extent[1] * 0.5f);
+            nvgTransformMultiply(m1, m2);
+            nvgTransformInverse(invxform, m1);
+        }
+        else
+        {
+            nvgTransformInverse(invxform, paint->xform);
+        }
+
+        frag->type = NK_CPU_SHADER_FILLIMG;
+
+        if (texture->type == NVG_TEXTURE_RGBA)
+        {
+            frag->texType = (texture->flags & NVG_IMAGE_PREMULTIPLIED) ? 0 : 1;
+        }
+        else
+        {
+            frag->texType = 2;
+        }
+    }
+    else
+    {
+        frag->type = NK_CPU_SHADER_FILLGRAD;
+        frag->radius = paint->radius;
+        frag->feather = paint->feather;
+        nvgTransformInverse(invxform, paint->xform);
+    }
+
+    memcpy(frag->paintMat, invxform, sizeof(invxform));
+
+    return true;
+}
+
+static nkCpuCall_t *nkCpu_AllocCall(nkCpuContext_t *cpu)
+{
+    if (cpu->callCount + 1 > cpu->callCapacity)
+    {
+        int capacity = NK_CPU_MAX(cpu->callCount + 1, 128) + cpu->callCapacity / 2;
+        nkCpuCall_t *calls = (nkCpuCall_t*)nkCpu_Realloc(cpu, cpu->calls, sizeof(nkCpuCall_t) * (size_t)cpu->callCount, sizeof(nkCpuCall_t) * (size_t)capacity);
+
+        if (calls == NULL)
+        {
+            return NULL;
+        }
+
+        cpu->calls = calls;
+        cpu->callCapacity = capacity;
+    }
+
+    nkCpuCall_t *call = &cpu->calls[cpu->callCount++];
+    memset(call, 0, sizeof(*call));
+    return call;
+}
+
+static int nkCpu_AllocPaths(nkCpuContext_t *cpu, int count)
+{
+    if (cpu->pathCount + count > cpu->pathCapacity)
+    {
+        int capacity = NK_CPU_MAX(cpu->pathCount + count, 128) + cpu->pathCapacity / 2;
+        nkCpuPath_t *paths = (nkCpuPath_t*)nkCpu_Realloc(cpu, cpu->paths, sizeof(nkCpuPath_t) * (size_t)cpu->pathCount, sizeof(nkCpuPath_t) * (size_t)capacity);
+
+        if (paths == NULL)
+        {
+            return -1;
+        }
+
+        cpu->paths = paths;
+        cpu->pathCapacity = capacity;
+    }
+
+    int offset = cpu->pathCount;
+    cpu->pathCount += count;
+    return offset;
+}
+
+static int nkCpu_AllocVerts(nkCpuContext_t *cpu, int count)
+{
+    if (cpu->vertCount + count > cpu->vertCapacity)
+    {
+        int capacity = NK_CPU_MAX(cpu->vertCount + count, 4096) + cpu->vertCapacity / 2;
+        NVGvertex *verts = (NVGvertex*)nkCpu_Realloc(cpu, cpu->verts, sizeof(NVGvertex) * (size_t)cpu->vertCount, sizeof(NVGvertex) * (size_t)capacity);
+
+        if (verts == NULL)
+        {
+            return -1;
+        }
+
+        cpu->verts = verts;
+        cpu->vertCapacity = capacity;
+    }
+
+    int offset = cpu->vertCount;
+    cpu->vertCount += count;
+    return offset;
+}
+
+static int nkCpu_AllocFrags(nkCpuContext_t *cpu, int count)
+{
+    if (cpu->fragCount + count > cpu->fragCapacity)
+    {
+        int capacity = NK_CPU_MAX(cpu->fragCount + count, 128) + cpu->fragCapacity / 2;
+        nkCpuFrag_t *frags = (nkCpuFrag_t*)nkCpu_Realloc(cpu, cpu->frags, sizeof(nkCpuFrag_t) * (size_t)cpu->fragCount, sizeof(nkCpuFrag_t) * (size_t)capacity);
+
+        if (frags == NULL)
+        {
+            return -1;
+        }
+
+        cpu->frags = frags;
+        cpu->fragCapacity = capacity;
+    }
+
+    int offset = cpu->fragCount;
+    cpu->fragCount += count;
+    return offset;
+}
+
+static int nkCpu_MaxVertCount(const NVGpath *paths, int npaths)
+{
+    int count = 0;
+
+    for (int i = 0; i < npaths; i++)
+    {
+        count += paths[i].nfill + paths[i].nstroke;
+    }
+
+    return count;
+}
+
+/* MARK: tiles */
+
+/* pixel bounds of the vertices, computed the way nkCpu_DrawTriangle bounds a triangle */
+static void nkCpu_SetBounds(nkCpuCall_t *call, const NVGvertex *verts, int count)
+{
+    int64_t minX = 0, minY = 0, maxX = 0, maxY = 0;
+
+    memset(&call->bounds, 0, sizeof(call->bounds));
+
+    if (count <= 0)
+    {
+        return;
+    }
+
+    minX = maxX = nkCpu_Fixed(verts[0].x);
+    minY = maxY = nkCpu_Fixed(verts[0].y);
+
+    for (int i = 1; i < count; i++)
+    {
+        int64_t x = nkCpu_Fixed(verts[i].x);
+        int64_t y = nkCpu_Fixed(verts[i].y);
+
+        minX = NK_CPU_MIN(minX, x);
+        minY = NK_CPU_MIN(minY, y);
+        maxX = NK_CPU_MAX(maxX, x);
+        maxY = NK_CPU_MAX(maxY, y);
+    }
+
+    call->bounds.minX = (int)((minX - NK_CPU_SUBPIXEL_HALF) >> NK_CPU_SUBPIXEL_BITS);
+    call->bounds.minY = (int)((minY - NK_CPU_SUBPIXEL_HALF) >> NK_CPU_SUBPIXEL_BITS);
+    call->bounds.maxX = (int)((maxX - NK_CPU_SUBPIXEL_HALF) >> NK_CPU_SUBPIXEL_BITS) + 1;
+    call->bounds.maxY = (int)((maxY - NK_CPU_SUBPIXEL_HALF) >> NK_CPU_SUBPIXEL_BITS) + 1;
+}
+
+/* lists, per tile, the calls whose bounds overlap it. false when the lists cannot be
+** allocated. */
+static bool nkCpu_BinCalls(nkCpuContext_t *cpu)
+{
+    int columns = (cpu->width + NK_CPU_TILE_SIZE - 1) / NK_CPU_TILE_SIZE;
+    int rows = (cpu->height + NK_CPU_TILE_SIZE - 1) / NK_CPU_TILE_SIZE;
+    int tileCount = columns * rows;
+    int total = 0;
+
+    if (tileCount > cpu->tileCapacity)
+    {
+        nkCpuTile_t *tiles = (nkCpuTile_t*)realloc(cpu->tiles, sizeof(nkCpuTile_t) * (size_t)tileCount);
+
+        if (tiles == NULL)
+        {
+            return false;
+        }
+
+        cpu->tiles = tiles;
+        cpu->tileCapacity = tileCount;
+    }
+
+    cpu->tileColumns = columns;
+    cpu->tileCount = tileCount;
+    memset(cpu->tiles, 0, sizeof(nkCpuTile_t) * (size_t)tileCount);
+
+    /* count, then turn the counts into offsets and fill */
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int i = 0; i < cpu->callCount; i++)
+        {
+            const nkCpuRect_t *bounds = &cpu->calls[i].bounds;
+            int minX = NK_CPU_MAX(bounds->minX, 0);
+            int minY = NK_CPU_MAX(bounds->minY, 0);
+            int maxX = NK_CPU_MIN(bounds->maxX, cpu->width);
+            int maxY = NK_CPU_MIN(bounds->maxY, cpu->height);
+
+            if (minX >= maxX || minY >= maxY)
+            {
+                continue;
+            }
+
+            for (int row = minY / NK_CPU_TILE_SIZE; row <= (maxY - 1) / NK_CPU_TILE_SIZE; row++)
+            {
+                for (int column = minX / NK_CPU_TILE_SIZE; column <= (maxX - 1) / NK_CPU_TILE_SIZE; column++)
+                {
+                    nkCpuTile_t *tile = &cpu->tiles[row * columns + column];
+
+                    if (pass == 1)
+                    {
+                        cpu->tileCalls[tile->offset + tile->count] = i;
+                    }
+
+                    tile->count++;
+                }
+            }
+        }
+
+        if (pass == 1)
+        {
+            break;
+        }
+
+        for (int t = 0; t < tileCount; t++)
+        {
+            cpu->tiles[t].offset = total;
+            total += cpu->tiles[t].count;
+            cpu->tiles[t].count = 0;
+        }
+
+        if (total > cpu->tileCallCapacity)
+        {
+            int capacity = total + total / 2;
+            int *tileCalls = (int*)nkCpu_Realloc(cpu, cpu->tileCalls, 0, sizeof(int) * (size_t)capacity);
+
+            if (tileCalls == NULL)
+            {
+                return false;
+            }
+
+            cpu->tileCalls = tileCalls;
+            cpu->tileCallCapacity = capacity;
+        }
+    }
+
+    return true;
+}
+
+/* nkThreadPoolTask_t, draws every call binned into the tile, clipped to it */
+static void nkCpu_RenderTile(void *user, size_t index)
+{
+    nkCpuContext_t *cpu = (nkCpuContext_t*)user;
+    const nkCpuTile_t *tile = &cpu->tiles[index];
+    int column = (int)(index % (size_t)cpu->tileColumns);
+    int row = (int)(index / (size_t)cpu->tileColumns);
+    nkCpuRect_t target;
+
+    target.minX = column * NK_CPU_TILE_SIZE;
+    target.minY = row * NK_CPU_TILE_SIZE;
+    target.maxX = NK_CPU_MIN(target.minX + NK_CPU_TILE_SIZE, cpu->width);
+    target.maxY = NK_CPU_MIN(target.minY + NK_CPU_TILE_SIZE, cpu->height);
+
+    for (int i = 0; i < tile->count; i++)
+    {
+        nkCpu_RenderCall(cpu, &cpu->calls[cpu->tileCalls[tile->offset + i]], target);
+    }
+}
+
+/* MARK: rasterisation */
+
+/* replays one recorded call with the pass sequence of glnvg__fill, glnvg__convexFill,
+** glnvg__stroke and glnvg__triangles, limited to the target rectangle */
+static void nkCpu_RenderCall(nkCpuContext_t *cpu, const nkCpuCall_t *call, nkCpuRect_t target)
+{
+    const nkCpuPath_t *paths = &cpu->paths[call->pathOffset];
+    nkCpuPass_t pass;
+
+    nkCpuTexture_t level;
+
+    memset(&pass, 0, sizeof(pass));
+    pass.texture = call->image != 0 ? nkCpu_FindTexture(cpu, call->image) : NULL;
+
+    /* one level per call, the nearest to its texel rate, sampled bilinearly */
+    if (pass.texture != NULL && pass.texture->levels > 1)
+    {
+        int index = NK_CPU_CLAMP((int)floorf(call->lod + 0.5f), pass.texture->baseLevel, pass.texture->levels - 1);
+
+        level = *pass.texture;
+        level.data = pass.texture->data + nkCpu_LevelOffset(pass.texture, index);
+        level.width = NK_CPU_MAX(pass.texture->width >> index, 1);
+        level.height = NK_CPU_MAX(pass.texture->height >> index, 1);
+        pass.texture = &level;
+    }
+    pass.blend = call->blend;
+    pass.sourceOver = call->blend.srcRGB == NVG_ONE && call->blend.dstRGB == NVG_ONE_MINUS_SRC_ALPHA &&
+                      call->blend.srcAlpha == NVG_ONE && call->blend.dstAlpha == NVG_ONE_MINUS_SRC_ALPHA;
+    pass.edgeAntiAlias = (cpu->flags & NVG_ANTIALIAS) ? 1 : 0;
+    pass.clip = target;
+    pass.cull = 1;
+
+    switch (call->type)
+    {
+        case NK_CPU_CALL_FILL:
+        {
+            /* winding counts into the stencil, both faces */
+            pass.frag = &cpu->frags[call->fragOffset];
+            pass.stencil = NK_CPU_STENCIL_WINDING;
+            pass.cull = 0;
+
+            for (int i = 0; i < call->pathCount; i++)
+            {
+                nkCpu_DrawFan(cpu, &pass, &cpu->verts[paths[i].fillOffset], paths[i].fillCount);
+            }
+
+            pass.frag = &cpu->frags[call->fragOffset + 1];
+            pass.cull = 1;
+
+            if (pass.edgeAntiAlias)
+            {
+                pass.stencil = NK_CPU_STENCIL_EQUAL_ZERO;
+
+                for (int i = 0; i < call->pathCount; i++)
+                {
+                    nkCpu_DrawStrip(cpu, &pass, &cpu->verts[paths[i].strokeOffset], paths[i].strokeCount);
+                }
+            }
+
+            pass.stencil = NK_CPU_STENCIL_COVER;
+            nkCpu_DrawStrip(cpu, &pass, &cpu->verts[call->triangleOffset], call->triangleCount);
+            break;
+        }
+
+        case NK_CPU_CALL_CONVEXFILL:
+        {
+            pass.frag = &cpu->frags[call->fragOffset];
+            pass.stencil = NK_CPU_STENCIL_NONE;
+
+            for (int i = 0; i < call->pathCount; i++)
+            {
+                const NVGvertex *fill = &cpu->verts[paths[i].fillOffset];
+
+                if (paths[i].fillTriangles)
+                {
+                    for (int j = 0; j + 2 < paths[i].fillCount; j += 3)
+                    {
+                        nkCpu_DrawTriangle(cpu, &pass, &fill[j], &fill[j + 1], &fill[j + 2]);
+                    }
+                }
+                else
+                {
+                    nkCpu_DrawFan(cpu, &pass, fill, paths[i].fillCount);
+                }
+
+                nkCpu_DrawStrip(cpu, &pass, &cpu->verts[paths[i].strokeOffset], paths[i].strokeCount);
+            }
+            break;
+        }
+
+        case NK_CPU_CALL_STROKE:
+        {
+            if (cpu->flags & NVG_STENCIL_STROKES)
+            {
+                /* base, anti-aliased fringe, then clear */
+                const nkCpuStencil_t stencils[3] = { NK_CPU_STENCIL_STROKE_BASE, NK_CPU_STENCIL_EQUAL_ZERO, NK_CPU_STENCIL_CLEAR };
+                const int frags[3] = { 1, 0, 0 };
+
+                for (int step = 0; step < 3; step++)
+                {
+                    pass.frag = &cpu->frags[call->fragOffset + frags[step]];
+                    pass.stencil = stencils[step];
+
+                    for (int i = 0; i < call->pathCount; i++)
+                    {
+                        nkCpu_DrawStrip(cpu, &pass, &cpu->verts[paths[i].strokeOffset], paths[i].strokeCount);
+                    }
+                }
+            }
+            else
+            {
+                pass.frag = &cpu->frags[call->fragOffset];
+                pass.stencil = NK_CPU_STENCIL_NONE;
+
+                for (int i = 0; i < call->pathCount; i++)
+                {
+                    nkCpu_DrawStrip(cpu, &pass, &cpu->verts[paths[i].strokeOffset], paths[i].strokeCount);
+                }
+            }
+            break;
+        }
+
+        case NK_CPU_CALL_TRIANGLES:
+        {
+            const NVGvertex *verts = &cpu->verts[call->triangleOffset];
+
+            pass.frag = &cpu->frags[call->fragOffset];
+            pass.stencil = NK_CPU_STENCIL_NONE;
+
+            for (int i = 0; i + 2 < call->triangleCount; i += 3)
+            {
+                nkCpu_DrawTriangle(cpu, &pass, &verts[i], &verts[i + 1], &verts[i + 2]);
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+static void nkCpu_DrawFan(nkCpuContext_t *cpu, const nkCpuPass_t *pass, const NVGvertex *verts, int count)
+{
+    for (int i = 2; i < count; i++)
+    {
+        nkCpu_DrawTriangle(cpu, pass, &verts[0], &verts[i - 1], &verts[i]);
+    }
+}
+
+static void nkCpu_DrawStrip(nkCpuContext_t *cpu, const nkCpuPass_t *pass, const NVGvertex *verts, int count)
+{
+    /* odd triangles swap their first two vertices to keep the winding, as GL does */
+    for (int i = 2; i < count; i++)
+    {
+        if (i & 1)
+        {
+            nkCpu_DrawTriangle(cpu, pass, &verts[i - 1], &verts[i - 2], &verts[i]);
+        }
+        else
+        {
+            nkCpu_DrawTriangle(cpu, pass, &verts[i - 2], &verts[i - 1], &verts[i]);
+        }
+    }
+}
+
+static int64_t nkCpu_Fixed(float value)
+{
+    value = NK_CPU_MIN(NK_CPU_MAX(value, -NK_CPU_MAX_COORD), NK_CPU_MAX_COORD);
+    return (int64_t)llrintf(value * (float)NK_CPU_SUBPIXEL_ONE);
+}
+
+/* half-space rasteriser sampling pixel centres with the top-left fill rule, so fans and
+** strips sharing an edge touch every pixel exactly once. each row's covered run is solved
+** exactly from the integer edge functions and handed to the span kernels. */
+static void nkCpu_DrawTriangle(nkCpuContext_t *cpu, const nkCpuPass_t *pass, const NVGvertex *a, const NVGvertex *b, const NVGvertex *c)
+{
+    int64_t x0 = nkCpu_Fixed(a->x), y0 = nkCpu_Fixed(a->y);
+    int64_t x1 = nkCpu_Fixed(b->x), y1 = nkCpu_Fixed(b->y);
+    int64_t x2 = nkCpu_Fixed(c->x), y2 = nkCpu_Fixed(c->y);
+
+    int64_t area = (x1 - x0) * (y2 - y0) - (x2 - x0) * (y1 - y0);
+
+    if (area == 0)
+    {
+        return;
+    }
+
+    /* GL's y axis points up, so its counter-clockwise front faces have negative area here */
+    int front = area < 0;
+
+    if (pass->cull && !front)
+    {
+        return;
+    }
+
+    if (area < 0)
+    {
+        const NVGvertex *swapVertex = b;
+        int64_t swapX = x1, swapY = y1;
+        b = c;
+        x1 = x2;
+        y1 = y2;
+        c = swapVertex;
+        x2 = swapX;
+        y2 = swapY;
+        area = -area;
+    }
+
+    /* the unclipped bounds anchor interpolation, so a pixel shades the same whichever
+    ** clip rectangle it is drawn through */
+    int refX = (int)((NK_CPU_MIN(x0, NK_CPU_MIN(x1, x2)) - NK_CPU_SUBPIXEL_HALF) >> NK_CPU_SUBPIXEL_BITS);
+    int refY = (int)((NK_CPU_MIN(y0, NK_CPU_MIN(y1, y2)) - NK_CPU_SUBPIXEL_HALF) >> NK_CPU_SUBPIXEL_BITS);
+    int endX = (int)((NK_CPU_MAX(x0, NK_CPU_MAX(x1, x2)) - NK_CPU_SUBPIXEL_HALF) >> NK_CPU_SUBPIXEL_BITS) + 1;
+    int endY = (int)((NK_CPU_MAX(y0, NK_CPU_MAX(y1, y2)) - NK_CPU_SUBPIXEL_HALF) >> NK_CPU_SUBPIXEL_BITS) + 1;
+
+    int minX = NK_CPU_MAX(refX, pass->clip.minX);
+    int minY = NK_CPU_MAX(refY, pass->clip.minY);
+    int maxX = NK_CPU_MIN(endX, pass->clip.maxX);
+    int maxY = NK_CPU_MIN(endY, pass->clip.maxY);
+
+    if (minX >= maxX || minY >= maxY)
+    {
+        return;
+    }
+
+    /* edge e is opposite vertex e; E(p) = dx * (p.y - y) - dy * (p.x - x) */
+    const int64_t ex[3] = { x1, x2, x0 }, ey[3] = { y1, y2, y0 };
+    const int64_t edx[3] = { x2 - x1, x0 - x2, x1 - x0 };
+    const int64_t edy[3] = { y2 - y1, y0 - y2, y1 - y0 };
+    int64_t bias[3], rowE[3], stepX[3], stepY[3];
+
+    int64_t sx = ((int64_t)refX << NK_CPU_SUBPIXEL_BITS) + NK_CPU_SUBPIXEL_HALF;
+    int64_t sy = ((int64_t)minY << NK_CPU_SUBPIXEL_BITS) + NK_CPU_SUBPIXEL_HALF;
+
+    for (int e = 0; e < 3; e++)
+    {
+        int topLeft = edy[e] < 0 || (edy[e] == 0 && edx[e] > 0);
+        bias[e] = topLeft ? 0 : -1;
+        rowE[e] = edx[e] * (sy - ey[e]) - edy[e] * (sx - ex[e]);
+        stepX[e] = -edy[e] * NK_CPU_SUBPIXEL_ONE;
+        stepY[e] = edx[e] * NK_CPU_SUBPIXEL_ONE;
+    }
+
+    float invArea = 1.0f / (float)area;
+    float dwa = (float)stepX[0] * invArea;
+    float dwb = (float)stepX[1] * invArea;
+    float dwc = -(dwa + dwb);
+
+    nkCpuSpan_t span;
+    span.xRef = refX;
+    span.du = dwa * a->u + dwb * b->u + dwc * c->u;
+    span.dv = dwa * a->v + dwb * b->v + dwc * c->v;
+
+    for (int y = minY; y < maxY; y++)
+    {
+        /* pixels refX + k with k in [kMin, kMax] pass all three edges */
+        int64_t kMin = minX - refX;
+        int64_t kMax = maxX - refX - 1;
+
+        for (int e = 0; e < 3 && kMin <= kMax; e++)
+        {
+            int64_t t = rowE[e] + bias[e];
+
+            if (stepX[e] == 0)
+            {
+                if (t < 0)
+                {
+                    kMax = -1;
+                }
+            }
+            else if (stepX[e] > 0)
+            {
+                if (t < 0)
+                {
+                    kMin = NK_CPU_MAX(kMin, (-t + stepX[e] - 1) / stepX[e]);
+                }
+            }
+            else
+            {
+                if (t < 0)
+                {
+                    kMax = -1;
+                }
+                else
+                {
+                    kMax = NK_CPU_MIN(kMax, t / -stepX[e]);
+                }
+            }
+        }
+
+        if (kMin <= kMax)
+        {
+            float wa = (float)rowE[0] * invArea;
+            float wb = (float)rowE[1] * invArea;
+            float wc = 1.0f - wa - wb;
+
+            span.x = refX + (int)kMin;
+            span.y = y;
+            span.count = (int)(kMax - kMin + 1);
+            span.u = wa * a->u + wb * b->u + wc * c->u;
+            span.v = wa * a->v + wb * b->v + wc * c->v;
+
+            nkCpu_DrawSpan(cpu, pass, &span, front);
+        }
+
+        rowE[0] += stepY[0];
+        rowE[1] += stepY[1];
+        rowE[2] += stepY[2];
+    }
+}
+
+static void nkCpu_DrawSpan(nkCpuContext_t *cpu, const nkCpuPass_t *pass, const nkCpuSpan_t *span, int front)
+{
+    uint8_t *stencil = cpu->stencil + (size_t)span->y * (size_t)cpu->width + (size_t)span->x;
+
+    if (pass->stencil == NK_CPU_STENCIL_WINDING)
+    {
+        uint8_t delta = front ? 1 : 0xff;
+
+        for (int i = 0; i < span->count; i++)
+        {
+            stencil[i] = (uint8_t)(stencil[i] + delta);
+        }
+        return;
+    }
+
+    if (pass->stencil == NK_CPU_STENCIL_CLEAR)
+    {
+        memset(stencil, 0, (size_t)span->count);
+        return;
+    }
+
+    const nkCpuFrag_t *frag = pass->frag;
+    uint8_t mask[NK_CPU_SPAN_MAX];
+    float coverage[NK_CPU_SPAN_MAX];
+    float rgba[NK_CPU_SPAN_MAX * 4];
+
+    for (int first = 0; first < span->count; first += NK_CPU_SPAN_MAX)
+    {
+        nkCpuSpan_t chunk = *span;
+        uint8_t *chunkStencil = stencil + first;
+        int any = 0;
+
+        chunk.x += first;
+        chunk.count = NK_CPU_MIN(span->count - first, NK_CPU_SPAN_MAX);
+
+        for (int i = 0; i < chunk.count; i++)
+        {
+            switch (pass->stencil)
+            {
+                case NK_CPU_STENCIL_EQUAL_ZERO:
+                case NK_CPU_STENCIL_STROKE_BASE:
+                    mask[i] = chunkStencil[i] == 0;
+                    break;
+
+                case NK_CPU_STENCIL_COVER:
+                    mask[i] = chunkStencil[i] != 0;
+                    break;
+
+                default:
+                    mask[i] = 1;
+                    break;
+            }
+
+            any |= mask[i];
+        }
+
+        if (!any)
+        {
+            continue;
+        }
+
+        /* textured triangles take the scissor alone, like the IMG shader branch */
+        cpu->kernels->coverage(frag, &chunk, pass->edgeAntiAlias, frag->type == NK_CPU_SHADER_IMG, coverage, mask);
+
+        if (frag->type == NK_CPU_SHADER_FILLGRAD)
+        {
+            cpu->kernels->gradient(frag, &chunk, coverage, rgba);
+        }
+        else
+        {
+            nkCpu_ShadeImage(pass, &chunk, coverage, mask, rgba);
+        }
+
+        /* discarded fragments leave the stencil alone */
+        if (pass->stencil == NK_CPU_STENCIL_STROKE_BASE)
+        {
+            for (int i = 0; i < chunk.count; i++)
+            {
+                chunkStencil[i] = (uint8_t)(chunkStencil[i] + mask[i]);
+            }
+        }
+        else if (pass->stencil == NK_CPU_STENCIL_COVER)
+        {
+            for (int i = 0; i < chunk.count; i++)
+            {
+                chunkStencil[i] = mask[i] ? 0 : chunkStencil[i];
+            }
+        }
+
+        uint8_t *pixels = cpu->pixels + (size_t)chunk.y * (size_t)cpu->stride + (size_t)chunk.x * 4;
+
+        if (pass->sourceOver)
+        {
+            cpu->kernels->sourceOver(rgba, chunk.count, mask, pixels);
+        }
+        else
+        {
+            for (int i = 0; i < chunk.count; i++)
+            {
+                if (mask[i])
+                {
+                    const float color[4] = { rgba[i], rgba[i + NK_CPU_SPAN_MAX], rgba[i + NK_CPU_SPAN_MAX * 2], rgba[i + NK_CPU_SPAN_MAX * 3] };
+                    nkCpu_Blend(&pass->blend, color, pixels + i * 4);
+                }
+            }
+        }
+    }
+}
+
+/* image and textured triangle branches of the shader; sampling stays scalar */
+static void nkCpu_ShadeImage(const nkCpuPass_t *pass, const nkCpuSpan_t *span, const float *coverage, const uint8_t *mask, float *rgba)
+{
+    const nkCpuFrag_t *frag = pass->frag;
+    const float *pm = frag->paintMat;
+    float py = (float)span->y + 0.5f;
+
+    for (int i = 0; i < span->count; i++)
+    {
+        float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+        if (!mask[i])
+        {
+            continue;
+        }
+
+        if (frag->type == NK_CPU_SHADER_FILLIMG || frag->type == NK_CPU_SHADER_IMG)
+        {
+            if (frag->type == NK_CPU_SHADER_FILLIMG)
+            {
+                float px = (float)(span->x + i) + 0.5f;
+                float ptx = pm[0] * px + pm[2] * py + pm[4];
+                float pty = pm[1] * px + pm[3] * py + pm[5];
+                nkCpu_Sample(pass->texture, ptx / frag->extent[0], pty / frag->extent[1], color);
+            }
+            else
+            {
+                float t = (float)(span->x + i - span->xRef);
+                nkCpu_Sample(pass->texture, span->u + span->du * t, span->v + span->dv * t, color);
+            }
+
+            if (frag->texType == 1)
+            {
+                color[0] *= color[3];
+                color[1] *= color[3];
+                color[2] *= color[3];
+            }
+            else if (frag->texType == 2)
+            {
+                color[1] = color[2] = color[3] = color[0];
+            }
+            else if (frag->texType == 3)
+            {
+                /* distance field glyph, the outline at 0.5 smoothed over feather */
+                color[0] = NK_CPU_CLAMP((color[0] - 0.5f) / frag->feather + 0.5f, 0.0f, 1.0f);
+                color[1] = color[2] = color[3] = color[0];
+            }
+
+            color[0] *= frag->innerCol.r * coverage[i];
+            color[1] *= frag->innerCol.g * coverage[i];
+            color[2] *= frag->innerCol.b * coverage[i];
+            color[3] *= frag->innerCol.a * coverage[i];
+        }
+
+        rgba[i] = color[0];
+        rgba[i + NK_CPU_SPAN_MAX] = color[1];
+        rgba[i + NK_CPU_SPAN_MAX * 2] = color[2];
+        rgba[i + NK_CPU_SPAN_MAX * 3] = color[3];
+    }
+}
+
+static int nkCpu_Wrap(int i, int size, int repeat)
+{
+    if (repeat)
+    {
+        i %= size;
+        return i < 0 ? i + size : i;
+    }
+
+    return i < 0 ? 0 : (i >= size ? size - 1 : i);
+}
+
+static void nkCpu_Texel(const nkCpuTexture_t *texture, int x, int y, float color[4])
+{
+    if (texture->type == NVG_TEXTURE_RGBA)
+    {
+        const unsigned char *texel = texture->data + ((size_t)y * (size_t)texture->width + (size_t)x) * 4;
+        color[0] = texel[0] * (1.0f / 255.0f);
+        color[1] = texel[1] * (1.0f / 255.0f);
+        color[2] = texel[2] * (1.0f / 255.0f);
+        color[3] = texel[3] * (1.0f / 255.0f);
+    }
+    else
+    {
+        /* single channel textures read as (r, 0, 0, 1) like GL_R8 */
+        color[0] = texture->data[(size_t)y * (size_t)texture->width + (size_t)x] * (1.0f / 255.0f);
+        color[1] = 0.0f;
+        color[2] = 0.0f;
+        color[3] = 1.0f;
+    }
+}
+
+/* GL_LINEAR or GL_NEAREST with CLAMP_TO_EDGE or REPEAT per axis */
+static void nkCpu_Sample(const nkCpuTexture_t *texture, float u, float v, float color[4])
+{
+    if (texture == NULL || texture->width <= 0 || texture->height <= 0)
+    {
+        color[0] = color[1] = color[2] = 0.0f;
+        color[3] = 1.0f;
+        return;
+    }
+
+    int repeatX = (texture->flags & NVG_IMAGE_REPEATX) != 0;
+    int repeatY = (texture->flags & NVG_IMAGE_REPEATY) != 0;
+    float tx = u * (float)texture->width;
+    float ty = v * (float)texture->height;
+
+    if (texture->flags & NVG_IMAGE_NEAREST)
+    {
+        nkCpu_Texel(texture,
+                    nkCpu_Wrap((int)floorf(tx), texture->width, repeatX),
+                    nkCpu_Wrap((int)floorf(ty), texture->height, repeatY),
+                    color);
+        return;
+    }
+
+    tx -= 0.5f;
+    ty -= 0.5f;
+
+    float fx = floorf(tx), fy = floorf(ty);
+    float ax = tx - fx, ay = ty - fy;
+    int ix0 = nkCpu_Wrap((int)fx, texture->width, repeatX);
+    int ix1 = nkCpu_Wrap((int)fx + 1, texture->width, repeatX);
+    int iy0 = nkCpu_Wrap((int)fy, texture->height, repeatY);
+    int iy1 = nkCpu_Wrap((int)fy + 1, texture->height, repeatY);
+    float c00[4], c10[4], c01[4], c11[4];
+
+    nkCpu_Texel(texture, ix0, iy0, c00);
+    nkCpu_Texel(texture, ix1, iy0, c10);
+    nkCpu_Texel(texture, ix0, iy1, c01);
+    nkCpu_Texel(texture, ix1, iy1, c11);
+
+    for (int i = 0; i < 4; i++)
+    {
+        float top = c00[i] + (c10[i] - c00[i]) * ax;
+        float bottom = c01[i] + (c11[i] - c01[i]) * ax;
+        color[i] = top + (bottom - top) * ay;
+    }
+}
+
+static float nkCpu_BlendFactor(int factor, const float src[4], const float dst[4], int channel)
+{
+    switch (factor)
+    {
+        case NVG_ZERO:                return 0.0f;
+        case NVG_ONE:                 return 1.0f;
+        case NVG_SRC_COLOR:           return src[channel];
+        case NVG_ONE_MINUS_SRC_COLOR: return 1.0f - src[channel];
+        case NVG_DST_COLOR:           return dst[channel];
+        case NVG_ONE_MINUS_DST_COLOR: return 1.0f - dst[channel];
+        case NVG_SRC_ALPHA:           return src[3];
+        case NVG_ONE_MINUS_SRC_ALPHA: return 1.0f - src[3];
+        case NVG_DST_ALPHA:           return dst[3];
+        case NVG_ONE_MINUS_DST_ALPHA: return 1.0f - dst[3];
+        case NVG_SRC_ALPHA_SATURATE:  return channel == 3 ? 1.0f : NK_CPU_MIN(src[3], 1.0f - dst[3]);
+        default:                      return 0.0f;
+    }
+}
+
+static void nkCpu_Blend(const NVGcompositeOperationState *blend, const float src[4], unsigned char *dst)
+{
+    float d[4] = { dst[0] * (1.0f / 255.0f), dst[1] * (1.0f / 255.0f), dst[2] * (1.0f / 255.0f), dst[3] * (1.0f / 255.0f) };
+    float s[4] = { NK_CPU_CLAMP(src[0], 0.0f, 1.0f), NK_CPU_CLAMP(src[1], 0.0f, 1.0f), NK_CPU_CLAMP(src[2], 0.0f, 1.0f), NK_CPU_CLAMP(src[3], 0.0f, 1.0f) };
+
+    for (int i = 0; i < 4; i++)
+    {
+        int srcFactor = i == 3 ? blend->srcAlpha : blend->srcRGB;
+        int dstFactor = i == 3 ? blend->dstAlpha : blend->dstRGB;
+        float sf = nkCpu_BlendFactor(srcFactor, s, d, i);
+        float df = nkCpu_BlendFactor(dstFactor, s, d, i);
+
+        dst[i] = (unsigned char)(NK_CPU_CLAMP(s[i] * sf + d[i] * df, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+}
@@ -0,0 +1,73 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nanovg_cpu.h
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-05 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Software NanoVG renderer
+**
+***************************************************************/
+
+#ifndef NANOVG_CPU_H
+#define NANOVG_CPU_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <extern/nanovg/nanovg.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* span kernel sets, all levels produce identical pixels */
+enum NVGcpuSimd {
+    NVG_CPU_SIMD_SCALAR = 0,
+    NVG_CPU_SIMD_SSE2,
+    NVG_CPU_SIMD_AVX2,
+};
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* renderer with the same pipeline as nanovg_gl.h, rasterised on the CPU. flags are the
+** NVGcreateFlags accepted by nvgCreateGL3. nothing is drawn until a target is set. */
+NVGcontext* nvgCreateCPU(int flags);
+void nvgDeleteCPU(NVGcontext* ctx);
+
+/* premultiplied RGBA8, top row first. the buffer stays owned by the caller and must
+** outlive the frames drawn into it. */
+void nvgCPUSetTarget(NVGcontext* ctx, unsigned char* pixels, int width, int height, int stride);
+
+/* contexts start on the widest kernels the CPU supports. lowers (or restores) the level,
+** clamped to what is supported, and returns the level now in use. */
+int nvgCPUSetSimd(NVGcontext* ctx, int level);
+
+/* contexts start single threaded. threads counts the caller, 0 is one per core. frames are
+** identical for any count. returns the count now in use. */
+int nvgCPUSetThreads(NVGcontext* ctx, int threads);
+
+/* fills the whole target immediately, like glClear outside nvgBeginFrame/nvgEndFrame */
+void nvgCPUClear(NVGcontext* ctx, NVGcolor color);
+
+/* fills the pixels of the target inside x, y, w, h, like glClear with a glScissor */
+void nvgCPUClearRect(NVGcontext* ctx, NVGcolor color, int x, int y, int w, int h);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NANOVG_CPU_H */
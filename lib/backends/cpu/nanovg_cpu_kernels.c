@@ -0,0 +1,576 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nanovg_cpu_kernels.c
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-05 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Span kernels of the software NanoVG renderer
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanovg_cpu_kernels.h"
+#include "nanovg_cpu.h"
+
+#include <math.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/* the vector kernels evaluate the scalar expressions in the same order with the same
+** IEEE operations (no reciprocal estimates, no FMA), so every level writes the same bytes */
+
+#if (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)) && !defined(__EMSCRIPTEN__)
+    #define NK_CPU_X86 1
+#else
+    #define NK_CPU_X86 0
+#endif
+
+#if NK_CPU_X86
+    #include <immintrin.h>
+
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define NK_CPU_TARGET_SSE2
+        #define NK_CPU_TARGET_AVX2
+    #else
+        #define NK_CPU_TARGET_SSE2 __attribute__((target("sse2")))
+        #define NK_CPU_TARGET_AVX2 __attribute__((target("avx2")))
+    #endif
+#endif
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void nkCpu_CoverageScalar(const nkCpuFrag_t *frag, const nkCpuSpan_t *span, int edgeAntiAlias, int scissorOnly, float *coverage, uint8_t *mask);
+static void nkCpu_GradientScalar(const nkCpuFrag_t *frag, const nkCpuSpan_t *span, const float *coverage, float *rgba);
+static void nkCpu_SourceOverScalar(const float *rgba, int count, const uint8_t *mask, uint8_t *dst);
+
+static void nkCpu_CoverageFrom(const nkCpuFrag_t *frag, const nkCpuSpan_t *span, int edgeAntiAlias, int scissorOnly, float *coverage, uint8_t *mask, int first);
+static void nkCpu_GradientFrom(const nkCpuFrag_t *frag, const nkCpuSpan_t *span, const float *coverage, float *rgba, int first);
+static void nkCpu_SourceOverFrom(const float *rgba, int count, const uint8_t *mask, uint8_t *dst, int first);
+
+#if NK_CPU_X86
+static void nkCpu_CoverageSSE2(const nkCpuFrag_t *frag, const nkCpuSpan_t *span, int edgeAntiAlias, int scissorOnly, float *coverage, uint8_t *mask);
+static void nkCpu_GradientSSE2(const nkCpuFrag_t *frag, const nkCpuSpan_t *span, const float *coverage, float *rgba);
+static void nkCpu_SourceOverSSE2(const float *rgba, int count, const uint8_t *mask, uint8_t *dst);
+
+static void nkCpu_CoverageAVX2(const nkCpuFrag_t *frag, const nkCpuSpan_t *span, int edgeAntiAlias, int scissorOnly, float *coverage, uint8_t *mask);
+static void nkCpu_GradientAVX2(const nkCpuFrag_t *frag, const nkCpuSpan_t *span, const float *coverage, float *rgba);
+static void nkCpu_SourceOverAVX2(const float *rgba, int count, const uint8_t *mask, uint8_t *dst);
+#endif
+
+static int nkCpu_SupportedSimd(void);
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static const nkCpuKernels_t nkCpu_KernelsScalar = {
+    NVG_CPU_SIMD_SCALAR, nkCpu_CoverageScalar, nkCpu_GradientScalar, nkCpu_SourceOverScalar
+};
+
+#if NK_CPU_X86
+static const nkCpuKernels_t nkCpu_KernelsSSE2 = {
+    NVG_CPU_SIMD_SSE2, nkCpu_CoverageSSE2, nkCpu_GradientSSE2, nkCpu_SourceOverSSE2
+};
+
+static const nkCpuKernels_t nkCpu_KernelsAVX2 = {
+    NVG_CPU_SIMD_AVX2, nkCpu_CoverageAVX2, nkCpu_GradientAVX2, nkCpu_SourceOverAVX2
+};
+#endif
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+const nkCpuKernels_t *nkCpu_SelectKernels(int level)
+{
+    int supported = nkCpu_SupportedSimd();
+
+    if (level > supported)
+    {
+        level = supported;
+    }
+
+#if NK_CPU_X86
+    if (level >= NVG_CPU_SIMD_AVX2)
+    {
+        return &nkCpu_KernelsAVX2;
+    }
+
+    if (level >= NVG_CPU_SIMD_SSE2)
+    {
+        return &nkCpu_KernelsSSE2;
+    }
+#endif
+
+    return &nkCpu_KernelsScalar;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static int nkCpu_SupportedSimd(void)
+{
+#if NK_CPU_X86 && defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    int level = NVG_CPU_SIMD_SCALAR;
+
+    __cpuid(info, 1);
+
+    if (info[3] & (1 << 26))
+    {
+        level = NVG_CPU_SIMD_SSE2;
+    }
+
+    /* AVX needs OS support for the YMM state (OSXSAVE and XCR0 bits 1-2) */
+    if ((info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6)
+    {
+        __cpuid(info, 0);
+
+        if (info[0] >= 7)
+        {
+            __cpuidex(info, 7, 0);
+
+            if (info[1] & (1 << 5))
+            {
+                level = NVG_CPU_SIMD_AVX2;
+            }
+        }
+    }
+
+    return level;
+#elif NK_CPU_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return NVG_CPU_SIMD_AVX2;
+    }
+
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return NVG_CPU_SIMD_SSE2;
+    }
+
+    return NVG_CPU_SIMD_SCALAR;
+#else
+    return NVG_CPU_SIMD_SCALAR;
+#endif
+}
+
+/* MARK: scalar */
+
+static void nkCpu_CoverageScalar(const nkCpuFrag_t *frag, const nkCpuSpan_t *span, int edgeAntiAlias, int scissorOnly, float *coverage, uint8_t *mask)
+{
+    nkCpu_CoverageFrom(frag, span, edgeAntiAlias, scissorOnly, coverage, mask, 0);
+}
+
+static void nkCpu_GradientScalar(const nkCpuFrag_t *frag, const nkCpuSpan_t *span, const float *coverage, float *rgba)
+{
+    nkCpu_GradientFrom(frag, span, coverage, rgba, 0);
+}
+
+static void nkCpu_SourceOverScalar(const float *rgba, int count, const uint8_t *mask, uint8_t *dst)
+{
+    nkCpu_SourceOverFrom(rgba, count, mask, dst, 0);
+}
+
+/* the scalar loops start at first so vector kernels can finish their tails with them */
+static void nkCpu_CoverageFrom(const nkCpuFrag_t *frag, const nkCpuSpan_t *span, int edgeAntiAlias, int scissorOnly, float *coverage, uint8_t *mask, int first)
+{
+    const float *sm = frag->scissorMat;
+    float py = (float)span->y + 0.5f;
+    float smy0 = sm[2] * py;
+    float smy1 = sm[3] * py;
+
+    for (int i = first; i < span->count; i++)
+    {
+        float px = (float)(span->x + i) + 0.5f;
+        float scx = fabsf(sm[0] * px + smy0 + sm[4]) - frag->scissorExt[0];
+        float scy = fabsf(sm[1] * px + smy1 + sm[5]) - frag->scissorExt[1];
+        float scissor = NK_CPU_CLAMP(0.5f - scx * frag->scissorScale[0], 0.0f, 1.0f) *
+                        NK_CPU_CLAMP(0.5f - scy * frag->scissorScale[1], 0.0f, 1.0f);
+
+        if (edgeAntiAlias)
+        {
+            float t = (float)(span->x + i - span->xRef);
+            float u = span->u + span->du * t;
+            float v = span->v + span->dv * t;
+            float strokeAlpha = NK_CPU_MIN(1.0f, (1.0f - fabsf(u * 2.0f - 1.0f)) * frag->strokeMult) * NK_CPU_MIN(1.0f, v);
+
+            if (strokeAlpha < frag->strokeThr)
+            {
+                mask[i] = 0;
+            }
+
+            if (!scissorOnly)
+            {
+                scissor = scissor * strokeAlpha;
+            }
+        }
+
+        coverage[i] = scissor;
+    }
+}
+
+static void nkCpu_GradientFrom(const nkCpuFrag_t *frag, const nkCpuSpan_t *span, const float *coverage, float *rgba, int first)
+{
+    const float *pm = frag->paintMat;
+    const NVGcolor *inner = &frag->innerCol;
+    const NVGcolor *outer = &frag->outerCol;
+    float py = (float)span->y + 0.5f;
+    float pmy0 = pm[2] * py;
+    float pmy1 = pm[3] * py;
+    float extX = frag->extent[0] - frag->radius;
+    float extY = frag->extent[1] - frag->radius;
+    float halfFeather = frag->feather * 0.5f;
+
+    for (int i = first; i < span->count; i++)
+    {
+        float px = (float)(span->x + i) + 0.5f;
+        float dx = fabsf(pm[0] * px + pmy0 + pm[4]) - extX;
+        float dy = fabsf(pm[1] * px + pmy1 + pm[5]) - extY;
+        float ox = NK_CPU_MAX(dx, 0.0f);
+        float oy = NK_CPU_MAX(dy, 0.0f);
+        float distance = NK_CPU_MIN(NK_CPU_MAX(dx, dy), 0.0f) + sqrtf(ox * ox + oy * oy) - frag->radius;
+        float d = NK_CPU_CLAMP((distance + halfFeather) / frag->feather, 0.0f, 1.0f);
+        float alpha = coverage[i];
+
+        rgba[i] = (inner->r + (outer->r - inner->r) * d) * alpha;
+        rgba[i + NK_CPU_SPAN_MAX] = (inner->g + (outer->g - inner->g) * d) * alpha;
+        rgba[i + NK_CPU_SPAN_MAX * 2] = (inner->b + (outer->b - inner->b) * d) * alpha;
+        rgba[i + NK_CPU_SPAN_MAX * 3] = (inner->a + (outer->a - inner->a) * d) * alpha;
+    }
+}
+
+static void nkCpu_SourceOverFrom(const float *rgba, int count, const uint8_t *mask, uint8_t *dst, int first)
+{
+    for (int i = first; i < count; i++)
+    {
+        if (!mask[i])
+        {
+            continue;
+        }
+
+        uint8_t *pixel = dst + i * 4;
+        float inverse = 1.0f - NK_CPU_CLAMP(rgba[i + NK_CPU_SPAN_MAX * 3], 0.0f, 1.0f);
+
+        for (int c = 0; c < 4; c++)
+        {
+            float s = NK_CPU_CLAMP(rgba[i + NK_CPU_SPAN_MAX * c], 0.0f, 1.0f);
+            float d = (float)pixel[c] * (1.0f / 255.0f);
+            pixel[c] = (uint8_t)(NK_CPU_CLAMP(s + d * inverse, 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+    }
+}
+
+#if NK_CPU_X86
+
+/* MARK: SSE2, 4 pixels per step */
+
+NK_CPU_TARGET_SSE2 static void nkCpu_CoverageSSE2(const nkCpuFrag_t *frag, const nkCpuSpan_t *span, int edgeAntiAlias, int scissorOnly, float *coverage, uint8_t *mask)
+{
+    const float *sm = frag->scissorMat;
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128i lanes = _mm_set_epi32(3, 2, 1, 0);
+    float py = (float)span->y + 0.5f;
+    __m128 sm0 = _mm_set1_ps(sm[0]), sm1 = _mm_set1_ps(sm[1]);
+    __m128 smy0 = _mm_set1_ps(sm[2] * py), smy1 = _mm_set1_ps(sm[3] * py);
+    __m128 sm4 = _mm_set1_ps(sm[4]), sm5 = _mm_set1_ps(sm[5]);
+    __m128 extX = _mm_set1_ps(frag->scissorExt[0]), extY = _mm_set1_ps(frag->scissorExt[1]);
+    __m128 scaleX = _mm_set1_ps(frag->scissorScale[0]), scaleY = _mm_set1_ps(frag->scissorScale[1]);
+    __m128 u0 = _mm_set1_ps(span->u), du = _mm_set1_ps(span->du);
+    __m128 v0 = _mm_set1_ps(span->v), dv = _mm_set1_ps(span->dv);
+    __m128 strokeMult = _mm_set1_ps(frag->strokeMult), strokeThr = _mm_set1_ps(frag->strokeThr);
+    int i = 0;
+
+    for (; i + 4 <= span->count; i += 4)
+    {
+        __m128 px = _mm_add_ps(_mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(span->x + i), lanes)), half);
+        __m128 scx = _mm_sub_ps(_mm_and_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sm0, px), smy0), sm4), absMask), extX);
+        __m128 scy = _mm_sub_ps(_mm_and_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sm1, px), smy1), sm5), absMask), extY);
+        __m128 scissor = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_sub_ps(half, _mm_mul_ps(scx, scaleX)), zero), one),
+                                    _mm_min_ps(_mm_max_ps(_mm_sub_ps(half, _mm_mul_ps(scy, scaleY)), zero), one));
+
+        if (edgeAntiAlias)
+        {
+            __m128 t = _mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(span->x + i - span->xRef), lanes));
+            __m128 u = _mm_add_ps(u0, _mm_mul_ps(du, t));
+            __m128 v = _mm_add_ps(v0, _mm_mul_ps(dv, t));
+            __m128 ramp = _mm_mul_ps(_mm_sub_ps(one, _mm_and_ps(_mm_sub_ps(_mm_mul_ps(u, two), one), absMask)), strokeMult);
+            __m128 strokeAlpha = _mm_mul_ps(_mm_min_ps(one, ramp), _mm_min_ps(one, v));
+            int discard = _mm_movemask_ps(_mm_cmplt_ps(strokeAlpha, strokeThr));
+
+            for (int lane = 0; discard != 0; lane++, discard >>= 1)
+            {
+                if (discard & 1)
+                {
+                    mask[i + lane] = 0;
+                }
+            }
+
+            if (!scissorOnly)
+            {
+                scissor = _mm_mul_ps(scissor, strokeAlpha);
+            }
+        }
+
+        _mm_storeu_ps(coverage + i, scissor);
+    }
+
+    nkCpu_CoverageFrom(frag, span, edgeAntiAlias, scissorOnly, coverage, mask, i);
+}
+
+NK_CPU_TARGET_SSE2 static void nkCpu_GradientSSE2(const nkCpuFrag_t *frag, const nkCpuSpan_t *span, const float *coverage, float *rgba)
+{
+    const float *pm = frag->paintMat;
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128i lanes = _mm_set_epi32(3, 2, 1, 0);
+    float py = (float)span->y + 0.5f;
+    __m128 pm0 = _mm_set1_ps(pm[0]), pm1 = _mm_set1_ps(pm[1]);
+    __m128 pmy0 = _mm_set1_ps(pm[2] * py), pmy1 = _mm_set1_ps(pm[3] * py);
+    __m128 pm4 = _mm_set1_ps(pm[4]), pm5 = _mm_set1_ps(pm[5]);
+    __m128 extX = _mm_set1_ps(frag->extent[0] - frag->radius), extY = _mm_set1_ps(frag->extent[1] - frag->radius);
+    __m128 radius = _mm_set1_ps(frag->radius);
+    __m128 halfFeather = _mm_set1_ps(frag->feather * 0.5f), feather = _mm_set1_ps(frag->feather);
+    __m128 inner[4] = { _mm_set1_ps(frag->innerCol.r), _mm_set1_ps(frag->innerCol.g), _mm_set1_ps(frag->innerCol.b), _mm_set1_ps(frag->innerCol.a) };
+    __m128 delta[4] = {
+        _mm_set1_ps(frag->outerCol.r - frag->innerCol.r), _mm_set1_ps(frag->outerCol.g - frag->innerCol.g),
+        _mm_set1_ps(frag->outerCol.b - frag->innerCol.b), _mm_set1_ps(frag->outerCol.a - frag->innerCol.a)
+    };
+    int i = 0;
+
+    for (; i + 4 <= span->count; i += 4)
+    {
+        __m128 px = _mm_add_ps(_mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(span->x + i), lanes)), half);
+        __m128 dx = _mm_sub_ps(_mm_and_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(pm0, px), pmy0), pm4), absMask), extX);
+        __m128 dy = _mm_sub_ps(_mm_and_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(pm1, px), pmy1), pm5), absMask), extY);
+        __m128 ox = _mm_max_ps(dx, zero);
+        __m128 oy = _mm_max_ps(dy, zero);
+        __m128 outside = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(ox, ox), _mm_mul_ps(oy, oy)));
+        __m128 distance = _mm_sub_ps(_mm_add_ps(_mm_min_ps(_mm_max_ps(dx, dy), zero), outside), radius);
+        __m128 d = _mm_min_ps(_mm_max_ps(_mm_div_ps(_mm_add_ps(distance, halfFeather), feather), zero), one);
+        __m128 alpha = _mm_loadu_ps(coverage + i);
+
+        for (int c = 0; c < 4; c++)
+        {
+            _mm_storeu_ps(rgba + i + NK_CPU_SPAN_MAX * c, _mm_mul_ps(_mm_add_ps(inner[c], _mm_mul_ps(delta[c], d)), alpha));
+        }
+    }
+
+    nkCpu_GradientFrom(frag, span, coverage, rgba, i);
+}
+
+NK_CPU_TARGET_SSE2 static void nkCpu_SourceOverSSE2(const float *rgba, int count, const uint8_t *mask, uint8_t *dst)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 scale = _mm_set1_ps(255.0f);
+    const __m128 inverseScale = _mm_set1_ps(1.0f / 255.0f);
+    const __m128i byteMask = _mm_set1_epi32(0xff);
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32_t lanes;
+        memcpy(&lanes, mask + i, 4);
+
+        if (lanes == 0)
+        {
+            continue;
+        }
+
+        __m128i writeMask = _mm_cmpgt_epi32(_mm_set_epi32(mask[i + 3], mask[i + 2], mask[i + 1], mask[i]), _mm_setzero_si128());
+        __m128i pixels = _mm_loadu_si128((const __m128i*)(dst + i * 4));
+        __m128 inverse = _mm_sub_ps(one, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(rgba + i + NK_CPU_SPAN_MAX * 3), zero), one));
+        __m128i result = _mm_setzero_si128();
+
+        for (int c = 0; c < 4; c++)
+        {
+            __m128 s = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(rgba + i + NK_CPU_SPAN_MAX * c), zero), one);
+            __m128 d = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srl_epi32(pixels, _mm_cvtsi32_si128(c * 8)), byteMask)), inverseScale);
+            __m128 out = _mm_add_ps(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_add_ps(s, _mm_mul_ps(d, inverse)), zero), one), scale), half);
+            result = _mm_or_si128(result, _mm_sll_epi32(_mm_cvttps_epi32(out), _mm_cvtsi32_si128(c * 8)));
+        }
+
+        result = _mm_or_si128(_mm_and_si128(writeMask, result), _mm_andnot_si128(writeMask, pixels));
+        _mm_storeu_si128((__m128i*)(dst + i * 4), result);
+    }
+
+    nkCpu_SourceOverFrom(rgba, count, mask, dst, i);
+}
+
+/* MARK: AVX2, 8 pixels per step */
+
+NK_CPU_TARGET_AVX2 static void nkCpu_CoverageAVX2(const nkCpuFrag_t *frag, const nkCpuSpan_t *span, int edgeAntiAlias, int scissorOnly, float *coverage, uint8_t *mask)
+{
+    const float *sm = frag->scissorMat;
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    const __m256i lanes = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    float py = (float)span->y + 0.5f;
+    __m256 sm0 = _mm256_set1_ps(sm[0]), sm1 = _mm256_set1_ps(sm[1]);
+    __m256 smy0 = _mm256_set1_ps(sm[2] * py), smy1 = _mm256_set1_ps(sm[3] * py);
+    __m256 sm4 = _mm256_set1_ps(sm[4]), sm5 = _mm256_set1_ps(sm[5]);
+    __m256 extX = _mm256_set1_ps(frag->scissorExt[0]), extY = _mm256_set1_ps(frag->scissorExt[1]);
+    __m256 scaleX = _mm256_set1_ps(frag->scissorScale[0]), scaleY = _mm256_set1_ps(frag->scissorScale[1]);
+    __m256 u0 = _mm256_set1_ps(span->u), du = _mm256_set1_ps(span->du);
+    __m256 v0 = _mm256_set1_ps(span->v), dv = _mm256_set1_ps(span->dv);
+    __m256 strokeMult = _mm256_set1_ps(frag->strokeMult), strokeThr = _mm256_set1_ps(frag->strokeThr);
+    int i = 0;
+
+    for (; i + 8 <= span->count; i += 8)
+    {
+        __m256 px = _mm256_add_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_set1_epi32(span->x + i), lanes)), half);
+        __m256 scx = _mm256_sub_ps(_mm256_and_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sm0, px), smy0), sm4), absMask), extX);
+        __m256 scy = _mm256_sub_ps(_mm256_and_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sm1, px), smy1), sm5), absMask), extY);
+        __m256 scissor = _mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(_mm256_sub_ps(half, _mm256_mul_ps(scx, scaleX)), zero), one),
+                                       _mm256_min_ps(_mm256_max_ps(_mm256_sub_ps(half, _mm256_mul_ps(scy, scaleY)), zero), one));
+
+        if (edgeAntiAlias)
+        {
+            __m256 t = _mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_set1_epi32(span->x + i - span->xRef), lanes));
+            __m256 u = _mm256_add_ps(u0, _mm256_mul_ps(du, t));
+            __m256 v = _mm256_add_ps(v0, _mm256_mul_ps(dv, t));
+            __m256 ramp = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_and_ps(_mm256_sub_ps(_mm256_mul_ps(u, two), one), absMask)), strokeMult);
+            __m256 strokeAlpha = _mm256_mul_ps(_mm256_min_ps(one, ramp), _mm256_min_ps(one, v));
+            int discard = _mm256_movemask_ps(_mm256_cmp_ps(strokeAlpha, strokeThr, _CMP_LT_OQ));
+
+            for (int lane = 0; discard != 0; lane++, discard >>= 1)
+            {
+                if (discard & 1)
+                {
+                    mask[i + lane] = 0;
+                }
+            }
+
+            if (!scissorOnly)
+            {
+                scissor = _mm256_mul_ps(scissor, strokeAlpha);
+            }
+        }
+
+        _mm256_storeu_ps(coverage + i, scissor);
+    }
+
+    /* the tail runs legacy SSE code, leave the upper halves clean for it */
+    _mm256_zeroupper();
+    nkCpu_CoverageFrom(frag, span, edgeAntiAlias, scissorOnly, coverage, mask, i);
+}
+
+NK_CPU_TARGET_AVX2 static void nkCpu_GradientAVX2(const nkCpuFrag_t *frag, const nkCpuSpan_t *span, const float *coverage, float *rgba)
+{
+    const float *pm = frag->paintMat;
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    const __m256i lanes = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    float py = (float)span->y + 0.5f;
+    __m256 pm0 = _mm256_set1_ps(pm[0]), pm1 = _mm256_set1_ps(pm[1]);
+    __m256 pmy0 = _mm256_set1_ps(pm[2] * py), pmy1 = _mm256_set1_ps(pm[3] * py);
+    __m256 pm4 = _mm256_set1_ps(pm[4]), pm5 = _mm256_set1_ps(pm[5]);
+    __m256 extX = _mm256_set1_ps(frag->extent[0] - frag->radius), extY = _mm256_set1_ps(frag->extent[1] - frag->radius);
+    __m256 radius = _mm256_set1_ps(frag->radius);
+    __m256 halfFeather = _mm256_set1_ps(frag->feather * 0.5f), feather = _mm256_set1_ps(frag->feather);
+    __m256 inner[4] = { _mm256_set1_ps(frag->innerCol.r), _mm256_set1_ps(frag->innerCol.g), _mm256_set1_ps(frag->innerCol.b), _mm256_set1_ps(frag->innerCol.a) };
+    __m256 delta[4] = {
+        _mm256_set1_ps(frag->outerCol.r - frag->innerCol.r), _mm256_set1_ps(frag->outerCol.g - frag->innerCol.g),
+        _mm256_set1_ps(frag->outerCol.b - frag->innerCol.b), _mm256_set1_ps(frag->outerCol.a - frag->innerCol.a)
+    };
+    int i = 0;
+
+    for (; i + 8 <= span->count; i += 8)
+    {
+        __m256 px = _mm256_add_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_set1_epi32(span->x + i), lanes)), half);
+        __m256 dx = _mm256_sub_ps(_mm256_and_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(pm0, px), pmy0), pm4), absMask), extX);
+        __m256 dy = _mm256_sub_ps(_mm256_and_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(pm1, px), pmy1), pm5), absMask), extY);
+        __m256 ox = _mm256_max_ps(dx, zero);
+        __m256 oy = _mm256_max_ps(dy, zero);
+        __m256 outside = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(ox, ox), _mm256_mul_ps(oy, oy)));
+        __m256 distance = _mm256_sub_ps(_mm256_add_ps(_mm256_min_ps(_mm256_max_ps(dx, dy), zero), outside), radius);
+        __m256 d = _mm256_min_ps(_mm256_max_ps(_mm256_div_ps(_mm256_add_ps(distance, halfFeather), feather), zero), one);
+        __m256 alpha = _mm256_loadu_ps(coverage + i);
+
+        for (int c = 0; c < 4; c++)
+        {
+            _mm256_storeu_ps(rgba + i + NK_CPU_SPAN_MAX * c, _mm256_mul_ps(_mm256_add_ps(inner[c], _mm256_mul_ps(delta[c], d)), alpha));
+        }
+    }
+
+    /* the tail runs legacy SSE code, leave the upper halves clean for it */
+    _mm256_zeroupper();
+    nkCpu_GradientFrom(frag, span, coverage, rgba, i);
+}
+
+NK_CPU_TARGET_AVX2 static void nkCpu_SourceOverAVX2(const float *rgba, int count, const uint8_t *mask, uint8_t *dst)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 scale = _mm256_set1_ps(255.0f);
+    const __m256 inverseScale = _mm256_set1_ps(1.0f / 255.0f);
+    const __m256i byteMask = _mm256_set1_epi32(0xff);
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        uint64_t lanes;
+        memcpy(&lanes, mask + i, 8);
+
+        if (lanes == 0)
+        {
+            continue;
+        }
+
+        __m128i maskBytes = _mm_loadl_epi64((const __m128i*)(mask + i));
+        __m256i writeMask = _mm256_cmpgt_epi32(_mm256_cvtepu8_epi32(maskBytes), _mm256_setzero_si256());
+        __m256i pixels = _mm256_loadu_si256((const __m256i*)(dst + i * 4));
+        __m256 inverse = _mm256_sub_ps(one, _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(rgba + i + NK_CPU_SPAN_MAX * 3), zero), one));
+        __m256i result = _mm256_setzero_si256();
+
+        for (int c = 0; c < 4; c++)
+        {
+            __m256 s = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(rgba + i + NK_CPU_SPAN_MAX * c), zero), one);
+            __m256 d = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srl_epi32(pixels, _mm_cvtsi32_si128(c * 8)), byteMask)), inverseScale);
+            __m256 out = _mm256_add_ps(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(_mm256_add_ps(s, _mm256_mul_ps(d, inverse)), zero), one), scale), half);
+            result = _mm256_or_si256(result, _mm256_sll_epi32(_mm256_cvttps_epi32(out), _mm_cvtsi32_si128(c * 8)));
+        }
+
+        result = _mm256_blendv_epi8(pixels, result, writeMask);
+        _mm256_storeu_si256((__m256i*)(dst + i * 4), result);
+    }
+
+    /* the tail runs legacy SSE code, leave the upper halves clean for it */
+    _mm256_zeroupper();
+    nkCpu_SourceOverFrom(rgba, count, mask, dst, i);
+}
+
+#endif /* NK_CPU_X86 */
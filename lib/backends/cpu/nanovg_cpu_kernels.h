@@ -0,0 +1,106 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nanovg_cpu_kernels.h
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-05 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Span kernels of the software NanoVG renderer
+**
+***************************************************************/
+
+#ifndef NANOVG_CPU_KERNELS_H
+#define NANOVG_CPU_KERNELS_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <extern/nanovg/nanovg.h>
+
+#include <stdint.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* pixels shaded per kernel call; longer spans are split */
+#define NK_CPU_SPAN_MAX (64)
+
+/* argument order matches _mm_min_ps/_mm_max_ps so scalar and vector paths agree bit for bit */
+#define NK_CPU_MIN(a, b) ((a) < (b) ? (a) : (b))
+#define NK_CPU_MAX(a, b) ((a) > (b) ? (a) : (b))
+#define NK_CPU_CLAMP(v, lo, hi) NK_CPU_MIN(NK_CPU_MAX((v), (lo)), (hi))
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* converted paint, the uniforms of the nanovg_gl.h fragment shader */
+typedef struct
+{
+    float scissorMat[6];
+    float paintMat[6];
+    NVGcolor innerCol; /* premultiplied */
+    NVGcolor outerCol; /* premultiplied */
+    float scissorExt[2];
+    float scissorScale[2];
+    float extent[2];
+    float radius;
+    float feather;
+    float strokeMult;
+    float strokeThr;
+    int texType;
+    int type;
+} nkCpuFrag_t;
+
+/* run of covered pixels on one row. u and v are linear in x around xRef, which is fixed
+** per triangle so that splitting a span never changes a pixel's value. */
+typedef struct
+{
+    int x;
+    int y;
+    int count;
+    int xRef;
+    float u;
+    float v;
+    float du;
+    float dv;
+} nkCpuSpan_t;
+
+/* scissor mask, times the stroke mask unless scissorOnly. clears mask where the stroke
+** threshold discards. */
+typedef void (*nkCpuCoverageKernel_t)(const nkCpuFrag_t *frag, const nkCpuSpan_t *span, int edgeAntiAlias, int scissorOnly, float *coverage, uint8_t *mask);
+
+/* box gradient times coverage, planar premultiplied rgba with NK_CPU_SPAN_MAX per plane */
+typedef void (*nkCpuGradientKernel_t)(const nkCpuFrag_t *frag, const nkCpuSpan_t *span, const float *coverage, float *rgba);
+
+/* premultiplied source-over of planar rgba onto RGBA8 where mask is set */
+typedef void (*nkCpuSourceOverKernel_t)(const float *rgba, int count, const uint8_t *mask, uint8_t *dst);
+
+typedef struct
+{
+    int level; /* NVGcpuSimd */
+    nkCpuCoverageKernel_t coverage;
+    nkCpuGradientKernel_t gradient;
+    nkCpuSourceOverKernel_t sourceOver;
+} nkCpuKernels_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* widest kernels the CPU supports, up to level */
+const nkCpuKernels_t *nkCpu_SelectKernels(int level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NANOVG_CPU_KERNELS_H */
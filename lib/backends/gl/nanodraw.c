@@ -0,0 +1,1557 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nanodraw.c
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-05 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Drawing API (batched OpenGL backend)
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <nanodraw.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/* nanovg.c compiles stb_image on the other backend */
+#define STB_IMAGE_IMPLEMENTATION
+#include <extern/stb/stb_image.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define NK_DRAW_MAX_VERTICES        (VERTEX_BUFFER_SIZE / sizeof(nkDrawVertex_t))
+
+#define NK_DRAW_PRIMITIVE_SHAPE     (0U)
+#define NK_DRAW_PRIMITIVE_TEXT      (1U)
+#define NK_DRAW_PRIMITIVE_SDF       (2U)
+#define NK_DRAW_PRIMITIVE_IMAGE     (3U)
+#define NK_DRAW_PRIMITIVE_MASK      (0xFFU)
+#define NK_DRAW_SLOT_SHIFT          (8U)
+
+#define NK_DRAW_DEFAULT_FONT_SIZE   (14.0f)
+#define NK_DRAW_MIN_ATLAS_SIZE      (128U)
+#define NK_DRAW_MAX_ATLAS_SIZE      (4096U)
+
+#if __EMSCRIPTEN__
+    #define NK_DRAW_VERTEX_SHADER        shaders_gles_general_vert
+    #define NK_DRAW_VERTEX_SHADER_SIZE   shaders_gles_general_vert_size
+    #define NK_DRAW_FRAGMENT_SHADER      shaders_gles_general_frag
+    #define NK_DRAW_FRAGMENT_SHADER_SIZE shaders_gles_general_frag_size
+#else
+    #define NK_DRAW_VERTEX_SHADER        shaders_opengl_general_vert
+    #define NK_DRAW_VERTEX_SHADER_SIZE   shaders_opengl_general_vert_size
+    #define NK_DRAW_FRAGMENT_SHADER      shaders_opengl_general_frag
+    #define NK_DRAW_FRAGMENT_SHADER_SIZE shaders_opengl_general_frag_size
+#endif
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* span of recorded vertices sharing one texture and clip */
+typedef struct
+{
+    GLuint texture;
+    nkRect_t clipRect;
+    bool clipEnabled;
+    size_t vertexOffset;
+    size_t vertexCount;
+} nkDrawRun_t;
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+extern const uint8_t NKFonts_fonts_Roboto_Regular_ttf[];
+extern const size_t NKFonts_fonts_Roboto_Regular_ttf_size;
+
+/* generated by embed_resources */
+extern const unsigned char NK_DRAW_VERTEX_SHADER[];
+extern const unsigned NK_DRAW_VERTEX_SHADER_SIZE;
+extern const unsigned char NK_DRAW_FRAGMENT_SHADER[];
+extern const unsigned NK_DRAW_FRAGMENT_SHADER_SIZE;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static GLuint nkDraw_CompileShader(GLenum type, const unsigned char *source, unsigned length);
+static nkDrawState_t *nkDraw_CurrentState(nkDrawContext_t *context);
+static void nkDraw_Flush(nkDrawContext_t *context);
+static void nkDraw_ApplyClip(nkDrawContext_t *context, bool clipEnabled, nkRect_t clipRect);
+static nkDrawVertex_t *nkDraw_AllocVertices(nkDrawContext_t *context, size_t count, GLuint texture, uint32_t *slotBits);
+static nkDrawVertex_t *nkDraw_AllocVerticesClipped(nkDrawContext_t *context, size_t count, GLuint texture, bool clipEnabled, nkRect_t clipRect, uint32_t *slotBits);
+
+static bool nkDraw_ListReserve(void **buffer, size_t *capacity, size_t required, size_t elementSize);
+static nkDrawVertex_t *nkDraw_ListAllocVertices(nkDrawList_t *list, size_t count, GLuint texture, bool clipEnabled, nkRect_t clipRect);
+
+static nkDrawPaint_t nkDraw_SolidPaint(nkColor_t color);
+static nkDrawPaint_t nkDraw_GradientPaint(nkColor_t colorStart, nkColor_t colorEnd, float angle, float x, float y, float w, float h);
+static void nkDraw_SetVertex(nkDrawVertex_t *vertex, uint32_t type, float x, float y, nkColor_t color, float u, float v);
+static void nkDraw_SetPaintVertex(nkDrawVertex_t *vertex, uint32_t type, float x, float y, const nkDrawPaint_t *paint, float u, float v);
+
+static nkDrawFontFace_t *nkDraw_FindFontFace(nkDrawContext_t *context, const char *name);
+static void nkDraw_SdfRect(nkDrawContext_t *context, const nkDrawPaint_t *paint, float x, float y, float w, float h, const float radii[4], float strokeWidth);
+
+static void nkDraw_BeginRedraw(nkDrawContext_t *context, float width, float height, bool intact);
+static bool nkDraw_IsCulled(nkDrawContext_t *context, float x, float y, float w, float h, float outset);
+
+static double nkDraw_Milliseconds(void);
+static double nkDraw_GeometryStart(nkDrawContext_t *context);
+static void nkDraw_GeometryEnd(nkDrawContext_t *context, double start, uint32_t drawCalls);
+
+static uint32_t nkDraw_CreateImageTexture(void *user, uint32_t width, uint32_t height, const uint8_t *pixels);
+static uint32_t nkDraw_CreateImageLevels(void *user, uint32_t width, uint32_t height, uint32_t levels);
+static void nkDraw_UpdateImageLevel(void *user, uint32_t texture, uint32_t level, uint32_t width, uint32_t height, const uint8_t *pixels);
+static void nkDraw_UpdateImageRegion(void *user, uint32_t texture, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const uint8_t *page, uint32_t pageSize);
+static void nkDraw_DeleteImageTexture(void *user, uint32_t texture);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool nkDraw_CreateContext(nkDrawContext_t *context)
+{
+    return nkDraw_CreateContextWithOptions(context, NULL);
+}
+
+bool nkDraw_CreateContextWithOptions(nkDrawContext_t *context, const nkDrawContextOptions_t *options)
+{
+    const nkImageTextures_t imageTextures = {
+        .user = context,
+        .createTexture = nkDraw_CreateImageTexture,
+        .createLevels = nkDraw_CreateImageLevels,
+        .updateLevel = nkDraw_UpdateImageLevel,
+        .updateRegion = nkDraw_UpdateImageRegion,
+        .deleteTexture = nkDraw_DeleteImageTexture
+    };
+
+    memset(context, 0, sizeof(*context));
+
+    if (options && options->target != NK_DRAW_TARGET_GL)
+    {
+        fprintf(stderr, "ERROR: CPU targets need the nanovg backend (NANODRAW_BACKEND=nanovg).\n");
+        return false;
+    }
+
+    nkTextCache_Init(&context->textCache, NK_DRAW_MEASURE_CACHE_SIZE);
+
+    /* geometry lives in fixed buffers, a caller allocator is only reset so it sees frames */
+    if (options && options->allocator)
+    {
+        context->frameAllocator = *options->allocator;
+    }
+
+    context->partialRedraw = options && options->partialRedraw;
+    context->sdfText = options && options->sdfText;
+    context->glyphPool = NULL;
+    context->glyphBatch = false;
+    nkImageTable_Init(&context->images, &imageTextures, NK_DRAW_IMAGE_THREADS, NK_DRAW_IMAGE_ATLAS_SIZE,
+        options && options->separateImages ? 0 : (options && options->imageAtlasLimit ? options->imageAtlasLimit : NK_DRAW_IMAGE_ATLAS_LIMIT),
+        options && options->imageMipmaps != NK_DRAW_MIPMAPS_OFF, options && options->imageMipmaps == NK_DRAW_MIPMAPS_FIT);
+
+    GLuint vertexShader = nkDraw_CompileShader(GL_VERTEX_SHADER, NK_DRAW_VERTEX_SHADER, NK_DRAW_VERTEX_SHADER_SIZE);
+    GLuint fragmentShader = nkDraw_CompileShader(GL_FRAGMENT_SHADER, NK_DRAW_FRAGMENT_SHADER, NK_DRAW_FRAGMENT_SHADER_SIZE);
+
+    if (!vertexShader || !fragmentShader)
+    {
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return false;
+    }
+
+    context->shaderProgram = glCreateProgram();
+    glAttachShader(context->shaderProgram, vertexShader);
+    glAttachShader(context->shaderProgram, fragmentShader);
+    glLinkProgram(context->shaderProgram);
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(context->shaderProgram, GL_LINK_STATUS, &linked);
+
+    if (linked != GL_TRUE)
+    {
+        char log[512] = {0};
+        glGetProgramInfoLog(context->shaderProgram, sizeof(log) - 1, NULL, log);
+        fprintf(stderr, "ERROR: Failed to link NanoDraw shader program.\n%s\n", log);
+
+        glDeleteProgram(context->shaderProgram);
+        context->shaderProgram = 0;
+        return false;
+    }
+
+    context->projectionLocation = glGetUniformLocation(context->shaderProgram, "uProjection");
+
+    /* every texture slot gets its own unit once, the batch only rebinds units */
+    GLint units[TEXTURE_ATTACHMENTS];
+
+    for (size_t i = 0; i < TEXTURE_ATTACHMENTS; i++)
+    {
+        units[i] = (GLint)i;
+    }
+
+    glUseProgram(context->shaderProgram);
+    glUniform1iv(glGetUniformLocation(context->shaderProgram, "uTextures"), TEXTURE_ATTACHMENTS, units);
+    glUseProgram(0);
+
+    glGenVertexArrays(1, &context->vertexArray);
+    glGenBuffers(1, &context->vertexBuffer);
+
+    glBindVertexArray(context->vertexArray);
+    glBindBuffer(GL_ARRAY_BUFFER, context->vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, VERTEX_BUFFER_SIZE, NULL, GL_STREAM_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribIPointer(0, 1, GL_UNSIGNED_INT, sizeof(nkDrawVertex_t), (const void*)offsetof(nkDrawVertex_t, type));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(nkDrawVertex_t), (const void*)offsetof(nkDrawVertex_t, x));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(nkDrawVertex_t), (const void*)offsetof(nkDrawVertex_t, r));
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(nkDrawVertex_t), (const void*)offsetof(nkDrawVertex_t, u));
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(nkDrawVertex_t), (const void*)offsetof(nkDrawVertex_t, halfWidth));
+    glEnableVertexAttribArray(5);
+    glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(nkDrawVertex_t), (const void*)offsetof(nkDrawVertex_t, radii));
+    glEnableVertexAttribArray(6);
+    glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(nkDrawVertex_t), (const void*)offsetof(nkDrawVertex_t, endR));
+    glEnableVertexAttribArray(7);
+    glVertexAttribPointer(7, 1, GL_FLOAT, GL_FALSE, sizeof(nkDrawVertex_t), (const void*)offsetof(nkDrawVertex_t, t));
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    context->vertices = (nkDrawVertex_t*)malloc(VERTEX_BUFFER_SIZE);
+
+    if (!context->vertices)
+    {
+        fprintf(stderr, "ERROR: Failed to allocate NanoDraw vertex buffer.\n");
+        return false;
+    }
+
+    if (nkDraw_RegisterFontFace(context, "sans", NKFonts_fonts_Roboto_Regular_ttf, NKFonts_fonts_Roboto_Regular_ttf_size) == -1 ||
+        !nkDraw_LoadFont(context, &context->defaultFont, "sans", NK_DRAW_DEFAULT_FONT_SIZE))
+    {
+        fprintf(stderr, "ERROR: Failed to load default font into NanoDraw context.\n");
+    }
+
+    printf("NanoDraw context created successfully.\n");
+
+    return true;
+}
+
+void nkDraw_DestroyContext(nkDrawContext_t *context)
+{
+    nkImageTable_Destroy(&context->images);
+
+    if (context->defaultFont.atlasTexture)
+    {
+        glDeleteTextures(1, &context->defaultFont.atlasTexture);
+        context->defaultFont.atlasTexture = 0;
+    }
+
+    if (context->vertexBuffer)
+    {
+        glDeleteBuffers(1, &context->vertexBuffer);
+    }
+
+    if (context->vertexArray)
+    {
+        glDeleteVertexArrays(1, &context->vertexArray);
+    }
+
+    if (context->shaderProgram)
+    {
+        glDeleteProgram(context->shaderProgram);
+    }
+
+    context->vertexBuffer = 0;
+    context->vertexArray = 0;
+    context->shaderProgram = 0;
+
+    nkRenderTarget_Destroy(&context->renderTarget);
+
+    for (size_t i = 0; i < context->fontFaceCount; i++)
+    {
+        nkFontSource_Release(context->fontFaces[i].source);
+        context->fontFaces[i].source = NULL;
+    }
+
+    context->fontFaceCount = 0;
+
+    nkTextCache_Destroy(&context->textCache);
+
+    free(context->vertices);
+    context->vertices = NULL;
+    context->vertexCount = 0;
+    context->textureCount = 0;
+}
+
+void nkDraw_Begin(nkDrawContext_t *context, float width, float height)
+{
+    nkDrawState_t *state = &context->states[0];
+
+    context->viewWidth = width;
+    context->viewHeight = height;
+    context->vertexCount = 0;
+    context->textureCount = 0;
+    memset(&context->frameCounters, 0, sizeof(context->frameCounters));
+
+    /* images decoded since the last frame */
+    nkImageTable_Update(&context->images, NK_DRAW_IMAGE_UPLOAD_BUDGET);
+
+    if (context->frameAllocator.reset)
+    {
+        context->frameAllocator.reset(context->frameAllocator.user);
+    }
+
+    memset(state, 0, sizeof(*state));
+    state->fill = nkDraw_SolidPaint(NK_COLOR_WHITE);
+    state->stroke = nkDraw_SolidPaint(NK_COLOR_BLACK);
+    state->strokeWidth = 1.0f;
+    context->stateCount = 1;
+
+    context->appliedClipEnabled = false;
+    glDisable(GL_SCISSOR_TEST);
+
+    if (context->partialRedraw)
+    {
+        bool intact = nkRenderTarget_Begin(&context->renderTarget, (int)ceilf(width), (int)ceilf(height));
+        nkDraw_BeginRedraw(context, width, height, intact);
+    }
+
+    /* column major orthographic projection, origin top left */
+    const float projection[16] = {
+        2.0f / width, 0.0f, 0.0f, 0.0f,
+        0.0f, -2.0f / height, 0.0f, 0.0f,
+        0.0f, 0.0f, -1.0f, 0.0f,
+        -1.0f, 1.0f, 0.0f, 1.0f
+    };
+
+    glUseProgram(context->shaderProgram);
+    glUniformMatrix4fv(context->projectionLocation, 1, GL_FALSE, projection);
+
+    glEnable(GL_BLEND);
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+    glDisable(GL_STENCIL_TEST);
+}
+
+void nkDraw_End(nkDrawContext_t *context)
+{
+    nkDraw_Flush(context);
+
+    glDisable(GL_SCISSOR_TEST);
+    glBindVertexArray(0);
+    glUseProgram(0);
+
+    nkRenderTarget_End(&context->renderTarget);
+
+    context->frameStats = context->frameCounters;
+
+    /* images loaded this frame decode while the next ones are built */
+    nkImageTable_Start(&context->images);
+}
+
+void nkDraw_Clear(nkDrawContext_t *context, nkColor_t color)
+{
+    /* the clear must land behind anything already batched, and the scissor would clip it
+    ** to more than the redraw rect */
+    nkDraw_Flush(context);
+    nkDraw_ApplyClip(context, false, (nkRect_t){ 0 });
+
+    glClearColor(color.r, color.g, color.b, color.a);
+    glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+}
+
+void nkDraw_Invalidate(nkDrawContext_t *context, nkRect_t rect)
+{
+    context->damageRect = nkRect_Union(context->damageRect, rect);
+}
+
+const uint8_t *nkDraw_GetPixels(nkDrawContext_t *context, size_t *width, size_t *height, size_t *stride)
+{
+    (void)context;
+    (void)width;
+    (void)height;
+    (void)stride;
+    return NULL;
+}
+
+void nkDraw_GetFrameStats(nkDrawContext_t *context, nkDrawFrameStats_t *stats)
+{
+    *stats = context->frameStats;
+}
+
+void nkDraw_GetMemoryStats(nkDrawContext_t *context, nkDrawMemoryStats_t *stats)
+{
+    *stats = context->memoryStats;
+    stats->imageTextureBytes = context->images.textureBytes;
+    stats->imageStagedBytes = context->images.stagedBytes;
+}
+
+void nkDraw_GetTextCacheStats(nkDrawContext_t *context, nkDrawTextCacheStats_t *stats)
+{
+    nkTextCacheStats_t text;
+
+    /* glyph quads are not cached here, so the run counts stay zero */
+    memset(stats, 0, sizeof(*stats));
+    nkTextCache_GetStats(&context->textCache, &text);
+
+    stats->hits = text.hits;
+    stats->misses = text.misses;
+    stats->entries = text.entries;
+    stats->capacity = text.capacity;
+}
+
+void nkDraw_GetGlyphAtlasStats(nkDrawContext_t *context, nkDrawGlyphAtlasStats_t *stats)
+{
+    const nkFont_t *font = &context->defaultFont;
+    float covered = 0.0f;
+
+    memset(stats, 0, sizeof(*stats));
+
+    if (!font->atlasTexture)
+    {
+        return;
+    }
+
+    /* baked once, nothing is ever evicted */
+    for (size_t i = 0; i < sizeof(font->bakedCharData) / sizeof(font->bakedCharData[0]); i++)
+    {
+        const stbtt_bakedchar *b = &font->bakedCharData[i];
+        covered += (float)(b->x1 - b->x0) * (float)(b->y1 - b->y0);
+    }
+
+    stats->width = (uint32_t)font->width;
+    stats->height = (uint32_t)font->height;
+    stats->glyphs = (uint32_t)(sizeof(font->bakedCharData) / sizeof(font->bakedCharData[0]));
+    stats->occupancy = covered / ((float)font->width * (float)font->height);
+    stats->rasterizations = stats->glyphs;
+}
+
+void nkDraw_SaveContext(nkDrawContext_t *context)
+{
+    if (context->stateCount >= NK_DRAW_MAX_STATES)
+    {
+        return;
+    }
+
+    context->states[context->stateCount] = context->states[context->stateCount - 1];
+    context->stateCount++;
+}
+
+void nkDraw_RestoreContext(nkDrawContext_t *context)
+{
+    if (context->stateCount > 1)
+    {
+        context->stateCount--;
+    }
+}
+
+void nkDraw_SetClipRect(nkDrawContext_t *context, nkRect_t clipRect)
+{
+    nkDrawState_t *state = nkDraw_CurrentState(context);
+
+    if (state->clipEnabled)
+    {
+        float x0 = fmaxf(state->clipRect.x, clipRect.x);
+        float y0 = fmaxf(state->clipRect.y, clipRect.y);
+        float x1 = fminf(state->clipRect.x + state->clipRect.width, clipRect.x + clipRect.width);
+        float y1 = fminf(state->clipRect.y + state->clipRect.height, clipRect.y + clipRect.height);
+
+        clipRect = (nkRect_t){ .x = x0, .y = y0, .width = fmaxf(0.0f, x1 - x0), .height = fmaxf(0.0f, y1 - y0) };
+    }
+
+    state->clipRect = clipRect;
+    state->clipEnabled = true;
+}
+
+void nkDraw_SetColor(nkDrawContext_t *context, nkVector4_t color)
+{
+    nkDraw_CurrentState(context)->fill = nkDraw_SolidPaint(color);
+}
+
+/* angle in radians, clockwise from vertical */
+void nkDraw_SetColorGradient(nkDrawContext_t *context, nkVector4_t colorStart, nkVector4_t colorEnd, float angle, float x, float y, float w, float h)
+{
+    nkDraw_CurrentState(context)->fill = nkDraw_GradientPaint(colorStart, colorEnd, angle, x, y, w, h);
+}
+
+void nkDraw_SetStrokeColor(nkDrawContext_t *context, nkVector4_t color)
+{
+    nkDraw_CurrentState(context)->stroke = nkDraw_SolidPaint(color);
+}
+
+void nkDraw_SetStrokeColorGradient(nkDrawContext_t *context, nkVector4_t colorStart, nkVector4_t colorEnd, float angle, float x, float y, float w, float h)
+{
+    nkDraw_CurrentState(context)->stroke = nkDraw_GradientPaint(colorStart, colorEnd, angle, x, y, w, h);
+}
+
+void nkDraw_SetStrokeWidth(nkDrawContext_t *context, float width)
+{
+    nkDraw_CurrentState(context)->strokeWidth = width;
+}
+
+void nkDraw_SetGlyphMode(nkDrawContext_t *context, nkDrawGlyphMode_t mode)
+{
+    /* every glyph is baked by nkFont_Load, there is nothing to wait for */
+    nkDraw_CurrentState(context)->glyphMode = mode;
+}
+
+void nkDraw_PrewarmGlyphs(nkDrawContext_t *context, nkFont_t *font, uint32_t first, uint32_t last, const float *sizes, size_t sizeCount)
+{
+    (void)context;
+    (void)font;
+    (void)first;
+    (void)last;
+    (void)sizes;
+    (void)sizeCount;
+}
+
+/* the baked atlases are not kept in a glyph cache */
+bool nkDraw_SaveGlyphCache(nkDrawContext_t *context, const char *path)
+{
+    (void)context;
+    (void)path;
+    return false;
+}
+
+bool nkDraw_LoadGlyphCache(nkDrawContext_t *context, const char *path)
+{
+    (void)context;
+    (void)path;
+    return false;
+}
+
+bool nkDraw_LoadGlyphCacheFromMemory(nkDrawContext_t *context, const uint8_t *data, size_t size)
+{
+    (void)context;
+    (void)data;
+    (void)size;
+    return false;
+}
+
+void nkDraw_Text(nkDrawContext_t* context, nkFont_t* font, const char* text, float x, float y)
+{
+    nkDrawState_t *state = nkDraw_CurrentState(context);
+    const unsigned char *c;
+
+    if (!font)
+    {
+        font = &context->defaultFont;
+    }
+
+    if (!font->atlasTexture || !text)
+    {
+        return;
+    }
+
+    nkRect_t bounds = nkDraw_MeasureText(context, font, text);
+
+    if (nkDraw_IsCulled(context, x + bounds.x, y + bounds.y, bounds.width, bounds.height, 1.0f))
+    {
+        return;
+    }
+
+    double start = nkDraw_GeometryStart(context);
+    uint32_t drawCalls = 1;
+    bool emitted = false;
+
+    for (c = (const unsigned char*)text; *c; c++)
+    {
+        stbtt_aligned_quad q;
+        uint32_t slotBits = 0;
+
+        /* baked atlas covers printable ASCII only */
+        if (*c < 32 || *c > 126)
+        {
+            continue;
+        }
+
+        stbtt_GetBakedQuad(font->bakedCharData, (int)font->width, (int)font->height, *c - 32, &x, &y, &q, 1);
+
+        if (q.x1 <= q.x0 || q.y1 <= q.y0)
+        {
+            continue;
+        }
+
+        nkDrawVertex_t *v = nkDraw_AllocVertices(context, 6, font->atlasTexture, &slotBits);
+
+        /* glyphs already emitted still draw */
+        if (!v)
+        {
+            drawCalls = emitted ? 1 : 0;
+            break;
+        }
+
+        emitted = true;
+
+        uint32_t type = NK_DRAW_PRIMITIVE_TEXT | slotBits;
+        nkDraw_SetPaintVertex(&v[0], type, q.x0, q.y0, &state->fill, q.s0, q.t0);
+        nkDraw_SetPaintVertex(&v[1], type, q.x1, q.y0, &state->fill, q.s1, q.t0);
+        nkDraw_SetPaintVertex(&v[2], type, q.x1, q.y1, &state->fill, q.s1, q.t1);
+        nkDraw_SetPaintVertex(&v[3], type, q.x0, q.y0, &state->fill, q.s0, q.t0);
+        nkDraw_SetPaintVertex(&v[4], type, q.x1, q.y1, &state->fill, q.s1, q.t1);
+        nkDraw_SetPaintVertex(&v[5], type, q.x0, q.y1, &state->fill, q.s0, q.t1);
+    }
+
+    nkDraw_GeometryEnd(context, start, drawCalls);
+}
+
+bool nkDraw_LoadImage(nkDrawContext_t *context, nkImage_t *image, const char *path)
+{
+    image->id = nkImageTable_LoadFile(&context->images, path);
+    return image->id != 0;
+}
+
+bool nkDraw_LoadImageFromMemory(nkDrawContext_t *context, nkImage_t *image, const uint8_t *data, size_t size)
+{
+    image->id = nkImageTable_LoadMemory(&context->images, data, size);
+    return image->id != 0;
+}
+
+void nkDraw_FreeImage(nkDrawContext_t *context, nkImage_t *image)
+{
+    if (image)
+    {
+        nkImageTable_Free(&context->images, image->id);
+        image->id = 0;
+    }
+}
+
+nkImageState_t nkDraw_GetImageState(nkDrawContext_t *context, const nkImage_t *image, uint32_t *width, uint32_t *height)
+{
+    return nkImageTable_GetState(&context->images, image ? image->id : 0, width, height);
+}
+
+void nkDraw_GetImageMemory(nkDrawContext_t *context, const nkImage_t *image, nkDrawImageMemory_t *memory)
+{
+    nkImageTable_GetMemory(&context->images, image ? image->id : 0, memory);
+}
+
+void nkDraw_Image(nkDrawContext_t *context, const nkImage_t *image, float x, float y, float w, float h)
+{
+    bool pending = false;
+    const nkImageRecord_t *record = nkImageTable_Draw(&context->images, image ? image->id : 0, w, h, &pending);
+    uint32_t slotBits = 0;
+
+    if (!record)
+    {
+        return;
+    }
+
+    /* redraw the rect once the upload lands, or its next mipmap level does */
+    if (pending && context->partialRedraw)
+    {
+        nkDraw_Invalidate(context, (nkRect_t){ x, y, w, h });
+    }
+
+    if (record->state != NK_IMAGE_READY)
+    {
+        return;
+    }
+
+    if (nkDraw_IsCulled(context, x, y, w, h, 0.0f))
+    {
+        return;
+    }
+
+    double start = nkDraw_GeometryStart(context);
+    nkDrawVertex_t *v = nkDraw_AllocVertices(context, 6, (GLuint)record->texture, &slotBits);
+
+    if (!v)
+    {
+        nkDraw_GeometryEnd(context, start, 0);
+        return;
+    }
+
+    uint32_t type = NK_DRAW_PRIMITIVE_IMAGE | slotBits;
+
+    nkDraw_SetVertex(&v[0], type, x, y, NK_COLOR_WHITE, record->u0, record->v0);
+    nkDraw_SetVertex(&v[1], type, x + w, y, NK_COLOR_WHITE, record->u1, record->v0);
+    nkDraw_SetVertex(&v[2], type, x + w, y + h, NK_COLOR_WHITE, record->u1, record->v1);
+    nkDraw_SetVertex(&v[3], type, x, y, NK_COLOR_WHITE, record->u0, record->v0);
+    nkDraw_SetVertex(&v[4], type, x + w, y + h, NK_COLOR_WHITE, record->u1, record->v1);
+    nkDraw_SetVertex(&v[5], type, x, y + h, NK_COLOR_WHITE, record->u0, record->v1);
+
+    nkDraw_GeometryEnd(context, start, 1);
+}
+
+void nkDraw_Rect(nkDrawContext_t* context, float x, float y, float w, float h)
+{
+    /* a square cornered SDF rect, so edges off the pixel grid get the same one pixel ramp */
+    const float radii[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    nkDraw_SdfRect(context, &nkDraw_CurrentState(context)->fill, x, y, w, h, radii, 0.0f);
+}
+
+void nkDraw_RoundedRect(nkDrawContext_t* context, float x, float y, float w, float h, float radius)
+{
+    nkDraw_RoundedRectVarying(context, x, y, w, h, radius, radius, radius, radius);
+}
+
+void nkDraw_RoundedRectPath(nkDrawContext_t* context, float x, float y, float w, float h, float radius)
+{
+    nkDraw_RoundedRectPathVarying(context, x, y, w, h, radius, radius, radius, radius);
+}
+
+void nkDraw_RoundedRectVarying(nkDrawContext_t* context, float x, float y, float w, float h, float radiusTopLeft, float radiusTopRight, float radiusBottomRight, float radiusBottomLeft)
+{
+    const float radii[4] = { radiusTopLeft, radiusTopRight, radiusBottomRight, radiusBottomLeft };
+    nkDraw_SdfRect(context, &nkDraw_CurrentState(context)->fill, x, y, w, h, radii, 0.0f);
+}
+
+void nkDraw_RoundedRectPathVarying(nkDrawContext_t* context, float x, float y, float w, float h, float radiusTopLeft, float radiusTopRight, float radiusBottomRight, float radiusBottomLeft)
+{
+    nkDrawState_t *state = nkDraw_CurrentState(context);
+    const float radii[4] = { radiusTopLeft, radiusTopRight, radiusBottomRight, radiusBottomLeft };
+
+    if (state->strokeWidth <= 0.0f)
+    {
+        return;
+    }
+
+    nkDraw_SdfRect(context, &state->stroke, x, y, w, h, radii, state->strokeWidth);
+}
+
+nkRect_t nkDraw_MeasureText(nkDrawContext_t* context, nkFont_t* font, const char* text)
+{
+    const unsigned char *c;
+    float advance = 0.0f;
+    uint64_t hash = 0;
+    size_t length = text ? strlen(text) : 0;
+    nkTextCacheEntry_t *entry = NULL;
+    nkRect_t measured;
+
+    if (!font)
+    {
+        font = &context->defaultFont;
+    }
+
+    /* fonts baked outside the registry share faceId -1, so only registry fonts are cached */
+    if (font->faceId >= 0)
+    {
+        hash = nkTextCache_Hash(text);
+
+        entry = nkTextCache_Lookup(&context->textCache, hash, text, length, font->faceId, font->fontSize, 0);
+
+        if (entry)
+        {
+            return entry->bounds;
+        }
+    }
+
+    for (c = (const unsigned char*)text; c && *c; c++)
+    {
+        if (*c >= 32 && *c <= 126)
+        {
+            advance += font->bakedCharData[*c - 32].xadvance;
+        }
+    }
+
+    /* line bounds for height, matching the NanoVG backend */
+    measured = (nkRect_t) {
+        .x = 0.0f,
+        .y = -font->ascent,
+        .width = advance,
+        .height = font->ascent - font->descent
+    };
+
+    if (font->faceId >= 0)
+    {
+        entry = nkTextCache_Insert(&context->textCache, hash, text, length, font->faceId, font->fontSize, 0);
+
+        if (entry)
+        {
+            entry->bounds = measured;
+        }
+    }
+
+    return measured;
+}
+
+int nkDraw_RegisterFontFace(nkDrawContext_t *context, const char *name, const uint8_t *data, size_t dataSize)
+{
+    nkDrawFontFace_t *face = nkDraw_FindFontFace(context, name);
+
+    if (face)
+    {
+        return face->faceId;
+    }
+
+    if (context->fontFaceCount >= NK_DRAW_MAX_FONT_FACES || strlen(name) >= NK_DRAW_FONT_NAME_LENGTH)
+    {
+        fprintf(stderr, "ERROR: Cannot register font face '%s'.\n", name);
+        return -1;
+    }
+
+    face = &context->fontFaces[context->fontFaceCount];
+    strcpy(face->name, name);
+    face->data = data;
+    face->dataSize = dataSize;
+    face->source = NULL;
+    face->faceId = (int)context->fontFaceCount;
+
+    context->fontFaceCount++;
+
+    return face->faceId;
+}
+
+int nkDraw_RegisterFontFile(nkDrawContext_t *context, const char *name, const char *path)
+{
+    nkDrawFontFace_t *face = nkDraw_FindFontFace(context, name);
+
+    if (face)
+    {
+        return face->faceId;
+    }
+
+    nkFontSource_t *source = nkFontSource_Acquire(path);
+
+    if (!source)
+    {
+        return -1;
+    }
+
+    int faceId = nkDraw_RegisterFontFace(context, name, source->data, source->size);
+
+    if (faceId == -1)
+    {
+        nkFontSource_Release(source);
+        return -1;
+    }
+
+    /* the context keeps its reference for as long as the face is registered */
+    context->fontFaces[context->fontFaceCount - 1].source = source;
+
+    return faceId;
+}
+
+bool nkDraw_LoadFont(nkDrawContext_t *context, nkFont_t *font, const char *name, float fontSize)
+{
+    nkDrawFontFace_t *face = nkDraw_FindFontFace(context, name);
+
+    if (!face)
+    {
+        fprintf(stderr, "ERROR: Font face '%s' is not registered.\n", name);
+        return false;
+    }
+
+    /* glyph cells average well under a square em, so this usually bakes first time */
+    size_t atlasSize = NK_DRAW_MIN_ATLAS_SIZE;
+
+    while (atlasSize < NK_DRAW_MAX_ATLAS_SIZE && (float)atlasSize < 12.0f * fontSize)
+    {
+        atlasSize *= 2;
+    }
+
+    for (; atlasSize <= NK_DRAW_MAX_ATLAS_SIZE; atlasSize *= 2)
+    {
+        uint8_t *atlas = (uint8_t*)calloc(atlasSize * atlasSize, 1);
+
+        if (!atlas)
+        {
+            return false;
+        }
+
+        bool loaded = nkFont_LoadFromMemory(font, (uint8_t*)face->data, face->dataSize, fontSize, atlas, atlasSize, atlasSize);
+
+        free(atlas);
+
+        if (loaded)
+        {
+            font->faceId = face->faceId;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void nkDraw_BeginList(nkDrawContext_t *context, nkDrawList_t *list)
+{
+    list->commandCount = 0;
+    list->pathCount = 0;
+    list->vertexCount = 0;
+
+    context->recordingList = list;
+}
+
+void nkDraw_EndList(nkDrawContext_t *context)
+{
+    context->recordingList = NULL;
+}
+
+void nkDraw_ReplayList(nkDrawContext_t *context, nkDrawList_t *list, float dx, float dy)
+{
+    const nkDrawVertex_t *recorded = (const nkDrawVertex_t*)list->vertices;
+    size_t i;
+
+    if (list == context->recordingList)
+    {
+        return;
+    }
+
+    double start = nkDraw_GeometryStart(context);
+    bool full = false;
+
+    for (i = 0; i < list->commandCount && !full; i++)
+    {
+        const nkDrawRun_t *run = &((const nkDrawRun_t*)list->commands)[i];
+        nkRect_t clipRect = run->clipRect;
+        size_t done = 0;
+
+        clipRect.x += dx;
+        clipRect.y += dy;
+
+        while (done < run->vertexCount)
+        {
+            /* whole triangles per chunk so oversized runs split cleanly */
+            size_t chunk = run->vertexCount - done;
+            uint32_t slotBits = 0;
+
+            if (chunk > NK_DRAW_MAX_VERTICES)
+            {
+                chunk = NK_DRAW_MAX_VERTICES - (NK_DRAW_MAX_VERTICES % 3);
+            }
+
+            nkDrawVertex_t *v = nkDraw_AllocVerticesClipped(context, chunk, run->texture, run->clipEnabled, clipRect, &slotBits);
+
+            /* the commands replayed so far still draw */
+            if (!v)
+            {
+                full = true;
+                break;
+            }
+
+            const nkDrawVertex_t *src = &recorded[run->vertexOffset + done];
+
+            for (size_t j = 0; j < chunk; j++)
+            {
+                v[j] = src[j];
+                v[j].type = (src[j].type & NK_DRAW_PRIMITIVE_MASK) | slotBits;
+                v[j].x += dx;
+                v[j].y += dy;
+            }
+
+            done += chunk;
+        }
+    }
+
+    nkDraw_GeometryEnd(context, start, (uint32_t)(full ? i - 1 : i));
+}
+
+void nkDrawList_Free(nkDrawList_t *list)
+{
+    free(list->commands);
+    free(list->paths);
+    free(list->vertices);
+    free(list->replayVertices);
+
+    memset(list, 0, sizeof(*list));
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static GLuint nkDraw_CompileShader(GLenum type, const unsigned char *source, unsigned length)
+{
+    const GLchar *sources[1] = { (const GLchar*)source };
+    GLint lengths[1] = { (GLint)length };
+    GLint compiled = GL_FALSE;
+
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, sources, lengths);
+    glCompileShader(shader);
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+
+    if (compiled != GL_TRUE)
+    {
+        char log[512] = {0};
+        glGetShaderInfoLog(shader, sizeof(log) - 1, NULL, log);
+        fprintf(stderr, "ERROR: Failed to compile NanoDraw %s shader.\n%s\n", type == GL_VERTEX_SHADER ? "vertex" : "fragment", log);
+
+        glDeleteShader(shader);
+        return 0;
+    }
+
+    return shader;
+}
+
+static nkDrawState_t *nkDraw_CurrentState(nkDrawContext_t *context)
+{
+    return &context->states[context->stateCount - 1];
+}
+
+static void nkDraw_Flush(nkDrawContext_t *context)
+{
+    nkDrawFrameStats_t *counters = &context->frameCounters;
+    size_t i;
+
+    if (context->vertexCount == 0)
+    {
+        return;
+    }
+
+    double start = nkDraw_Milliseconds();
+
+    for (i = 0; i < context->vertexCount; i += 3)
+    {
+        const nkDrawVertex_t *first = &context->vertices[i];
+        uint32_t primitive = first->type & NK_DRAW_PRIMITIVE_MASK;
+
+        if (primitive == NK_DRAW_PRIMITIVE_TEXT)
+        {
+            counters->textTriangles++;
+        }
+        else if (primitive == NK_DRAW_PRIMITIVE_SDF && first->strokeWidth > 0.0f)
+        {
+            counters->strokeTriangles++;
+        }
+        else
+        {
+            counters->fillTriangles++;
+        }
+    }
+
+    glUseProgram(context->shaderProgram);
+    glBindVertexArray(context->vertexArray);
+    glBindBuffer(GL_ARRAY_BUFFER, context->vertexBuffer);
+
+    /* orphan the previous store so a second flush in the frame doesn't stall */
+    glBufferData(GL_ARRAY_BUFFER, VERTEX_BUFFER_SIZE, NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr)(context->vertexCount * sizeof(nkDrawVertex_t)), context->vertices);
+
+    for (i = 0; i < context->textureCount; i++)
+    {
+        glActiveTexture(GL_TEXTURE0 + (GLenum)i);
+        glBindTexture(GL_TEXTURE_2D, context->textures[i]);
+    }
+
+    glActiveTexture(GL_TEXTURE0);
+
+    glDrawArrays(GL_TRIANGLES, 0, (GLsizei)context->vertexCount);
+
+    counters->gpuDrawCalls++;
+    counters->stateChanges += (uint32_t)context->textureCount;
+    counters->vertexBytes += context->vertexCount * sizeof(nkDrawVertex_t);
+    counters->flushMs += nkDraw_Milliseconds() - start;
+
+    context->vertexCount = 0;
+    context->textureCount = 0;
+}
+
+static void nkDraw_ApplyClip(nkDrawContext_t *context, bool clipEnabled, nkRect_t clipRect)
+{
+    /* the redraw rect applies here rather than in the state, so lists never capture it */
+    if (context->partialRedraw)
+    {
+        clipRect = clipEnabled ? nkRect_Intersection(clipRect, context->redrawRect) : context->redrawRect;
+        clipEnabled = true;
+    }
+
+    if (!clipEnabled && !context->appliedClipEnabled)
+    {
+        return;
+    }
+
+    if (clipEnabled && context->appliedClipEnabled &&
+        clipRect.x == context->appliedClipRect.x && clipRect.y == context->appliedClipRect.y &&
+        clipRect.width == context->appliedClipRect.width && clipRect.height == context->appliedClipRect.height)
+    {
+        return;
+    }
+
+    /* scissor is pipeline state, everything batched so far used the old one */
+    nkDraw_Flush(context);
+
+    context->appliedClipEnabled = clipEnabled;
+    context->appliedClipRect = clipRect;
+    context->frameCounters.stateChanges++;
+
+    if (!clipEnabled)
+    {
+        glDisable(GL_SCISSOR_TEST);
+        return;
+    }
+
+    float x0 = floorf(clipRect.x);
+    float y0 = floorf(clipRect.y);
+    float x1 = ceilf(clipRect.x + clipRect.width);
+    float y1 = ceilf(clipRect.y + clipRect.height);
+
+    glEnable(GL_SCISSOR_TEST);
+    glScissor((GLint)x0, (GLint)ceilf(context->viewHeight) - (GLint)y1, (GLsizei)fmaxf(0.0f, x1 - x0), (GLsizei)fmaxf(0.0f, y1 - y0));
+}
+
+static nkDrawVertex_t *nkDraw_AllocVertices(nkDrawContext_t *context, size_t count, GLuint texture, uint32_t *slotBits)
+{
+    nkDrawState_t *state = nkDraw_CurrentState(context);
+    return nkDraw_AllocVerticesClipped(context, count, texture, state->clipEnabled, state->clipRect, slotBits);
+}
+
+static nkDrawVertex_t *nkDraw_AllocVerticesClipped(nkDrawContext_t *context, size_t count, GLuint texture, bool clipEnabled, nkRect_t clipRect, uint32_t *slotBits)
+{
+    size_t slot = 0;
+
+    *slotBits = 0;
+
+    if (context->recordingList)
+    {
+        return nkDraw_ListAllocVertices(context->recordingList, count, texture, clipEnabled, clipRect);
+    }
+
+    if (count > NK_DRAW_MAX_VERTICES)
+    {
+        return NULL;
+    }
+
+    nkDraw_ApplyClip(context, clipEnabled, clipRect);
+
+    if (context->vertexCount + count > NK_DRAW_MAX_VERTICES)
+    {
+        nkDraw_Flush(context);
+    }
+
+    if (texture != 0)
+    {
+        while (slot < context->textureCount && context->textures[slot] != texture)
+        {
+            slot++;
+        }
+
+        if (slot == context->textureCount)
+        {
+            /* texture set is full, start the next draw */
+            if (context->textureCount == TEXTURE_ATTACHMENTS)
+            {
+                nkDraw_Flush(context);
+                slot = 0;
+            }
+
+            context->textures[context->textureCount++] = texture;
+        }
+
+        *slotBits = (uint32_t)slot << NK_DRAW_SLOT_SHIFT;
+    }
+
+    nkDrawVertex_t *vertices = &context->vertices[context->vertexCount];
+    context->vertexCount += count;
+
+    return vertices;
+}
+
+static bool nkDraw_ListReserve(void **buffer, size_t *capacity, size_t required, size_t elementSize)
+{
+    if (required <= *capacity)
+    {
+        return true;
+    }
+
+    size_t newCapacity = *capacity ? *capacity : 64;
+
+    while (newCapacity < required)
+    {
+        newCapacity *= 2;
+    }
+
+    void *newBuffer = realloc(*buffer, newCapacity * elementSize);
+
+    if (!newBuffer)
+    {
+        return false;
+    }
+
+    *buffer = newBuffer;
+    *capacity = newCapacity;
+
+    return true;
+}
+
+static nkDrawVertex_t *nkDraw_ListAllocVertices(nkDrawList_t *list, size_t count, GLuint texture, bool clipEnabled, nkRect_t clipRect)
+{
+    nkDrawRun_t *run = NULL;
+
+    if (!nkDraw_ListReserve(&list->vertices, &list->vertexCapacity, list->vertexCount + count, sizeof(nkDrawVertex_t)))
+    {
+        return NULL;
+    }
+
+    if (list->commandCount > 0)
+    {
+        run = &((nkDrawRun_t*)list->commands)[list->commandCount - 1];
+
+        bool sameClip = run->clipEnabled == clipEnabled &&
+            (!clipEnabled || (run->clipRect.x == clipRect.x && run->clipRect.y == clipRect.y &&
+                              run->clipRect.width == clipRect.width && run->clipRect.height == clipRect.height));
+
+        if (run->texture != texture || !sameClip)
+        {
+            run = NULL;
+        }
+    }
+
+    if (!run)
+    {
+        if (!nkDraw_ListReserve(&list->commands, &list->commandCapacity, list->commandCount + 1, sizeof(nkDrawRun_t)))
+        {
+            return NULL;
+        }
+
+        run = &((nkDrawRun_t*)list->commands)[list->commandCount++];
+        run->texture = texture;
+        run->clipRect = clipRect;
+        run->clipEnabled = clipEnabled;
+        run->vertexOffset = list->vertexCount;
+        run->vertexCount = 0;
+    }
+
+    nkDrawVertex_t *vertices = &((nkDrawVertex_t*)list->vertices)[list->vertexCount];
+
+    run->vertexCount += count;
+    list->vertexCount += count;
+
+    return vertices;
+}
+
+static nkDrawPaint_t nkDraw_SolidPaint(nkColor_t color)
+{
+    return (nkDrawPaint_t) {
+        .colorStart = color,
+        .colorEnd = color,
+        .gradient = false
+    };
+}
+
+static nkDrawPaint_t nkDraw_GradientPaint(nkColor_t colorStart, nkColor_t colorEnd, float angle, float x, float y, float w, float h)
+{
+    float dx = sinf(angle);
+    float dy = cosf(angle);
+
+    float halfDiag = 0.5f * (fabsf(dx) * w + fabsf(dy) * h);
+
+    float cx = x + w * 0.5f;
+    float cy = y + h * 0.5f;
+
+    return (nkDrawPaint_t) {
+        .colorStart = colorStart,
+        .colorEnd = colorEnd,
+        .x0 = cx - dx * halfDiag,
+        .y0 = cy - dy * halfDiag,
+        .x1 = cx + dx * halfDiag,
+        .y1 = cy + dy * halfDiag,
+        .gradient = true
+    };
+}
+
+static void nkDraw_SetVertex(nkDrawVertex_t *vertex, uint32_t type, float x, float y, nkColor_t color, float u, float v)
+{
+    vertex->type = type;
+    vertex->x = x;
+    vertex->y = y;
+    vertex->r = color.r;
+    vertex->g = color.g;
+    vertex->b = color.b;
+    vertex->a = color.a;
+    vertex->u = u;
+    vertex->v = v;
+    vertex->halfWidth = 0.0f;
+    vertex->halfHeight = 0.0f;
+    vertex->strokeWidth = 0.0f;
+    memset(vertex->radii, 0, sizeof(vertex->radii));
+    vertex->endR = color.r;
+    vertex->endG = color.g;
+    vertex->endB = color.b;
+    vertex->endA = color.a;
+    vertex->t = 0.0f;
+}
+
+static void nkDraw_SetPaintVertex(nkDrawVertex_t *vertex, uint32_t type, float x, float y, const nkDrawPaint_t *paint, float u, float v)
+{
+    nkDraw_SetVertex(vertex, type, x, y, paint->colorStart, u, v);
+
+    if (!paint->gradient)
+    {
+        return;
+    }
+
+    /* t is affine in position so it interpolates exactly, clamping it per pixel in the
+    ** shader keeps NanoVG's flat ends past the axis however far the geometry reaches */
+    float ax = paint->x1 - paint->x0;
+    float ay = paint->y1 - paint->y0;
+    float lengthSq = ax * ax + ay * ay;
+
+    vertex->endR = paint->colorEnd.r;
+    vertex->endG = paint->colorEnd.g;
+    vertex->endB = paint->colorEnd.b;
+    vertex->endA = paint->colorEnd.a;
+    vertex->t = lengthSq > 0.0f ? ((x - paint->x0) * ax + (y - paint->y0) * ay) / lengthSq : 0.0f;
+}
+
+static nkDrawFontFace_t *nkDraw_FindFontFace(nkDrawContext_t *context, const char *name)
+{
+    size_t i;
+
+    for (i = 0; i < context->fontFaceCount; i++)
+    {
+        if (strcmp(context->fontFaces[i].name, name) == 0)
+        {
+            return &context->fontFaces[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void nkDraw_SdfRect(nkDrawContext_t *context, const nkDrawPaint_t *paint, float x, float y, float w, float h, const float radii[4], float strokeWidth)
+{
+    uint32_t slotBits = 0;
+    int corner, i;
+
+    if (w <= 0.0f || h <= 0.0f || nkDraw_IsCulled(context, x, y, w, h, 0.5f * strokeWidth + 1.0f))
+    {
+        return;
+    }
+
+    float halfWidth = 0.5f * w;
+    float halfHeight = 0.5f * h;
+    float maxRadius = fminf(halfWidth, halfHeight);
+
+    /* one pixel for the coverage ramp plus half the stroke, which is centred on the outline */
+    float margin = 1.0f + 0.5f * strokeWidth;
+
+    double start = nkDraw_GeometryStart(context);
+    nkDrawVertex_t *v = nkDraw_AllocVertices(context, 6, 0, &slotBits);
+
+    if (!v)
+    {
+        nkDraw_GeometryEnd(context, start, 0);
+        return;
+    }
+
+    const float corners[4][2] = {
+        { -halfWidth - margin, -halfHeight - margin },
+        {  halfWidth + margin, -halfHeight - margin },
+        {  halfWidth + margin,  halfHeight + margin },
+        { -halfWidth - margin,  halfHeight + margin }
+    };
+    const int order[6] = { 0, 1, 2, 0, 2, 3 };
+
+    float cx = x + halfWidth;
+    float cy = y + halfHeight;
+
+    for (i = 0; i < 6; i++)
+    {
+        const float *local = corners[order[i]];
+        float px = cx + local[0];
+        float py = cy + local[1];
+
+        nkDraw_SetPaintVertex(&v[i], NK_DRAW_PRIMITIVE_SDF, px, py, paint, local[0], local[1]);
+
+        v[i].halfWidth = halfWidth;
+        v[i].halfHeight = halfHeight;
+        v[i].strokeWidth = strokeWidth;
+
+        for (corner = 0; corner < 4; corner++)
+        {
+            v[i].radii[corner] = fmaxf(0.0f, fminf(radii[corner], maxRadius));
+        }
+    }
+
+    nkDraw_GeometryEnd(context, start, 1);
+}
+
+/* takes this frame's redraw rect from the invalidated ones, or the whole view if the target
+** lost its pixels */
+static void nkDraw_BeginRedraw(nkDrawContext_t *context, float width, float height, bool intact)
+{
+    nkRect_t view = { .x = 0.0f, .y = 0.0f, .width = width, .height = height };
+    nkRect_t damage = nkRect_Intersection(intact ? context->damageRect : view, view);
+
+    float x0 = floorf(damage.x);
+    float y0 = floorf(damage.y);
+    float x1 = ceilf(damage.x + damage.width);
+    float y1 = ceilf(damage.y + damage.height);
+
+    context->redrawRect = nkRect_IsEmpty(damage) ? (nkRect_t){ 0 } : (nkRect_t){ .x = x0, .y = y0, .width = x1 - x0, .height = y1 - y0 };
+    context->damageRect = (nkRect_t){ 0 };
+}
+
+/* true when x, y, w, h grown by outset misses the view, the clip rect or in partial frames
+** the redraw rect, each snapped out to the whole pixels the scissor covers. lists are replayed
+** at other offsets, so nothing is culled while recording. */
+static bool nkDraw_IsCulled(nkDrawContext_t *context, float x, float y, float w, float h, float outset)
+{
+    if (context->recordingList)
+    {
+        return false;
+    }
+
+    nkDrawState_t *state = nkDraw_CurrentState(context);
+    nkRect_t visible = { .x = 0.0f, .y = 0.0f, .width = context->viewWidth, .height = context->viewHeight };
+
+    if (state->clipEnabled)
+    {
+        float x0 = floorf(state->clipRect.x);
+        float y0 = floorf(state->clipRect.y);
+        float x1 = ceilf(state->clipRect.x + state->clipRect.width);
+        float y1 = ceilf(state->clipRect.y + state->clipRect.height);
+
+        visible = nkRect_Intersection(visible, (nkRect_t){ .x = x0, .y = y0, .width = x1 - x0, .height = y1 - y0 });
+    }
+
+    if (context->partialRedraw)
+    {
+        visible = nkRect_Intersection(visible, context->redrawRect);
+    }
+
+    nkRect_t bounds = {
+        .x = fminf(x, x + w) - outset,
+        .y = fminf(y, y + h) - outset,
+        .width = fabsf(w) + 2.0f * outset,
+        .height = fabsf(h) + 2.0f * outset
+    };
+
+    if (nkRect_Intersects(bounds, visible))
+    {
+        return false;
+    }
+
+    context->frameCounters.culledCalls++;
+    return true;
+}
+
+static double nkDraw_Milliseconds(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec * 1e-6;
+}
+
+/* geometry time excludes flushes triggered while building it, those count as flush time */
+static double nkDraw_GeometryStart(nkDrawContext_t *context)
+{
+    return nkDraw_Milliseconds() - context->frameCounters.flushMs;
+}
+
+static void nkDraw_GeometryEnd(nkDrawContext_t *context, double start, uint32_t drawCalls)
+{
+    context->frameCounters.tessellationMs += nkDraw_Milliseconds() - context->frameCounters.flushMs - start;
+
+    /* recorded lists count when replayed */
+    if (!context->recordingList)
+    {
+        context->frameCounters.drawCalls += drawCalls;
+    }
+}
+
+/* RGBA8 with bilinear filtering and clamped edges, pixels may be NULL */
+static uint32_t nkDraw_CreateImageTexture(void *user, uint32_t width, uint32_t height, const uint8_t *pixels)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)user;
+    GLuint texture = 0;
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, (GLsizei)width, (GLsizei)height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    if (pixels)
+    {
+        context->frameCounters.textureUploads++;
+        context->frameCounters.textureUploadBytes += (uint64_t)width * (uint64_t)height * 4;
+    }
+
+    return (uint32_t)texture;
+}
+
+/* storage for the levels, sampling none of them until they are uploaded */
+static uint32_t nkDraw_CreateImageLevels(void *user, uint32_t width, uint32_t height, uint32_t levels)
+{
+    GLuint texture = 0;
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, (GLint)levels - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)levels - 1);
+
+    for (uint32_t level = 0; level < levels; level++)
+    {
+        uint32_t levelWidth, levelHeight;
+
+        nkMipmap_LevelSize(width, height, level, &levelWidth, &levelHeight);
+        glTexImage2D(GL_TEXTURE_2D, (GLint)level, GL_RGBA8, (GLsizei)levelWidth, (GLsizei)levelHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    return (uint32_t)texture;
+}
+
+/* sampling is clamped to the levels uploaded so far */
+static void nkDraw_UpdateImageLevel(void *user, uint32_t texture, uint32_t level, uint32_t width, uint32_t height, const uint8_t *pixels)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)user;
+
+    glBindTexture(GL_TEXTURE_2D, (GLuint)texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, (GLint)level, 0, 0, (GLsizei)width, (GLsizei)height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, (GLint)level);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    context->frameCounters.textureUploads++;
+    context->frameCounters.textureUploadBytes += (uint64_t)width * (uint64_t)height * 4;
+}
+
+/* the rect is read in place out of the page, through the unpack row length and skips */
+static void nkDraw_UpdateImageRegion(void *user, uint32_t texture, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const uint8_t *page, uint32_t pageSize)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)user;
+
+    glBindTexture(GL_TEXTURE_2D, (GLuint)texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, (GLint)pageSize);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, (GLint)x);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, (GLint)y);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, (GLint)x, (GLint)y, (GLsizei)width, (GLsizei)height, GL_RGBA, GL_UNSIGNED_BYTE, page);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    context->frameCounters.textureUploads++;
+    context->frameCounters.textureUploadBytes += (uint64_t)width * (uint64_t)height * 4;
+}
+
+static void nkDraw_DeleteImageTexture(void *user, uint32_t texture)
+{
+    GLuint name = (GLuint)texture;
+    glDeleteTextures(1, &name);
+}
@@ -17,6 +17,8 @@
 
 #include "geometry.h"
 
+#include <math.h>
+
 /***************************************************************
 ** MARK: CONSTANTS & MACROS
 ***************************************************************/
@@ -103,6 +105,47 @@ bool nkRect_ContainsPoint(nkRect_t rect, nkPoint_t point)
             point.y >= rect.y && point.y <= (rect.y + rect.height));
 }
 
+bool nkRect_IsEmpty(nkRect_t rect)
+{
+    return rect.width <= 0.0f || rect.height <= 0.0f;
+}
+
+bool nkRect_Intersects(nkRect_t a, nkRect_t b)
+{
+    return (a.x < b.x + b.width && b.x < a.x + a.width &&
+            a.y < b.y + b.height && b.y < a.y + a.height);
+}
+
+nkRect_t nkRect_Intersection(nkRect_t a, nkRect_t b)
+{
+    float x0 = fmaxf(a.x, b.x);
+    float y0 = fmaxf(a.y, b.y);
+    float x1 = fminf(a.x + a.width, b.x + b.width);
+    float y1 = fminf(a.y + a.height, b.y + b.height);
+
+    return (nkRect_t){ .x = x0, .y = y0, .width = fmaxf(0.0f, x1 - x0), .height = fmaxf(0.0f, y1 - y0) };
+}
+
+nkRect_t nkRect_Union(nkRect_t a, nkRect_t b)
+{
+    if (nkRect_IsEmpty(a))
+    {
+        return b;
+    }
+
+    if (nkRect_IsEmpty(b))
+    {
+        return a;
+    }
+
+    float x0 = fminf(a.x, b.x);
+    float y0 = fminf(a.y, b.y);
+    float x1 = fmaxf(a.x + a.width, b.x + b.width);
+    float y1 = fmaxf(a.y + a.height, b.y + b.height);
+
+    return (nkRect_t){ .x = x0, .y = y0, .width = x1 - x0, .height = y1 - y0 };
+}
+
 /***************************************************************
 ** MARK: STATIC FUNCTIONS
 ***************************************************************/
@@ -101,6 +101,12 @@ nkThickness_t nkThickness_FromHorizontalVertical(float horizontal, float vertica
 
 bool nkRect_ContainsPoint(nkRect_t rect, nkPoint_t point);
 
+/* empty rects (zero or negative size) are ignored by Union and produced by Intersection */
+bool nkRect_IsEmpty(nkRect_t rect);
+bool nkRect_Intersects(nkRect_t a, nkRect_t b);
+nkRect_t nkRect_Intersection(nkRect_t a, nkRect_t b);
+nkRect_t nkRect_Union(nkRect_t a, nkRect_t b);
+
 /***************************************************************
 ** MARK: FUNCTION DEFS
 ***************************************************************/
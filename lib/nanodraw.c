@@ -21,6 +21,9 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
 
 #if __EMSCRIPTEN__
     #define NANOVG_GLES3_IMPLEMENTATION
@@ -29,16 +32,42 @@
 #endif
 
 #include <extern/nanovg/nanovg_gl.h>
+#include "backends/cpu/nanovg_cpu.h"
 
 
 /***************************************************************
 ** MARK: CONSTANTS & MACROS
 ***************************************************************/
 
+#define NK_DRAW_DEFAULT_FONT_SIZE (14.0f)
+
 /***************************************************************
 ** MARK: TYPEDEFS
 ***************************************************************/
 
+typedef enum
+{
+    NK_DRAW_LIST_FILL,
+    NK_DRAW_LIST_STROKE,
+    NK_DRAW_LIST_TRIANGLES
+} nkDrawListCommandType_t;
+
+typedef struct
+{
+    nkDrawListCommandType_t type;
+    NVGpaint paint;
+    NVGcompositeOperationState compositeOperation;
+    NVGscissor scissor;
+    float fringe;
+    float strokeWidth;
+    float sdfEdge; /* triangles, non-zero for distance field glyphs */
+    float bounds[4];
+    size_t pathOffset;
+    size_t pathCount;
+    size_t vertexOffset;
+    size_t vertexCount;
+} nkDrawListCommand_t;
+
 /***************************************************************
 ** MARK: STATIC VARIABLES
 ***************************************************************/
@@ -47,22 +76,134 @@
 extern const uint8_t NKFonts_fonts_Roboto_Regular_ttf[];
 extern const size_t NKFonts_fonts_Roboto_Regular_ttf_size;
 
+#ifdef NK_DRAW_GLYPH_CACHE
+/* baked from the default font by the NANODRAW_GLYPH_CACHE_FONT CMake option */
+extern const unsigned char nanodraw_glyph_cache[];
+extern const unsigned nanodraw_glyph_cache_size;
+#endif
+
 /***************************************************************
 ** MARK: STATIC FUNCTION DEFS
 ***************************************************************/
 
+static nkDrawFontFace_t *nkDraw_FindFontFace(nkDrawContext_t *context, const char *name);
+static void nkDraw_ApplyFont(nkDrawContext_t *context, const nkFont_t *font);
+
+static bool nkDraw_ListReserve(void **buffer, size_t *capacity, size_t required, size_t elementSize);
+static bool nkDraw_ListReserveVertices(nkDrawList_t *list, size_t count);
+static nkDrawListCommand_t *nkDraw_ListAppendCommand(nkDrawList_t *list, nkDrawListCommandType_t type, NVGpaint *paint, NVGcompositeOperationState compositeOperation, NVGscissor *scissor, float fringe);
+static void nkDraw_ListAppendPaths(nkDrawList_t *list, nkDrawListCommand_t *command, const NVGpath *paths, int npaths);
+static void nkDraw_ListRebasePaths(nkDrawList_t *list, NVGvertex *from, NVGvertex *to);
+
+static int nkDraw_ForwardCreateTexture(void *uptr, int type, int w, int h, int imageFlags, const unsigned char *data);
+static int nkDraw_ForwardDeleteTexture(void *uptr, int image);
+static int nkDraw_ForwardUpdateTexture(void *uptr, int image, int x, int y, int w, int h, const unsigned char *data);
+static int nkDraw_ForwardGetTextureSize(void *uptr, int image, int *w, int *h);
+static void nkDraw_ForwardViewport(void *uptr, float width, float height, float devicePixelRatio);
+static int nkDraw_ForwardCreateTextureLevels(void *uptr, int w, int h, int nlevels, int imageFlags);
+static int nkDraw_ForwardUpdateTextureLevel(void *uptr, int image, int level, const unsigned char *data);
+static void nkDraw_ForwardCancel(void *uptr);
+static void nkDraw_ForwardFlush(void *uptr);
+
+static void nkDraw_RecordFill(void *uptr, NVGpaint *paint, NVGcompositeOperationState compositeOperation, NVGscissor *scissor, float fringe, const float *bounds, const NVGpath *paths, int npaths);
+static void nkDraw_RecordStroke(void *uptr, NVGpaint *paint, NVGcompositeOperationState compositeOperation, NVGscissor *scissor, float fringe, float strokeWidth, const NVGpath *paths, int npaths);
+static void nkDraw_RecordTriangles(void *uptr, NVGpaint *paint, NVGcompositeOperationState compositeOperation, NVGscissor *scissor, const NVGvertex *verts, int nverts, float fringe, float sdfEdge);
+
+static void nkDraw_BeginRedraw(nkDrawContext_t *context, float width, float height, bool intact);
+static bool nkDraw_IsCulled(nkDrawContext_t *context, float x, float y, float w, float h, float outset);
+static void nkDraw_ClipToRedraw(nkDrawContext_t *context, NVGscissor *scissor);
+
+static void nkDraw_RasterizeGlyph(void *user, size_t index);
+static bool nkDraw_UseGlyphCache(nkDrawContext_t *context, const uint8_t *data, size_t size, nkFileMap_t *file);
+
+static uint32_t nkDraw_CreateImageTexture(void *user, uint32_t width, uint32_t height, const uint8_t *pixels);
+static uint32_t nkDraw_CreateImageLevels(void *user, uint32_t width, uint32_t height, uint32_t levels);
+static void nkDraw_UpdateImageLevel(void *user, uint32_t texture, uint32_t level, uint32_t width, uint32_t height, const uint8_t *pixels);
+static void nkDraw_UpdateImageRegion(void *user, uint32_t texture, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const uint8_t *page, uint32_t pageSize);
+static void nkDraw_DeleteImageTexture(void *user, uint32_t texture);
+
+static void *nkDraw_FrameAlloc(void *uptr, int size);
+static void *nkDraw_ArenaAlloc(void *user, size_t size);
+static void nkDraw_ArenaReset(void *user);
+
 /***************************************************************
 ** MARK: PUBLIC FUNCTIONS
 ***************************************************************/
 
 bool nkDraw_CreateContext(nkDrawContext_t *context)
 {
+    return nkDraw_CreateContextWithOptions(context, NULL);
+}
+
+bool nkDraw_CreateContextWithOptions(nkDrawContext_t *context, const nkDrawContextOptions_t *options)
+{
+    const nkImageTextures_t imageTextures = {
+        .user = context,
+        .createTexture = nkDraw_CreateImageTexture,
+        .createLevels = nkDraw_CreateImageLevels,
+        .updateLevel = nkDraw_UpdateImageLevel,
+        .updateRegion = nkDraw_UpdateImageRegion,
+        .deleteTexture = nkDraw_DeleteImageTexture
+    };
+
+    context->target = options ? options->target : NK_DRAW_TARGET_GL;
+    context->pixels = NULL;
+    context->pixelWidth = 0;
+    context->pixelHeight = 0;
+
+    context->recordingList = NULL;
+    context->fontFaceCount = 0;
+    nkTextCache_Init(&context->textCache, NK_DRAW_MEASURE_CACHE_SIZE);
+    nkTextCache_Init(&context->runCache, NK_DRAW_RUN_CACHE_SIZE);
+    context->appliedFaceId = -1;
+    context->appliedFontSize = 0.0f;
+    memset(&context->frameStats, 0, sizeof(context->frameStats));
+
+    nkArena_Init(&context->frameArena, 0);
+
+    if (options && options->allocator)
+    {
+        context->frameAllocator = *options->allocator;
+    }
+    else
+    {
+        context->frameAllocator = (nkDrawAllocator_t){ .user = &context->frameArena, .alloc = nkDraw_ArenaAlloc, .reset = nkDraw_ArenaReset };
+    }
+
+    context->frameBytes = 0;
+    memset(&context->memoryStats, 0, sizeof(context->memoryStats));
 
+    context->partialRedraw = options && options->partialRedraw;
+    context->sdfText = options && options->sdfText;
+    context->glyphPool = NULL;
+    context->glyphBatch = false;
+    context->glyphCache = NULL;
+    context->glyphCacheSize = 0;
+    memset(&context->glyphCacheFile, 0, sizeof(context->glyphCacheFile));
+    nkImageTable_Init(&context->images, &imageTextures, NK_DRAW_IMAGE_THREADS, NK_DRAW_IMAGE_ATLAS_SIZE,
+        options && options->separateImages ? 0 : (options && options->imageAtlasLimit ? options->imageAtlasLimit : NK_DRAW_IMAGE_ATLAS_LIMIT),
+        options && options->imageMipmaps != NK_DRAW_MIPMAPS_OFF, options && options->imageMipmaps == NK_DRAW_MIPMAPS_FIT);
+    context->damageRect = (nkRect_t){ 0 };
+    context->redrawRect = (nkRect_t){ 0 };
+    memset(&context->renderTarget, 0, sizeof(context->renderTarget));
+
+    if (context->target == NK_DRAW_TARGET_CPU)
+    {
+        context->nvgContext = nvgCreateCPU(NVG_ANTIALIAS | NVG_STENCIL_STROKES);
+
+        if (context->nvgContext)
+        {
+            nvgCPUSetThreads(context->nvgContext, (int)options->threads);
+        }
+    }
+    else
+    {
     #if __EMSCRIPTEN__
         context->nvgContext = nvgCreateGLES3(NVG_ANTIALIAS | NVG_STENCIL_STROKES);
     #else
-        context->nvgContext = nvgCreateGL3(NVG_ANTIALIAS | NVG_STENCIL_STROKES);
+        context->nvgContext = nvgCreateGL3(NVG_ANTIALIAS | NVG_STENCIL_STROKES | NVG_STREAM_BUFFERS);
     #endif
+    }
 
     if (!context->nvgContext) 
     {
@@ -70,16 +211,33 @@ bool nkDraw_CreateContext(nkDrawContext_t *context)
     }
     else 
     {
-        int font = nvgCreateFontMem(context->nvgContext, "sans", NKFonts_fonts_Roboto_Regular_ttf, NKFonts_fonts_Roboto_Regular_ttf_size, 0);
-        if (font == -1)
+        NVGallocator allocator = { context, nkDraw_FrameAlloc };
+        nvgSetFrameAllocator(context->nvgContext, &allocator);
+
+        /* before any face, each one takes its glyphs from the cache as it is registered */
+        if (options && options->glyphCache)
+        {
+            nkDraw_LoadGlyphCacheFromMemory(context, options->glyphCache, options->glyphCacheSize);
+        }
+        else if (options && options->glyphCachePath)
+        {
+            nkDraw_LoadGlyphCache(context, options->glyphCachePath);
+        }
+    #ifdef NK_DRAW_GLYPH_CACHE
+        else
+        {
+            nkDraw_LoadGlyphCacheFromMemory(context, nanodraw_glyph_cache, nanodraw_glyph_cache_size);
+        }
+    #endif
+
+        int font = nkDraw_RegisterFontFace(context, "sans", NKFonts_fonts_Roboto_Regular_ttf, NKFonts_fonts_Roboto_Regular_ttf_size);
+        if (font == -1 || !nkDraw_LoadFont(context, &context->defaultFont, "sans", NK_DRAW_DEFAULT_FONT_SIZE))
         {
             fprintf(stderr, "ERROR: Failed to load font into NanoVG context.\n");
         }
         else 
         {
             printf("Font loaded successfully with ID: %d\n", font);
-            nvgFontSize(context->nvgContext, 14.0f);
-            nvgFontFace(context->nvgContext, "sans");
         }
 
         printf("NanoDraw context created successfully.\n");
@@ -89,35 +247,341 @@ bool nkDraw_CreateContext(nkDrawContext_t *context)
     return context->nvgContext != NULL;
 }
 
+void nkDraw_DestroyContext(nkDrawContext_t *context)
+{
+    /* deferred glyphs are rasterized into NanoVG's jobs, which go with the context */
+    if (context->glyphPool)
+    {
+        nkThreadPool_Join(context->glyphPool);
+        nkThreadPool_Destroy(context->glyphPool);
+        context->glyphPool = NULL;
+        context->glyphBatch = false;
+    }
+
+    nkImageTable_Destroy(&context->images);
+
+    if (context->nvgContext)
+    {
+        if (context->target == NK_DRAW_TARGET_CPU)
+        {
+            nvgDeleteCPU(context->nvgContext);
+        }
+        else
+        {
+        #if __EMSCRIPTEN__
+            nvgDeleteGLES3(context->nvgContext);
+        #else
+            nvgDeleteGL3(context->nvgContext);
+        #endif
+        }
+
+        context->nvgContext = NULL;
+    }
+
+    nkRenderTarget_Destroy(&context->renderTarget);
+
+    /* fontstash held on to the face data until now */
+    for (size_t i = 0; i < context->fontFaceCount; i++)
+    {
+        nkFontSource_Release(context->fontFaces[i].source);
+        context->fontFaces[i].source = NULL;
+    }
+
+    context->fontFaceCount = 0;
+    nkFileMap_Close(&context->glyphCacheFile);
+    context->glyphCache = NULL;
+    context->glyphCacheSize = 0;
+
+    nkTextCache_Destroy(&context->textCache);
+    nkTextCache_Destroy(&context->runCache);
+    nkArena_Destroy(&context->frameArena);
+
+    free(context->pixels);
+    context->pixels = NULL;
+    context->pixelWidth = 0;
+    context->pixelHeight = 0;
+}
+
 void nkDraw_Begin(nkDrawContext_t *context, float width, float height)
 {
+    bool intact = true; /* target still holds the last frame */
+
+    if (context->target == NK_DRAW_TARGET_CPU)
+    {
+        size_t pixelWidth = width > 0.0f ? (size_t)ceilf(width) : 0;
+        size_t pixelHeight = height > 0.0f ? (size_t)ceilf(height) : 0;
+
+        if (pixelWidth != context->pixelWidth || pixelHeight != context->pixelHeight)
+        {
+            free(context->pixels);
+            context->pixels = (uint8_t*)calloc(pixelWidth * pixelHeight * 4 + 1, 1);
+            context->pixelWidth = context->pixels ? pixelWidth : 0;
+            context->pixelHeight = context->pixels ? pixelHeight : 0;
+
+            if (!context->pixels)
+            {
+                fprintf(stderr, "ERROR: Failed to allocate %zux%zu pixel buffer.\n", pixelWidth, pixelHeight);
+            }
+
+            nvgCPUSetTarget(context->nvgContext, context->pixels, (int)context->pixelWidth, (int)context->pixelHeight, (int)(context->pixelWidth * 4));
+            intact = false;
+        }
+    }
+    else if (context->partialRedraw)
+    {
+        intact = nkRenderTarget_Begin(&context->renderTarget, (int)ceilf(width), (int)ceilf(height));
+    }
+
+    context->viewWidth = width;
+    context->viewHeight = height;
+
+    /* last frame's geometry is done with, NanoVG takes new arrays in nvgBeginFrame */
+    if (context->frameAllocator.reset)
+    {
+        context->frameAllocator.reset(context->frameAllocator.user);
+    }
+
+    context->frameBytes = 0;
+
     nvgBeginFrame(context->nvgContext, width, height, 1.0f);
     nvgResetScissor(context->nvgContext);
+    nvgFontSDF(context->nvgContext, context->sdfText);
+
+    /* glyphs deferred by earlier frames join the atlas once their whole batch is done */
+    if (context->glyphBatch && nkThreadPool_IsIdle(context->glyphPool))
+    {
+        nvgCommitGlyphJobs(context->nvgContext);
+        context->glyphBatch = false;
+    }
+
+    /* images decoded since the last frame */
+    nkImageTable_Update(&context->images, NK_DRAW_IMAGE_UPLOAD_BUDGET);
+
+    if (context->partialRedraw)
+    {
+        nkDraw_BeginRedraw(context, width, height, intact);
+        nvgScissor(context->nvgContext, context->redrawRect.x, context->redrawRect.y, context->redrawRect.width, context->redrawRect.height);
+    }
+
+    /* mirror of the NanoVG defaults, read back to pick the SDF fill path */
+    memset(&context->states[0], 0, sizeof(context->states[0]));
+    context->states[0].fill = (nkDrawPaint_t){ .colorStart = NK_COLOR_WHITE, .colorEnd = NK_COLOR_WHITE };
+    context->states[0].stroke = (nkDrawPaint_t){ .colorStart = NK_COLOR_BLACK, .colorEnd = NK_COLOR_BLACK };
+    context->states[0].strokeWidth = 1.0f;
+    context->stateCount = 1;
+
+    /* nvgBeginFrame resets the font state */
+    context->appliedFaceId = -1;
+    context->appliedFontSize = 0.0f;
 }
 
 void nkDraw_End(nkDrawContext_t *context)
 {
+    NVGframeStats stats;
+
     nvgEndFrame(context->nvgContext);
+    nvgFrameStats(context->nvgContext, &stats);
+
+    nkRenderTarget_End(&context->renderTarget);
+
+    context->frameStats.drawCalls = (uint32_t)stats.drawCallCount;
+    context->frameStats.fillTriangles = (uint32_t)stats.fillTriCount;
+    context->frameStats.strokeTriangles = (uint32_t)stats.strokeTriCount;
+    context->frameStats.textTriangles = (uint32_t)stats.textTriCount;
+    context->frameStats.convexFills = (uint32_t)stats.convexFillCount;
+    context->frameStats.triangulatedFills = (uint32_t)stats.triangulatedFillCount;
+    context->frameStats.stencilFills = (uint32_t)stats.stencilFillCount;
+    context->frameStats.culledCalls = (uint32_t)stats.culledCount;
+    context->frameStats.gpuDrawCalls = (uint32_t)stats.rendererDrawCount;
+    context->frameStats.stateChanges = (uint32_t)stats.rendererStateChanges;
+    context->frameStats.vertexBytes = (uint64_t)stats.rendererUploadBytes;
+    context->frameStats.textureUploads = (uint32_t)stats.textureUploadCount;
+    context->frameStats.textureUploadBytes = (uint64_t)stats.textureUploadBytes;
+    context->frameStats.tessellationMs = stats.tessTime * 1000.0;
+    context->frameStats.flushMs = stats.flushTime * 1000.0;
+
+    context->memoryStats.frameBytes = context->frameBytes;
+    if (context->frameBytes > context->memoryStats.highWaterBytes)
+    {
+        context->memoryStats.highWaterBytes = context->frameBytes;
+    }
+    context->memoryStats.arenaCapacity = context->frameArena.capacity;
+    context->memoryStats.arenaGrowths = context->frameArena.growths;
+
+    /* glyphs deferred this frame rasterize while the next ones are built */
+    if (!context->glyphBatch)
+    {
+        int jobs = nvgTakeGlyphJobs(context->nvgContext);
+
+        if (jobs > 0)
+        {
+            if (!context->glyphPool)
+            {
+                /* NULL without thread support, Dispatch then runs the batch here */
+                context->glyphPool = nkThreadPool_Create(NK_DRAW_GLYPH_THREADS);
+            }
+
+            context->glyphBatch = true;
+            nkThreadPool_Dispatch(context->glyphPool, (size_t)jobs, nkDraw_RasterizeGlyph, context);
+        }
+    }
+
+    /* images loaded this frame decode while the next ones are built */
+    nkImageTable_Start(&context->images);
+}
+
+void nkDraw_Clear(nkDrawContext_t *context, nkColor_t color)
+{
+    nkRect_t rect = context->redrawRect;
+
+    if (context->target == NK_DRAW_TARGET_CPU)
+    {
+        if (context->partialRedraw)
+        {
+            nvgCPUClearRect(context->nvgContext, nvgRGBAf(color.r, color.g, color.b, color.a), (int)rect.x, (int)rect.y, (int)rect.width, (int)rect.height);
+        }
+        else
+        {
+            nvgCPUClear(context->nvgContext, nvgRGBAf(color.r, color.g, color.b, color.a));
+        }
+
+        return;
+    }
+
+    if (context->partialRedraw)
+    {
+        /* NanoVG leaves GL scissoring off, and flushes after this */
+        glEnable(GL_SCISSOR_TEST);
+        glScissor((GLint)rect.x, (GLint)(ceilf(context->viewHeight) - rect.y - rect.height), (GLsizei)rect.width, (GLsizei)rect.height);
+    }
+
+    glClearColor(color.r, color.g, color.b, color.a);
+    glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+    if (context->partialRedraw)
+    {
+        glDisable(GL_SCISSOR_TEST);
+    }
+}
+
+void nkDraw_Invalidate(nkDrawContext_t *context, nkRect_t rect)
+{
+    context->damageRect = nkRect_Union(context->damageRect, rect);
+}
+
+const uint8_t *nkDraw_GetPixels(nkDrawContext_t *context, size_t *width, size_t *height, size_t *stride)
+{
+    if (context->target != NK_DRAW_TARGET_CPU || !context->pixels)
+    {
+        return NULL;
+    }
+
+    if (width)
+    {
+        *width = context->pixelWidth;
+    }
+
+    if (height)
+    {
+        *height = context->pixelHeight;
+    }
+
+    if (stride)
+    {
+        *stride = context->pixelWidth * 4;
+    }
+
+    return context->pixels;
+}
+
+void nkDraw_GetFrameStats(nkDrawContext_t *context, nkDrawFrameStats_t *stats)
+{
+    *stats = context->frameStats;
+}
+
+void nkDraw_GetMemoryStats(nkDrawContext_t *context, nkDrawMemoryStats_t *stats)
+{
+    *stats = context->memoryStats;
+    stats->imageTextureBytes = context->images.textureBytes;
+    stats->imageStagedBytes = context->images.stagedBytes;
+}
+
+void nkDraw_GetTextCacheStats(nkDrawContext_t *context, nkDrawTextCacheStats_t *stats)
+{
+    nkTextCacheStats_t text;
+    nkTextCacheStats_t runs;
+
+    nkTextCache_GetStats(&context->textCache, &text);
+    nkTextCache_GetStats(&context->runCache, &runs);
+
+    stats->hits = text.hits;
+    stats->misses = text.misses;
+    stats->entries = text.entries;
+    stats->capacity = text.capacity;
+
+    stats->runHits = runs.hits;
+    stats->runMisses = runs.misses;
+    stats->runEntries = runs.entries;
+    stats->runCapacity = runs.capacity;
+}
+
+void nkDraw_GetGlyphAtlasStats(nkDrawContext_t *context, nkDrawGlyphAtlasStats_t *stats)
+{
+    NVGtextAtlasStats atlas;
+
+    nvgTextAtlasStats(context->nvgContext, &atlas);
+
+    stats->width = (uint32_t)atlas.width;
+    stats->height = (uint32_t)atlas.height;
+    stats->glyphs = (uint32_t)atlas.glyphs;
+    stats->occupancy = atlas.width > 0 && atlas.height > 0 ? (float)atlas.usedPixels / ((float)atlas.width * (float)atlas.height) : 0.0f;
+    stats->rasterizations = (uint64_t)atlas.rasterizations;
+    stats->evictions = (uint64_t)atlas.evictions;
+    stats->resets = (uint32_t)atlas.resets;
+    stats->generation = (uint32_t)atlas.generation;
+    stats->pending = (uint32_t)atlas.pending;
 }
 
 void nkDraw_SaveContext(nkDrawContext_t *context)
 {
     nvgSave(context->nvgContext);
+
+    if (context->stateCount < NK_DRAW_MAX_STATES)
+    {
+        context->states[context->stateCount] = context->states[context->stateCount - 1];
+        context->stateCount++;
+    }
 }
 
 void nkDraw_RestoreContext(nkDrawContext_t *context)
 {
     nvgRestore(context->nvgContext);
+
+    context->appliedFaceId = -1;
+    context->appliedFontSize = 0.0f;
+
+    if (context->stateCount > 1)
+    {
+        context->stateCount--;
+    }
 }
 
 void nkDraw_SetClipRect(nkDrawContext_t *context, nkRect_t clipRect)
 {
+    nkDrawState_t *state = &context->states[context->stateCount - 1];
+
     nvgIntersectScissor(context->nvgContext, clipRect.x, clipRect.y, clipRect.width, clipRect.height);
+
+    /* the clip without the redraw rect, which lists must not capture */
+    state->clipRect = state->clipEnabled ? nkRect_Intersection(state->clipRect, clipRect) : clipRect;
+    state->clipEnabled = true;
 }
 
 void nkDraw_SetColor(nkDrawContext_t *context, nkVector4_t color)
 {
     nvgFillColor(context->nvgContext, nvgRGBAf(color.r, color.g, color.b, color.a));
+
+    context->states[context->stateCount - 1].fill = (nkDrawPaint_t){ .colorStart = color, .colorEnd = color };
 }
 
 /* angle in radians, clockwise from vertical */
@@ -147,7 +611,12 @@ void nkDraw_SetColorGradient(nkDrawContext_t *context, nkVector4_t colorStart, n
     );
     
     nvgFillPaint(context->nvgContext, paint);
-    
+
+    context->states[context->stateCount - 1].fill = (nkDrawPaint_t){
+        .colorStart = colorStart, .colorEnd = colorEnd,
+        .x0 = x0, .y0 = y0, .x1 = x1, .y1 = y1,
+        .gradient = true
+    };
 }
 
 void nkDraw_SetStrokeColor(nkDrawContext_t *context, nkVector4_t color)
@@ -187,59 +656,1038 @@ void nkDraw_SetStrokeColorGradient(nkDrawContext_t *context, nkVector4_t colorSt
 void nkDraw_SetStrokeWidth(nkDrawContext_t *context, float width)
 {
     nvgStrokeWidth(context->nvgContext, width);
+
+    context->states[context->stateCount - 1].strokeWidth = width;
 }
 
 
-void nkDraw_Text(nkDrawContext_t* context, nkFont_t* newFont, const char* text, float x, float y)
+void nkDraw_SetGlyphMode(nkDrawContext_t *context, nkDrawGlyphMode_t mode)
 {
-    nvgBeginPath(context->nvgContext);
-    
-    nvgFontSize(context->nvgContext, 14.0f);
-    nvgFontFace(context->nvgContext, "sans");
+    nvgTextDeferred(context->nvgContext, mode == NK_DRAW_GLYPHS_DEFER);
 
-    nvgText(context->nvgContext, x, y, text, NULL);
+    context->states[context->stateCount - 1].glyphMode = mode;
 }
 
-void nkDraw_Rect(nkDrawContext_t* context, float x, float y, float w, float h)
+void nkDraw_PrewarmGlyphs(nkDrawContext_t *context, nkFont_t *font, uint32_t first, uint32_t last, const float *sizes, size_t sizeCount)
 {
-    nvgBeginPath(context->nvgContext);
-    nvgRect(context->nvgContext, x, y, w, h);
-    nvgFill(context->nvgContext);
+    if (!font)
+    {
+        font = &context->defaultFont;
+    }
+
+    if (!sizes)
+    {
+        sizes = &font->fontSize;
+        sizeCount = 1;
+    }
+
+    /* glyphs as untransformed text draws them, in or out of a frame */
+    nvgSave(context->nvgContext);
+    nvgResetTransform(context->nvgContext);
+    nvgFontBlur(context->nvgContext, 0.0f);
+    nvgFontSDF(context->nvgContext, context->sdfText);
+    nvgFontFaceId(context->nvgContext, font->faceId >= 0 ? font->faceId : context->defaultFont.faceId);
+
+    for (size_t i = 0; i < sizeCount; i++)
+    {
+        nvgFontSize(context->nvgContext, sizes[i]);
+        nvgTextPrewarm(context->nvgContext, first, last);
+    }
+
+    nvgRestore(context->nvgContext);
 }
 
-void nkDraw_RoundedRect(nkDrawContext_t* context, float x, float y, float w, float h, float radius)
+bool nkDraw_SaveGlyphCache(nkDrawContext_t *context, const char *path)
 {
-    nvgBeginPath(context->nvgContext);
-    nvgRoundedRect(context->nvgContext, x, y, w, h, radius);
-    
-    nvgFill(context->nvgContext);
+    int size = nvgSaveGlyphCache(context->nvgContext, NULL, 0);
+    uint8_t *data = (uint8_t*)malloc((size_t)size);
+
+    if (!data)
+    {
+        fprintf(stderr, "ERROR: Failed to allocate %d bytes for the glyph cache.\n", size);
+        return false;
+    }
+
+    nvgSaveGlyphCache(context->nvgContext, data, size);
+
+    FILE *file = fopen(path, "wb");
+    bool written = file && fwrite(data, 1, (size_t)size, file) == (size_t)size;
+
+    if (file && fclose(file) != 0)
+    {
+        written = false;
+    }
+
+    if (!written)
+    {
+        fprintf(stderr, "ERROR: Failed to write glyph cache %s.\n", path);
+    }
+
+    free(data);
+    return written;
 }
 
-void nkDraw_RoundedRectPath(nkDrawContext_t* context, float x, float y, float w, float h, float radius)
+bool nkDraw_LoadGlyphCache(nkDrawContext_t *context, const char *path)
 {
-    nvgBeginPath(context->nvgContext);
-    nvgRoundedRect(context->nvgContext, x, y, w, h, radius);
-    
-    nvgStroke(context->nvgContext);
+    nkFileMap_t file;
+
+    if (!nkFileMap_Open(&file, path))
+    {
+        return false;
+    }
+
+    return nkDraw_UseGlyphCache(context, file.data, file.size, &file);
 }
 
-nkRect_t nkDraw_MeasureText(nkDrawContext_t* context, nkFont_t* font, const char* text)
+bool nkDraw_LoadGlyphCacheFromMemory(nkDrawContext_t *context, const uint8_t *data, size_t size)
 {
-    float bounds[4] = {0};
+    return nkDraw_UseGlyphCache(context, data, size, NULL);
+}
+
+void nkDraw_Text(nkDrawContext_t* context, nkFont_t* font, const char* text, float x, float y)
+{
+    nvgBeginPath(context->nvgContext);
+
+    if (!text)
+    {
+        return;
+    }
+
+    if (!font)
+    {
+        font = &context->defaultFont;
+    }
+
+    nkRect_t bounds = nkDraw_MeasureText(context, font, text);
+
+    if (nkDraw_IsCulled(context, x + bounds.x, y + bounds.y, bounds.width, bounds.height, 1.0f))
+    {
+        return;
+    }
     
-    nvgFontSize(context->nvgContext, 14.0f);
-    nvgFontFace(context->nvgContext, "sans");
+    nkDraw_ApplyFont(context, font);
 
-    nvgTextBounds(context->nvgContext, 0.0f, 0.0f, text, NULL, bounds);
+    /* glyph quads are laid out once in local space and replayed translated until
+    ** NanoVG evicts, moves or resets glyphs in its font atlas. the run buffer holds the
+    ** vertices followed by one atlas slot per glyph, touched on every draw so the glyphs
+    ** stay resident while the frame references them */
+    int faceId = font->faceId >= 0 ? font->faceId : context->defaultFont.faceId;
+    int skipped = nvgTextSkippedGlyphs(context->nvgContext);
+    uint32_t generation = (uint32_t)nvgTextAtlasGeneration(context->nvgContext);
+    size_t length = strlen(text);
+    uint64_t hash = nkTextCache_Hash(text);
+    nkTextCacheEntry_t *entry = nkTextCache_Lookup(&context->runCache, hash, text, length, faceId, font->fontSize, generation);
 
-    return (nkRect_t) {
-        .x = bounds[0],
-        .y = bounds[1],
-        .width = bounds[2] - bounds[0],
-        .height = bounds[3] - bounds[1]
-    };
-}
+    if (!entry)
+    {
+        entry = nkTextCache_Insert(&context->runCache, hash, text, length, faceId, font->fontSize, generation);
+    }
+    else if (entry->generation != generation)
+    {
+        entry->generation = generation;
+        entry->runCount = 0;
+    }
 
-/***************************************************************
-** MARK: STATIC FUNCTIONS
-***************************************************************/
+    if (entry && entry->runCount == 0)
+    {
+        size_t maxVerts = length * 6;
+
+        if (maxVerts > entry->runCapacity)
+        {
+            void *run = realloc(entry->run, maxVerts * sizeof(NVGvertex) + (maxVerts / 6) * sizeof(int));
+
+            if (run)
+            {
+                entry->run = run;
+                entry->runCapacity = (uint32_t)maxVerts;
+            }
+        }
+
+        if (maxVerts <= entry->runCapacity)
+        {
+            int *slots = (int*)((NVGvertex*)entry->run + entry->runCapacity);
+
+            entry->runCount = (uint32_t)nvgTextRun(context->nvgContext, text, NULL, (NVGvertex*)entry->run, slots, (int)maxVerts);
+
+            /* glyphs evicted while laying out were none of this run's */
+            entry->generation = (uint32_t)nvgTextAtlasGeneration(context->nvgContext);
+        }
+        else
+        {
+            entry = NULL;
+        }
+    }
+
+    if (!entry)
+    {
+        nvgText(context->nvgContext, x, y, text, NULL);
+    }
+    else
+    {
+        nvgTextRunDraw(context->nvgContext, x, y, (const NVGvertex*)entry->run, (const int*)((NVGvertex*)entry->run + entry->runCapacity), (int)entry->runCount);
+    }
+
+    /* deferred glyphs were left out, lay the text out again and redraw it once they land */
+    if (nvgTextSkippedGlyphs(context->nvgContext) != skipped)
+    {
+        if (entry)
+        {
+            entry->runCount = 0;
+        }
+
+        if (context->partialRedraw)
+        {
+            nkDraw_Invalidate(context, (nkRect_t){ x + bounds.x - 1.0f, y + bounds.y - 1.0f, bounds.width + 2.0f, bounds.height + 2.0f });
+        }
+    }
+}
+
+bool nkDraw_LoadImage(nkDrawContext_t *context, nkImage_t *image, const char *path)
+{
+    image->id = nkImageTable_LoadFile(&context->images, path);
+    return image->id != 0;
+}
+
+bool nkDraw_LoadImageFromMemory(nkDrawContext_t *context, nkImage_t *image, const uint8_t *data, size_t size)
+{
+    image->id = nkImageTable_LoadMemory(&context->images, data, size);
+    return image->id != 0;
+}
+
+void nkDraw_FreeImage(nkDrawContext_t *context, nkImage_t *image)
+{
+    if (image)
+    {
+        nkImageTable_Free(&context->images, image->id);
+        image->id = 0;
+    }
+}
+
+nkImageState_t nkDraw_GetImageState(nkDrawContext_t *context, const nkImage_t *image, uint32_t *width, uint32_t *height)
+{
+    return nkImageTable_GetState(&context->images, image ? image->id : 0, width, height);
+}
+
+void nkDraw_GetImageMemory(nkDrawContext_t *context, const nkImage_t *image, nkDrawImageMemory_t *memory)
+{
+    nkImageTable_GetMemory(&context->images, image ? image->id : 0, memory);
+}
+
+void nkDraw_Image(nkDrawContext_t *context, const nkImage_t *image, float x, float y, float w, float h)
+{
+    bool pending = false;
+    const nkImageRecord_t *record = nkImageTable_Draw(&context->images, image ? image->id : 0, w, h, &pending);
+
+    if (!record)
+    {
+        return;
+    }
+
+    /* redraw the rect once the upload lands, or its next mipmap level does */
+    if (pending && context->partialRedraw)
+    {
+        nkDraw_Invalidate(context, (nkRect_t){ x, y, w, h });
+    }
+
+    if (record->state != NK_IMAGE_READY)
+    {
+        return;
+    }
+
+    if (nkDraw_IsCulled(context, x, y, w, h, 1.0f))
+    {
+        return;
+    }
+
+    /* textured triangles like glyphs, so consecutive images of one atlas page merge */
+    nvgImageQuad(context->nvgContext, x, y, w, h, (int)record->texture, record->u0, record->v0, record->u1, record->v1, 1.0f);
+}
+
+void nkDraw_Rect(nkDrawContext_t* context, float x, float y, float w, float h)
+{
+    if (nkDraw_IsCulled(context, x, y, w, h, 1.0f))
+    {
+        return;
+    }
+
+    nvgBeginPath(context->nvgContext);
+    nvgRect(context->nvgContext, x, y, w, h);
+    nvgFill(context->nvgContext);
+}
+
+void nkDraw_RoundedRect(nkDrawContext_t* context, float x, float y, float w, float h, float radius)
+{
+    nkDraw_RoundedRectVarying(context, x, y, w, h, radius, radius, radius, radius);
+}
+
+void nkDraw_RoundedRectPath(nkDrawContext_t* context, float x, float y, float w, float h, float radius)
+{
+    if (nkDraw_IsCulled(context, x, y, w, h, context->states[context->stateCount - 1].strokeWidth + 1.0f))
+    {
+        return;
+    }
+
+    nvgBeginPath(context->nvgContext);
+    nvgRoundedRect(context->nvgContext, x, y, w, h, radius);
+    
+    nvgStroke(context->nvgContext);
+}
+
+void nkDraw_RoundedRectVarying(nkDrawContext_t* context, float x, float y, float w, float h, float radiusTopLeft, float radiusTopRight, float radiusBottomRight, float radiusBottomLeft)
+{
+    const nkDrawPaint_t *fill = &context->states[context->stateCount - 1].fill;
+
+    if (nkDraw_IsCulled(context, x, y, w, h, 1.0f))
+    {
+        return;
+    }
+
+    if (!fill->gradient && radiusTopLeft == radiusTopRight && radiusTopLeft == radiusBottomRight && radiusTopLeft == radiusBottomLeft)
+    {
+        /* a one pixel feathered box gradient is the rounded-box SDF evaluated per
+        ** fragment, so a solid fill only needs a rect grown by the feather */
+        NVGcolor color = nvgRGBAf(fill->colorStart.r, fill->colorStart.g, fill->colorStart.b, fill->colorStart.a);
+        NVGcolor clear = nvgRGBAf(fill->colorStart.r, fill->colorStart.g, fill->colorStart.b, 0.0f);
+        float radius = fmaxf(0.0f, fminf(radiusTopLeft, 0.5f * fminf(w, h)));
+
+        nvgBeginPath(context->nvgContext);
+        nvgRect(context->nvgContext, x - 1.0f, y - 1.0f, w + 2.0f, h + 2.0f);
+        nvgFillPaint(context->nvgContext, nvgBoxGradient(context->nvgContext, x, y, w, h, radius, 1.0f, color, clear));
+        nvgFill(context->nvgContext);
+
+        nvgFillColor(context->nvgContext, color);
+        return;
+    }
+
+    nvgBeginPath(context->nvgContext);
+    nvgRoundedRectVarying(context->nvgContext, x, y, w, h, radiusTopLeft, radiusTopRight, radiusBottomRight, radiusBottomLeft);
+    
+    nvgFill(context->nvgContext);
+}
+
+void nkDraw_RoundedRectPathVarying(nkDrawContext_t* context, float x, float y, float w, float h, float radiusTopLeft, float radiusTopRight, float radiusBottomRight, float radiusBottomLeft)
+{
+    if (nkDraw_IsCulled(context, x, y, w, h, context->states[context->stateCount - 1].strokeWidth + 1.0f))
+    {
+        return;
+    }
+
+    nvgBeginPath(context->nvgContext);
+    nvgRoundedRectVarying(context->nvgContext, x, y, w, h, radiusTopLeft, radiusTopRight, radiusBottomRight, radiusBottomLeft);
+    
+    nvgStroke(context->nvgContext);
+}
+
+nkRect_t nkDraw_MeasureText(nkDrawContext_t* context, nkFont_t* font, const char* text)
+{
+    float bounds[4] = {0};
+    nkRect_t measured;
+
+    if (!font)
+    {
+        font = &context->defaultFont;
+    }
+
+    int faceId = font->faceId >= 0 ? font->faceId : context->defaultFont.faceId;
+    size_t length = text ? strlen(text) : 0;
+    uint64_t hash = nkTextCache_Hash(text);
+    nkTextCacheEntry_t *entry = nkTextCache_Lookup(&context->textCache, hash, text, length, faceId, font->fontSize, 0);
+
+    if (entry)
+    {
+        return entry->bounds;
+    }
+    
+    nkDraw_ApplyFont(context, font);
+
+    nvgTextBounds(context->nvgContext, 0.0f, 0.0f, text, NULL, bounds);
+
+    measured = (nkRect_t) {
+        .x = bounds[0],
+        .y = bounds[1],
+        .width = bounds[2] - bounds[0],
+        .height = bounds[3] - bounds[1]
+    };
+
+    entry = nkTextCache_Insert(&context->textCache, hash, text, length, faceId, font->fontSize, 0);
+
+    if (entry)
+    {
+        entry->bounds = measured;
+    }
+
+    return measured;
+}
+
+int nkDraw_RegisterFontFace(nkDrawContext_t *context, const char *name, const uint8_t *data, size_t dataSize)
+{
+    nkDrawFontFace_t *face = nkDraw_FindFontFace(context, name);
+
+    if (face)
+    {
+        return face->faceId;
+    }
+
+    if (context->fontFaceCount >= NK_DRAW_MAX_FONT_FACES || strlen(name) >= NK_DRAW_FONT_NAME_LENGTH)
+    {
+        fprintf(stderr, "ERROR: Cannot register font face '%s'.\n", name);
+        return -1;
+    }
+
+    int faceId = nvgCreateFontMem(context->nvgContext, name, (unsigned char*)data, (int)dataSize, 0);
+
+    if (faceId == -1)
+    {
+        return -1;
+    }
+
+    face = &context->fontFaces[context->fontFaceCount++];
+    strcpy(face->name, name);
+    face->data = data;
+    face->dataSize = dataSize;
+    face->source = NULL;
+    face->faceId = faceId;
+
+    if (context->glyphCache)
+    {
+        nvgLoadGlyphCache(context->nvgContext, context->glyphCache, (int)context->glyphCacheSize, faceId);
+    }
+
+    return faceId;
+}
+
+int nkDraw_RegisterFontFile(nkDrawContext_t *context, const char *name, const char *path)
+{
+    nkDrawFontFace_t *face = nkDraw_FindFontFace(context, name);
+
+    if (face)
+    {
+        return face->faceId;
+    }
+
+    nkFontSource_t *source = nkFontSource_Acquire(path);
+
+    if (!source)
+    {
+        return -1;
+    }
+
+    int faceId = nkDraw_RegisterFontFace(context, name, source->data, source->size);
+
+    if (faceId == -1)
+    {
+        nkFontSource_Release(source);
+        return -1;
+    }
+
+    /* the context keeps its reference for as long as the face is registered */
+    context->fontFaces[context->fontFaceCount - 1].source = source;
+
+    return faceId;
+}
+
+bool nkDraw_LoadFont(nkDrawContext_t *context, nkFont_t *font, const char *name, float fontSize)
+{
+    nkDrawFontFace_t *face = nkDraw_FindFontFace(context, name);
+
+    if (!face)
+    {
+        fprintf(stderr, "ERROR: Font face '%s' is not registered.\n", name);
+        return false;
+    }
+
+    /* fontstash rasterises on demand, there is no baked atlas to fill */
+    memset(font, 0, sizeof(*font));
+    font->faceId = face->faceId;
+    font->fontSize = fontSize;
+
+    nkDraw_ApplyFont(context, font);
+    nvgTextMetrics(context->nvgContext, &font->ascent, &font->descent, NULL);
+
+    return true;
+}
+
+void nkDraw_BeginList(nkDrawContext_t *context, nkDrawList_t *list)
+{
+    NVGparams *params = nvgInternalParams(context->nvgContext);
+
+    if (context->recordingList)
+    {
+        nkDraw_EndList(context);
+    }
+
+    list->commandCount = 0;
+    list->pathCount = 0;
+    list->vertexCount = 0;
+
+    free(list->replayVertices);
+    list->replayVertices = NULL;
+
+    /* route the renderer through the recorder, texture traffic still reaches the backend */
+    context->recordingList = list;
+    context->recordingParams = *params;
+
+    /* lists outlive the frame's redraw rect, record with the caller's clip alone */
+    if (context->partialRedraw)
+    {
+        const nkDrawState_t *state = &context->states[context->stateCount - 1];
+
+        nvgSave(context->nvgContext);
+        nvgResetScissor(context->nvgContext);
+
+        if (state->clipEnabled)
+        {
+            nvgScissor(context->nvgContext, state->clipRect.x, state->clipRect.y, state->clipRect.width, state->clipRect.height);
+        }
+    }
+
+    params->userPtr = context;
+    params->renderCreateTexture = nkDraw_ForwardCreateTexture;
+    params->renderDeleteTexture = nkDraw_ForwardDeleteTexture;
+    params->renderUpdateTexture = nkDraw_ForwardUpdateTexture;
+    params->renderGetTextureSize = nkDraw_ForwardGetTextureSize;
+    params->renderViewport = nkDraw_ForwardViewport;
+    params->renderCreateTextureLevels = params->renderCreateTextureLevels ? nkDraw_ForwardCreateTextureLevels : NULL;
+    params->renderUpdateTextureLevel = params->renderUpdateTextureLevel ? nkDraw_ForwardUpdateTextureLevel : NULL;
+    params->renderCancel = nkDraw_ForwardCancel;
+    params->renderFlush = nkDraw_ForwardFlush;
+    params->renderFill = nkDraw_RecordFill;
+    params->renderStroke = nkDraw_RecordStroke;
+    params->renderTriangles = nkDraw_RecordTriangles;
+}
+
+void nkDraw_EndList(nkDrawContext_t *context)
+{
+    if (!context->recordingList)
+    {
+        return;
+    }
+
+    *nvgInternalParams(context->nvgContext) = context->recordingParams;
+    context->recordingList = NULL;
+
+    /* the restore also puts back NanoVG's font from before the list */
+    if (context->partialRedraw)
+    {
+        nvgRestore(context->nvgContext);
+
+        context->appliedFaceId = -1;
+        context->appliedFontSize = 0.0f;
+    }
+}
+
+void nkDraw_ReplayList(nkDrawContext_t *context, nkDrawList_t *list, float dx, float dy)
+{
+    NVGparams *params = nvgInternalParams(context->nvgContext);
+    NVGvertex *vertices = (NVGvertex*)list->vertices;
+    NVGpath *paths = (NVGpath*)list->paths;
+    size_t i;
+
+    if (list == context->recordingList || list->commandCount == 0)
+    {
+        return;
+    }
+
+    if (dx != 0.0f || dy != 0.0f)
+    {
+        if (!list->replayVertices)
+        {
+            list->replayVertices = malloc(list->vertexCapacity * sizeof(NVGvertex));
+
+            if (!list->replayVertices)
+            {
+                return;
+            }
+        }
+
+        NVGvertex *translated = (NVGvertex*)list->replayVertices;
+
+        for (i = 0; i < list->vertexCount; i++)
+        {
+            translated[i].x = vertices[i].x + dx;
+            translated[i].y = vertices[i].y + dy;
+            translated[i].u = vertices[i].u;
+            translated[i].v = vertices[i].v;
+        }
+
+        nkDraw_ListRebasePaths(list, vertices, translated);
+        vertices = translated;
+    }
+
+    for (i = 0; i < list->commandCount; i++)
+    {
+        nkDrawListCommand_t *command = &((nkDrawListCommand_t*)list->commands)[i];
+        NVGpaint paint = command->paint;
+        NVGscissor scissor = command->scissor;
+
+        paint.xform[4] += dx;
+        paint.xform[5] += dy;
+        scissor.xform[4] += dx;
+        scissor.xform[5] += dy;
+
+        if (context->partialRedraw)
+        {
+            nkDraw_ClipToRedraw(context, &scissor);
+        }
+
+        switch (command->type)
+        {
+            case NK_DRAW_LIST_FILL:
+            {
+                float bounds[4] = {
+                    command->bounds[0] + dx, command->bounds[1] + dy,
+                    command->bounds[2] + dx, command->bounds[3] + dy
+                };
+
+                params->renderFill(params->userPtr, &paint, command->compositeOperation, &scissor, command->fringe,
+                                   bounds, &paths[command->pathOffset], (int)command->pathCount);
+                break;
+            }
+            case NK_DRAW_LIST_STROKE:
+            {
+                params->renderStroke(params->userPtr, &paint, command->compositeOperation, &scissor, command->fringe,
+                                     command->strokeWidth, &paths[command->pathOffset], (int)command->pathCount);
+                break;
+            }
+            case NK_DRAW_LIST_TRIANGLES:
+            {
+                params->renderTriangles(params->userPtr, &paint, command->compositeOperation, &scissor,
+                                        &vertices[command->vertexOffset], (int)command->vertexCount, command->fringe, command->sdfEdge);
+                break;
+            }
+        }
+    }
+
+    if (vertices != (NVGvertex*)list->vertices)
+    {
+        nkDraw_ListRebasePaths(list, vertices, (NVGvertex*)list->vertices);
+    }
+}
+
+void nkDrawList_Free(nkDrawList_t *list)
+{
+    free(list->commands);
+    free(list->paths);
+    free(list->vertices);
+    free(list->replayVertices);
+
+    memset(list, 0, sizeof(*list));
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static nkDrawFontFace_t *nkDraw_FindFontFace(nkDrawContext_t *context, const char *name)
+{
+    size_t i;
+
+    for (i = 0; i < context->fontFaceCount; i++)
+    {
+        if (strcmp(context->fontFaces[i].name, name) == 0)
+        {
+            return &context->fontFaces[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* fonts without a registry face (baked with nkFont_Load) use the default face at their size */
+static void nkDraw_ApplyFont(nkDrawContext_t *context, const nkFont_t *font)
+{
+    int faceId = font->faceId >= 0 ? font->faceId : context->defaultFont.faceId;
+
+    if (faceId != context->appliedFaceId)
+    {
+        nvgFontFaceId(context->nvgContext, faceId);
+        context->appliedFaceId = faceId;
+    }
+
+    if (font->fontSize != context->appliedFontSize)
+    {
+        nvgFontSize(context->nvgContext, font->fontSize);
+        context->appliedFontSize = font->fontSize;
+    }
+}
+
+static bool nkDraw_ListReserve(void **buffer, size_t *capacity, size_t required, size_t elementSize)
+{
+    if (required <= *capacity)
+    {
+        return true;
+    }
+
+    size_t newCapacity = *capacity ? *capacity : 64;
+
+    while (newCapacity < required)
+    {
+        newCapacity *= 2;
+    }
+
+    void *newBuffer = realloc(*buffer, newCapacity * elementSize);
+
+    if (!newBuffer)
+    {
+        return false;
+    }
+
+    *buffer = newBuffer;
+    *capacity = newCapacity;
+
+    return true;
+}
+
+static bool nkDraw_ListReserveVertices(nkDrawList_t *list, size_t count)
+{
+    NVGvertex *previous = (NVGvertex*)list->vertices;
+
+    if (!nkDraw_ListReserve(&list->vertices, &list->vertexCapacity, list->vertexCount + count, sizeof(NVGvertex)))
+    {
+        return false;
+    }
+
+    /* recorded paths point into the vertex array, follow it if it moved */
+    if (previous && previous != (NVGvertex*)list->vertices)
+    {
+        nkDraw_ListRebasePaths(list, previous, (NVGvertex*)list->vertices);
+    }
+
+    return true;
+}
+
+static nkDrawListCommand_t *nkDraw_ListAppendCommand(nkDrawList_t *list, nkDrawListCommandType_t type, NVGpaint *paint, NVGcompositeOperationState compositeOperation, NVGscissor *scissor, float fringe)
+{
+    if (!nkDraw_ListReserve(&list->commands, &list->commandCapacity, list->commandCount + 1, sizeof(nkDrawListCommand_t)))
+    {
+        return NULL;
+    }
+
+    nkDrawListCommand_t *command = &((nkDrawListCommand_t*)list->commands)[list->commandCount++];
+
+    memset(command, 0, sizeof(*command));
+    command->type = type;
+    command->paint = *paint;
+    command->compositeOperation = compositeOperation;
+    command->scissor = *scissor;
+    command->fringe = fringe;
+
+    return command;
+}
+
+static void nkDraw_ListAppendPaths(nkDrawList_t *list, nkDrawListCommand_t *command, const NVGpath *paths, int npaths)
+{
+    size_t vertexCount = 0;
+    int i;
+
+    for (i = 0; i < npaths; i++)
+    {
+        vertexCount += (size_t)(paths[i].nfill + paths[i].nstroke);
+    }
+
+    /* command may move with the command array, keep its index instead */
+    size_t commandIndex = (size_t)(command - (nkDrawListCommand_t*)list->commands);
+
+    if (!nkDraw_ListReserve(&list->paths, &list->pathCapacity, list->pathCount + (size_t)npaths, sizeof(NVGpath)) ||
+        !nkDraw_ListReserveVertices(list, vertexCount))
+    {
+        list->commandCount = commandIndex;
+        return;
+    }
+
+    command->pathOffset = list->pathCount;
+    command->pathCount = (size_t)npaths;
+
+    for (i = 0; i < npaths; i++)
+    {
+        NVGpath *copy = &((NVGpath*)list->paths)[list->pathCount++];
+        NVGvertex *vertices = &((NVGvertex*)list->vertices)[list->vertexCount];
+
+        *copy = paths[i];
+        copy->fill = NULL;
+        copy->stroke = NULL;
+
+        if (paths[i].nfill > 0)
+        {
+            memcpy(vertices, paths[i].fill, sizeof(NVGvertex) * (size_t)paths[i].nfill);
+            copy->fill = vertices;
+            vertices += paths[i].nfill;
+        }
+
+        if (paths[i].nstroke > 0)
+        {
+            memcpy(vertices, paths[i].stroke, sizeof(NVGvertex) * (size_t)paths[i].nstroke);
+            copy->stroke = vertices;
+        }
+
+        list->vertexCount += (size_t)(paths[i].nfill + paths[i].nstroke);
+    }
+}
+
+static void nkDraw_ListRebasePaths(nkDrawList_t *list, NVGvertex *from, NVGvertex *to)
+{
+    NVGpath *paths = (NVGpath*)list->paths;
+    size_t i;
+
+    for (i = 0; i < list->pathCount; i++)
+    {
+        if (paths[i].fill)
+        {
+            paths[i].fill = to + ((uintptr_t)paths[i].fill - (uintptr_t)from) / sizeof(NVGvertex);
+        }
+
+        if (paths[i].stroke)
+        {
+            paths[i].stroke = to + ((uintptr_t)paths[i].stroke - (uintptr_t)from) / sizeof(NVGvertex);
+        }
+    }
+}
+
+static int nkDraw_ForwardCreateTexture(void *uptr, int type, int w, int h, int imageFlags, const unsigned char *data)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)uptr;
+    return context->recordingParams.renderCreateTexture(context->recordingParams.userPtr, type, w, h, imageFlags, data);
+}
+
+static int nkDraw_ForwardDeleteTexture(void *uptr, int image)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)uptr;
+    return context->recordingParams.renderDeleteTexture(context->recordingParams.userPtr, image);
+}
+
+static int nkDraw_ForwardUpdateTexture(void *uptr, int image, int x, int y, int w, int h, const unsigned char *data)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)uptr;
+    return context->recordingParams.renderUpdateTexture(context->recordingParams.userPtr, image, x, y, w, h, data);
+}
+
+static int nkDraw_ForwardGetTextureSize(void *uptr, int image, int *w, int *h)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)uptr;
+    return context->recordingParams.renderGetTextureSize(context->recordingParams.userPtr, image, w, h);
+}
+
+static void nkDraw_ForwardViewport(void *uptr, float width, float height, float devicePixelRatio)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)uptr;
+    context->recordingParams.renderViewport(context->recordingParams.userPtr, width, height, devicePixelRatio);
+}
+
+static int nkDraw_ForwardCreateTextureLevels(void *uptr, int w, int h, int nlevels, int imageFlags)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)uptr;
+    return context->recordingParams.renderCreateTextureLevels(context->recordingParams.userPtr, w, h, nlevels, imageFlags);
+}
+
+static int nkDraw_ForwardUpdateTextureLevel(void *uptr, int image, int level, const unsigned char *data)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)uptr;
+    return context->recordingParams.renderUpdateTextureLevel(context->recordingParams.userPtr, image, level, data);
+}
+
+static void nkDraw_ForwardCancel(void *uptr)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)uptr;
+    context->recordingParams.renderCancel(context->recordingParams.userPtr);
+}
+
+static void nkDraw_ForwardFlush(void *uptr)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)uptr;
+    context->recordingParams.renderFlush(context->recordingParams.userPtr);
+}
+
+static void nkDraw_RecordFill(void *uptr, NVGpaint *paint, NVGcompositeOperationState compositeOperation, NVGscissor *scissor, float fringe, const float *bounds, const NVGpath *paths, int npaths)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)uptr;
+    nkDrawListCommand_t *command = nkDraw_ListAppendCommand(context->recordingList, NK_DRAW_LIST_FILL, paint, compositeOperation, scissor, fringe);
+
+    if (command)
+    {
+        memcpy(command->bounds, bounds, sizeof(command->bounds));
+        nkDraw_ListAppendPaths(context->recordingList, command, paths, npaths);
+    }
+}
+
+static void nkDraw_RecordStroke(void *uptr, NVGpaint *paint, NVGcompositeOperationState compositeOperation, NVGscissor *scissor, float fringe, float strokeWidth, const NVGpath *paths, int npaths)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)uptr;
+    nkDrawListCommand_t *command = nkDraw_ListAppendCommand(context->recordingList, NK_DRAW_LIST_STROKE, paint, compositeOperation, scissor, fringe);
+
+    if (command)
+    {
+        command->strokeWidth = strokeWidth;
+        nkDraw_ListAppendPaths(context->recordingList, command, paths, npaths);
+    }
+}
+
+static void nkDraw_RecordTriangles(void *uptr, NVGpaint *paint, NVGcompositeOperationState compositeOperation, NVGscissor *scissor, const NVGvertex *verts, int nverts, float fringe, float sdfEdge)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)uptr;
+    nkDrawList_t *list = context->recordingList;
+    nkDrawListCommand_t *command = nkDraw_ListAppendCommand(list, NK_DRAW_LIST_TRIANGLES, paint, compositeOperation, scissor, fringe);
+
+    if (!command)
+    {
+        return;
+    }
+
+    size_t commandIndex = (size_t)(command - (nkDrawListCommand_t*)list->commands);
+
+    if (!nkDraw_ListReserveVertices(list, (size_t)nverts))
+    {
+        list->commandCount = commandIndex;
+        return;
+    }
+
+    command->vertexOffset = list->vertexCount;
+    command->vertexCount = (size_t)nverts;
+    command->sdfEdge = sdfEdge;
+
+    memcpy(&((NVGvertex*)list->vertices)[list->vertexCount], verts, sizeof(NVGvertex) * (size_t)nverts);
+    list->vertexCount += (size_t)nverts;
+}
+
+/* takes this frame's redraw rect from the invalidated ones, or the whole view if the target
+** lost its pixels. whole pixels keep the scissor edge from blending with the old frame. */
+static void nkDraw_BeginRedraw(nkDrawContext_t *context, float width, float height, bool intact)
+{
+    nkRect_t view = { .x = 0.0f, .y = 0.0f, .width = width, .height = height };
+    nkRect_t damage = nkRect_Intersection(intact ? context->damageRect : view, view);
+
+    float x0 = floorf(damage.x);
+    float y0 = floorf(damage.y);
+    float x1 = ceilf(damage.x + damage.width);
+    float y1 = ceilf(damage.y + damage.height);
+
+    context->redrawRect = nkRect_IsEmpty(damage) ? (nkRect_t){ 0 } : (nkRect_t){ .x = x0, .y = y0, .width = x1 - x0, .height = y1 - y0 };
+    context->damageRect = (nkRect_t){ 0 };
+}
+
+/* true when x, y, w, h grown by outset misses the view and the scissor, which holds the clip
+** rect and in partial frames the redraw rect. lists are replayed at other offsets and under
+** other scissors, so nothing is culled while recording. */
+static bool nkDraw_IsCulled(nkDrawContext_t *context, float x, float y, float w, float h, float outset)
+{
+    if (context->recordingList)
+    {
+        return false;
+    }
+
+    return nvgCullRect(context->nvgContext, x, y, w, h, outset) != 0;
+}
+
+/* intersects a recorded scissor with the redraw rect. nkDraw has no transforms, so
+** scissors are axis aligned: a centre in xform[4], xform[5] and half extents. */
+static void nkDraw_ClipToRedraw(nkDrawContext_t *context, NVGscissor *scissor)
+{
+    nkRect_t clip = context->redrawRect;
+
+    if (scissor->extent[0] >= 0.0f && scissor->extent[1] >= 0.0f)
+    {
+        nkRect_t recorded = {
+            .x = scissor->xform[4] - scissor->extent[0],
+            .y = scissor->xform[5] - scissor->extent[1],
+            .width = 2.0f * scissor->extent[0],
+            .height = 2.0f * scissor->extent[1]
+        };
+
+        clip = nkRect_Intersection(recorded, clip);
+    }
+
+    nvgTransformIdentity(scissor->xform);
+    scissor->xform[4] = clip.x + 0.5f * clip.width;
+    scissor->xform[5] = clip.y + 0.5f * clip.height;
+    scissor->extent[0] = 0.5f * clip.width;
+    scissor->extent[1] = 0.5f * clip.height;
+}
+
+/* nkThreadPoolTask_t, renders one glyph of the batch taken in nkDraw_End */
+static void nkDraw_RasterizeGlyph(void *user, size_t index)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)user;
+
+    nvgRasterizeGlyphJob(context->nvgContext, (int)index);
+}
+
+/* loads the glyphs of the registered faces from data and keeps it for faces registered later.
+** file, when given, backs data and is taken over, or closed if data is not a glyph cache */
+static bool nkDraw_UseGlyphCache(nkDrawContext_t *context, const uint8_t *data, size_t size, nkFileMap_t *file)
+{
+    int result = size <= INT_MAX ? nvgLoadGlyphCache(context->nvgContext, data, (int)size, -1) : -1;
+
+    if (result < 0)
+    {
+        fprintf(stderr, "ERROR: Invalid glyph cache.\n");
+
+        if (file)
+        {
+            nkFileMap_Close(file);
+        }
+
+        return false;
+    }
+
+    /* the glyphs of the previous cache were copied into the atlas */
+    nkFileMap_Close(&context->glyphCacheFile);
+
+    if (file)
+    {
+        context->glyphCacheFile = *file;
+    }
+
+    context->glyphCache = data;
+    context->glyphCacheSize = size;
+
+    return result == 1;
+}
+
+static uint32_t nkDraw_CreateImageTexture(void *user, uint32_t width, uint32_t height, const uint8_t *pixels)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)user;
+    return (uint32_t)nvgCreateImageRGBA(context->nvgContext, (int)width, (int)height, 0, pixels);
+}
+
+/* 0 on renderers without caller supplied levels, the table then takes the first level alone */
+static uint32_t nkDraw_CreateImageLevels(void *user, uint32_t width, uint32_t height, uint32_t levels)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)user;
+    return (uint32_t)nvgCreateImageLevels(context->nvgContext, (int)width, (int)height, (int)levels, 0);
+}
+
+static void nkDraw_UpdateImageLevel(void *user, uint32_t texture, uint32_t level, uint32_t width, uint32_t height, const uint8_t *pixels)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)user;
+    nvgUpdateImageLevel(context->nvgContext, (int)texture, (int)level, pixels);
+}
+
+/* NanoVG updates regions out of a whole-texture buffer, which is what the table hands over */
+static void nkDraw_UpdateImageRegion(void *user, uint32_t texture, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const uint8_t *page, uint32_t pageSize)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)user;
+    nvgUpdateImageRegion(context->nvgContext, (int)texture, (int)x, (int)y, (int)width, (int)height, page);
+}
+
+static void nkDraw_DeleteImageTexture(void *user, uint32_t texture)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)user;
+    nvgDeleteImage(context->nvgContext, (int)texture);
+}
+
+static void *nkDraw_FrameAlloc(void *uptr, int size)
+{
+    nkDrawContext_t *context = (nkDrawContext_t*)uptr;
+
+    context->frameBytes += (size_t)size;
+    return context->frameAllocator.alloc(context->frameAllocator.user, (size_t)size);
+}
+
+static void *nkDraw_ArenaAlloc(void *user, size_t size)
+{
+    return nkArena_Alloc((nkArena_t*)user, size);
+}
+
+static void nkDraw_ArenaReset(void *user)
+{
+    nkArena_Reset((nkArena_t*)user);
+}
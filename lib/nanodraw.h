@@ -35,6 +35,14 @@
 
 #include "color.h"
 #include "geometry.h"
+#include "nktextcache.h"
+#include "nkarena.h"
+#include "nkrendertarget.h"
+#include "nkthreadpool.h"
+#include "nkfilemap.h"
+#include "nkfontsource.h"
+#include "nkimagetable.h"
+#include "nkmipmap.h"
 
 /***************************************************************
 ** MARK: CONSTANTS & MACROS
@@ -46,15 +54,94 @@ extern "C" {
 
 #define VERTEX_BUFFER_SIZE  (1024*1024U)
 #define TEXTURE_ATTACHMENTS (16U)
+#define NK_DRAW_MAX_STATES  (32U)
+#define NK_DRAW_MAX_FONT_FACES (16U)
+#define NK_DRAW_FONT_NAME_LENGTH (32U)
+#define NK_DRAW_MEASURE_CACHE_SIZE (512U)
+#define NK_DRAW_RUN_CACHE_SIZE (8192U)
+#define NK_DRAW_GLYPH_THREADS (3U) /* deferred glyph rasterizers, two workers */
+#define NK_DRAW_IMAGE_THREADS (0U) /* image decoders, 0 for one worker per core */
+#define NK_DRAW_IMAGE_ATLAS_SIZE (1024U) /* side of the texture pages small images share */
+#define NK_DRAW_IMAGE_ATLAS_LIMIT (256U) /* largest side packed by default */
+#define NK_DRAW_IMAGE_UPLOAD_BUDGET (4U * 1024U * 1024U) /* mipmap bytes nkDraw_Begin uploads, one level at least */
 
 /***************************************************************
 ** MARK: TYPEDEFS
 ***************************************************************/
 
+typedef enum
+{
+    NK_DRAW_TARGET_GL,  /* the framebuffer bound in the current GL context */
+    NK_DRAW_TARGET_CPU  /* a context-owned buffer rasterised in software, NanoVG backend only */
+} nkDrawTarget_t;
+
+/* memory for the geometry rebuilt every frame. blocks only have to live until the next
+** nkDraw_Begin, which calls reset before asking for new ones, and are never freed one by one */
 typedef struct
 {
-    NVGcontext* nvgContext;
-} nkDrawContext_t;
+    void *user;
+    void *(*alloc)(void *user, size_t size); /* NULL when out of memory */
+    void (*reset)(void *user);               /* optional */
+} nkDrawAllocator_t;
+
+/* what nkDraw_Text does with glyphs missing from the NanoVG backend's atlas */
+typedef enum
+{
+    NK_DRAW_GLYPHS_BLOCK, /* rasterize them before drawing, the default */
+    NK_DRAW_GLYPHS_DEFER  /* rasterize them on worker threads and leave them out until they land */
+} nkDrawGlyphMode_t;
+
+/* how images larger than the atlas limit are sampled when drawn smaller than they are */
+typedef enum
+{
+    NK_DRAW_MIPMAPS_OFF, /* bilinear from the full image, the default */
+    NK_DRAW_MIPMAPS_ON,  /* box filtered pyramids built by the decode threads, uploaded coarsest level first */
+    NK_DRAW_MIPMAPS_FIT  /* as ON, but the texture starts at the level matching the first size drawn */
+} nkDrawImageMipmaps_t;
+
+/* handle into the context's image table, zero-initialised handles are empty */
+typedef struct
+{
+    uint32_t id; /* slot + 1 */
+} nkImage_t;
+
+/* see nkImageTable_GetMemory */
+typedef nkImageMemory_t nkDrawImageMemory_t;
+
+/* zero-initialised options select the GL target */
+typedef struct
+{
+    nkDrawTarget_t target;
+    size_t threads; /* CPU target rasteriser threads including the caller, 0 for one per core */
+    const nkDrawAllocator_t *allocator; /* copied, NULL for a linear arena owned by the context */
+    bool partialRedraw; /* redraw only invalidated rects, see nkDraw_Invalidate */
+    bool sdfText;       /* draw text from signed distance fields, see nkDraw_Text */
+    const uint8_t *glyphCache; /* see nkDraw_LoadGlyphCacheFromMemory, NULL for none */
+    size_t glyphCacheSize;
+    const char *glyphCachePath; /* mapped with nkDraw_LoadGlyphCache when glyphCache is NULL */
+    uint32_t imageAtlasLimit;   /* largest side of images packed into shared pages, 0 for NK_DRAW_IMAGE_ATLAS_LIMIT */
+    bool separateImages;        /* give every image a texture of its own instead */
+    nkDrawImageMipmaps_t imageMipmaps; /* for images too large for the atlas */
+} nkDrawContextOptions_t;
+
+/* retained display list, filled between nkDraw_BeginList and nkDraw_EndList.
+** storage layout is private to the backend; zero-initialise before first use. */
+typedef struct
+{
+    void *commands;
+    size_t commandCount;
+    size_t commandCapacity;
+
+    void *paths;
+    size_t pathCount;
+    size_t pathCapacity;
+
+    void *vertices;
+    size_t vertexCount;
+    size_t vertexCapacity;
+
+    void *replayVertices; /* scratch for translated replays */
+} nkDrawList_t;
 
 typedef struct 
 {
@@ -64,9 +151,189 @@ typedef struct
     size_t width;
     size_t height;
 
+    int faceId;    /* registry face resolved by nkDraw_LoadFont, -1 if none */
     float fontSize;
+    float ascent;  /* pixels above the baseline */
+    float descent; /* pixels below the baseline, negative */
 } nkFont_t;
 
+typedef struct
+{
+    char name[NK_DRAW_FONT_NAME_LENGTH];
+    const uint8_t *data;
+    size_t dataSize;
+    int faceId; /* NanoVG font id on the NanoVG backend, registry index otherwise */
+    nkFontSource_t *source; /* holds data for faces registered from files, NULL otherwise */
+} nkDrawFontFace_t;
+
+typedef struct
+{
+    uint64_t hits;
+    uint64_t misses;
+    size_t entries;
+    size_t capacity;
+
+    uint64_t runHits;
+    uint64_t runMisses;
+    size_t runEntries;
+    size_t runCapacity;
+} nkDrawTextCacheStats_t;
+
+/* counters are cumulative since creation */
+typedef struct
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t glyphs;         /* glyph bitmaps resident */
+    float occupancy;         /* fraction of the atlas they cover */
+    uint64_t rasterizations; /* glyph bitmaps rendered */
+    uint64_t evictions;      /* least recently used glyphs dropped once the atlas stopped growing */
+    uint32_t resets;         /* frames whose glyphs alone overflowed the atlas and cleared it */
+    uint32_t generation;     /* changes when glyphs move or leave the atlas */
+    uint32_t pending;        /* deferred or prewarmed glyphs not in the atlas yet */
+} nkDrawGlyphAtlasStats_t;
+
+/* one frame, from nkDraw_Begin to nkDraw_End */
+typedef struct
+{
+    uint32_t drawCalls;       /* fills, strokes and text runs submitted */
+    uint32_t culledCalls;     /* nkDraw calls skipped before tessellation, outside the view or clip */
+    uint32_t fillTriangles;
+    uint32_t strokeTriangles;
+    uint32_t textTriangles;
+
+    /* how fills were rasterised: a convex fan or a triangulated simple polygon without the
+    ** stencil, otherwise stencil then cover. shapes of the batched GL backend are not counted */
+    uint32_t convexFills;
+    uint32_t triangulatedFills;
+    uint32_t stencilFills;
+
+    uint32_t gpuDrawCalls;    /* glDraw* calls issued, zero on CPU targets */
+    uint32_t stateChanges;    /* texture, blend, stencil, scissor and uniform changes issued */
+    uint64_t vertexBytes;     /* vertex and uniform data uploaded */
+
+    uint32_t textureUploads;  /* glyph atlas updates */
+    uint64_t textureUploadBytes;
+
+    double tessellationMs;    /* CPU time building geometry */
+    double flushMs;           /* CPU time submitting it, or rasterising it on CPU targets */
+} nkDrawFrameStats_t;
+
+typedef struct
+{
+    size_t frameBytes;      /* requested from the frame allocator during the last frame */
+    size_t highWaterBytes;  /* most requested in any frame since creation */
+    size_t arenaCapacity;   /* reserved by the context's arena, zero with a caller allocator */
+    uint32_t arenaGrowths;  /* times the arena filled up mid-frame and took another block */
+    size_t imageTextureBytes; /* textures of images and atlas pages */
+    size_t imageStagedBytes;  /* decoded image levels waiting for upload */
+} nkDrawMemoryStats_t;
+
+/* vertex layout of shaders/opengl/general.vert */
+typedef struct
+{
+    uint32_t type; /* primitive in the low byte, texture slot above it */
+    float x, y;
+    float r, g, b, a;
+    float u, v;              /* atlas coords, or position relative to the rect centre for SDF */
+    float halfWidth, halfHeight;
+    float strokeWidth;       /* SDF only, zero fills */
+    float radii[4];          /* SDF only, top left, top right, bottom right, bottom left */
+    float endR, endG, endB, endA; /* gradient end colour, r, g, b, a being its start */
+    float t;                 /* position along the gradient axis, clamped per pixel */
+} nkDrawVertex_t;
+
+typedef struct
+{
+    nkColor_t colorStart;
+    nkColor_t colorEnd;
+    float x0, y0, x1, y1; /* gradient axis */
+    bool gradient;
+} nkDrawPaint_t;
+
+typedef struct
+{
+    nkDrawPaint_t fill;
+    nkDrawPaint_t stroke;
+    float strokeWidth;
+
+    nkRect_t clipRect;
+    bool clipEnabled;
+
+    nkDrawGlyphMode_t glyphMode;
+} nkDrawState_t;
+
+typedef struct
+{
+    NVGcontext* nvgContext;
+
+    nkDrawTarget_t target;
+    uint8_t *pixels;    /* CPU target, premultiplied RGBA8, sized by nkDraw_Begin */
+    size_t pixelWidth;
+    size_t pixelHeight;
+
+    nkDrawList_t *recordingList;
+    NVGparams recordingParams; /* renderer callbacks displaced while recording */
+
+    nkDrawState_t states[NK_DRAW_MAX_STATES];
+    size_t stateCount;
+
+    nkDrawFontFace_t fontFaces[NK_DRAW_MAX_FONT_FACES];
+    size_t fontFaceCount;
+    nkTextCache_t textCache; /* measured bounds */
+    nkTextCache_t runCache;  /* laid out glyph quads */
+
+    int appliedFaceId;      /* last face handed to NanoVG this frame, -1 if unknown */
+    float appliedFontSize;
+    bool sdfText;
+
+    /* deferred glyphs */
+    nkThreadPool_t *glyphPool; /* started by the first frame deferring a glyph */
+    bool glyphBatch;           /* jobs taken from NanoVG and not committed yet */
+
+    /* prebaked glyphs, kept for faces registered later */
+    const uint8_t *glyphCache;
+    size_t glyphCacheSize;
+    nkFileMap_t glyphCacheFile; /* backs glyphCache when it came from a file */
+
+    /* images */
+    nkImageTable_t images; /* indexed by nkImage_t id, the backend supplies the textures */
+
+    /* partial redraw */
+    bool partialRedraw;
+    nkRect_t damageRect;           /* invalidated since the last nkDraw_Begin */
+    nkRect_t redrawRect;           /* redrawn by the current frame, whole pixels */
+    nkRenderTarget_t renderTarget; /* GL targets, keeps the last frame */
+
+    nkDrawFrameStats_t frameStats;    /* last frame ended */
+    nkDrawFrameStats_t frameCounters; /* frame in progress, batched GL backend */
+
+    nkDrawAllocator_t frameAllocator; /* caller's, or one over frameArena */
+    nkArena_t frameArena;
+    size_t frameBytes;                /* requested since nkDraw_Begin */
+    nkDrawMemoryStats_t memoryStats;
+
+    /* batched GL backend */
+    GLuint shaderProgram;
+    GLuint vertexArray;
+    GLuint vertexBuffer;
+    GLint projectionLocation;
+
+    nkDrawVertex_t *vertices;
+    size_t vertexCount;
+
+    GLuint textures[TEXTURE_ATTACHMENTS];
+    size_t textureCount;
+
+    nkRect_t appliedClipRect;
+    bool appliedClipEnabled;
+
+    float viewWidth;
+    float viewHeight;
+
+    nkFont_t defaultFont;
+} nkDrawContext_t;
+
 
 
 /***************************************************************
@@ -74,9 +341,31 @@ typedef struct
 ***************************************************************/
 
 bool nkDraw_CreateContext(nkDrawContext_t *context); 
+bool nkDraw_CreateContextWithOptions(nkDrawContext_t *context, const nkDrawContextOptions_t *options);
+
+/* waits for the context's worker threads and frees what it holds, GL objects included, so GL
+** targets need their GL context current. the atlas textures of the caller's nkFont_t stay
+** the caller's. not between nkDraw_Begin and nkDraw_End */
+void nkDraw_DestroyContext(nkDrawContext_t *context);
+
 void nkDraw_Begin(nkDrawContext_t *context, float width, float height);
 void nkDraw_End(nkDrawContext_t *context);
 
+/* clears the whole target, or the redraw rect with partial redraw; call before drawing in a
+** frame, as with glClear */
+void nkDraw_Clear(nkDrawContext_t *context, nkColor_t color);
+
+/* partial redraw: contexts created with partialRedraw keep the target's pixels between frames
+** and nkDraw_Begin redraws only the union of the rects invalidated since the previous
+** nkDraw_Begin. the frame is clipped to it and draw calls whose bounds miss it are skipped
+** before tessellation. the first frame and frames after a resize redraw everything. GL
+** targets are drawn offscreen and copied to the bound framebuffer by nkDraw_End. */
+void nkDraw_Invalidate(nkDrawContext_t *context, nkRect_t rect);
+
+/* CPU target pixels as of the last nkDraw_End, premultiplied RGBA8 with the top row first.
+** NULL for GL targets. stride is in bytes. */
+const uint8_t *nkDraw_GetPixels(nkDrawContext_t *context, size_t *width, size_t *height, size_t *stride);
+
 void nkDraw_SaveContext(nkDrawContext_t *context);
 void nkDraw_RestoreContext(nkDrawContext_t *context);
 void nkDraw_SetClipRect(nkDrawContext_t *context, nkRect_t clipRect);
@@ -91,16 +380,116 @@ void nkDraw_SetStrokeColorGradient(nkDrawContext_t *context, nkVector4_t colorSt
 void nkDraw_SetStrokeWidth(nkDrawContext_t *context, float width);
 
 
+/* with sdfText the NanoVG backend rasterizes each glyph once as a signed distance field and
+** scales it to every font size, so zooming through continuous sizes adds no glyphs to the
+** atlas. glyphs are then placed without pixel snapping and small text is slightly softer. the
+** batched GL backend always draws its baked bitmaps. */
 void nkDraw_Text(nkDrawContext_t* context, nkFont_t* font, const char* text, float x, float y);
+
+/* part of the saved state. with NK_DRAW_GLYPHS_DEFER the NanoVG backend queues glyphs missing
+** from its atlas instead of rasterizing them inside nkDraw_Text, so text in a new script or
+** size does not stall the frame. nkDraw_End hands the queue to worker threads and the first
+** nkDraw_Begin after they finish adds the glyphs to the atlas; text drawn meanwhile leaves them
+** out. contexts with partialRedraw invalidate such text themselves, others should draw another
+** frame while nkDraw_GetGlyphAtlasStats reports pending glyphs. the batched GL backend bakes
+** its glyphs up front and never waits on them. */
+void nkDraw_SetGlyphMode(nkDrawContext_t *context, nkDrawGlyphMode_t mode);
+
+/* queues the glyphs of codepoints first to last, at each of sizes or at the font's own size
+** when sizes is NULL, for background rasterization as with NK_DRAW_GLYPHS_DEFER. codepoints
+** the face lacks are skipped. no-op on the batched GL backend. */
+void nkDraw_PrewarmGlyphs(nkDrawContext_t *context, nkFont_t *font, uint32_t first, uint32_t last, const float *sizes, size_t sizeCount);
+
+/* glyph caches: nkDraw_SaveGlyphCache writes the glyphs in the NanoVG backend's atlas, say
+** after warming up, with their bitmaps keyed by face data, codepoint, pixel size and blur.
+** loading one puts the glyphs of registered faces straight into the atlas, so startup text
+** never calls the rasterizer, and the context keeps it to fill faces registered later. files
+** are memory mapped and data must outlive the context. entries for other font data are
+** ignored. loads return false for invalid data, keeping the previous cache, and when the
+** atlas could not hold every glyph. tools/nkglyphbake builds caches offline and the
+** NANODRAW_GLYPH_CACHE_FONT CMake option embeds one that contexts load by default. the
+** batched GL backend bakes its own atlases and returns false. */
+bool nkDraw_SaveGlyphCache(nkDrawContext_t *context, const char *path);
+bool nkDraw_LoadGlyphCache(nkDrawContext_t *context, const char *path);
+bool nkDraw_LoadGlyphCacheFromMemory(nkDrawContext_t *context, const uint8_t *data, size_t size);
+
+/* images: loads return at once with the image NK_IMAGE_LOADING while a pool of worker threads
+** reads and decodes it with stb_image, and the first nkDraw_Begin after it is decoded uploads
+** it, so a burst of images never stalls a frame. encoded data is copied. false when the image
+** could not be queued, leaving it empty. nkDraw_End starts images loaded since the previous
+** batch. images drawn in the frame in progress must not be freed before its nkDraw_End.
+** images no larger than imageAtlasLimit are packed into shared NK_DRAW_IMAGE_ATLAS_SIZE pages,
+** so runs of icons draw from one texture and merge into one draw; a page's space is reused
+** once every image on it is freed. with imageMipmaps, larger images get box filtered mip
+** pyramids built on the decode threads, and each nkDraw_Begin uploads levels from the
+** coarsest up within NK_DRAW_IMAGE_UPLOAD_BUDGET bytes, so a photo shows blurred at once and
+** sharpens over the next frames. NK_DRAW_MIPMAPS_FIT holds the levels until the image is first
+** drawn and drops those finer than that size needs, drawing it larger later magnifies. */
+bool nkDraw_LoadImage(nkDrawContext_t *context, nkImage_t *image, const char *path);
+bool nkDraw_LoadImageFromMemory(nkDrawContext_t *context, nkImage_t *image, const uint8_t *data, size_t size);
+void nkDraw_FreeImage(nkDrawContext_t *context, nkImage_t *image);
+
+/* width and height in pixels once ready, either may be NULL */
+nkImageState_t nkDraw_GetImageState(nkDrawContext_t *context, const nkImage_t *image, uint32_t *width, uint32_t *height);
+
+/* memory held by an image, zeroed for empty ones. memory stats carry the totals */
+void nkDraw_GetImageMemory(nkDrawContext_t *context, const nkImage_t *image, nkDrawImageMemory_t *memory);
+
+/* stretched over the rect. images not ready draw nothing, and contexts with partialRedraw
+** invalidate the rect so it is drawn again once the image lands. */
+void nkDraw_Image(nkDrawContext_t *context, const nkImage_t *image, float x, float y, float w, float h);
+
 void nkDraw_Rect(nkDrawContext_t* context, float x, float y, float w, float h);
 void nkDraw_RoundedRect(nkDrawContext_t* context, float x, float y, float w, float h, float radius);
 void nkDraw_RoundedRectPath(nkDrawContext_t* context, float x, float y, float w, float h, float radius);
 
+/* per-corner radii, clockwise from top left */
+void nkDraw_RoundedRectVarying(nkDrawContext_t* context, float x, float y, float w, float h, float radiusTopLeft, float radiusTopRight, float radiusBottomRight, float radiusBottomLeft);
+void nkDraw_RoundedRectPathVarying(nkDrawContext_t* context, float x, float y, float w, float h, float radiusTopLeft, float radiusTopRight, float radiusBottomRight, float radiusBottomLeft);
+
 bool nkFont_Load(nkFont_t *font, const char *filename, float fontSize, uint8_t *atlas_buffer, size_t atlas_buffer_width, size_t atlas_buffer_height);
 bool nkFont_LoadFromMemory(nkFont_t *font, uint8_t *data, size_t dataSize, float fontSize, uint8_t *atlas_buffer, size_t atlas_buffer_width, size_t atlas_buffer_height);
 
-/* measures text relative to origin */
-nkRect_t nkDraw_MeasureText(nkDrawContext_t* context, nkFont_t* font, const char* text); 
+/* font registry: faces are registered once by name and fonts resolve a face and pixel size
+** up front, so drawing with a font is an id change rather than a name lookup. data is not
+** copied and must outlive the context. a NULL font draws with the default 14px face. */
+int nkDraw_RegisterFontFace(nkDrawContext_t *context, const char *name, const uint8_t *data, size_t dataSize);
+
+/* registers a font file as a face without reading it: the file is memory mapped read-only
+** and shared with every context, and nkFont_Load, using the same path, so a large font costs
+** its glyphs' pages once per process rather than a heap copy per context. -1 when it cannot
+** be mapped or registered. */
+int nkDraw_RegisterFontFile(nkDrawContext_t *context, const char *name, const char *path);
+bool nkDraw_LoadFont(nkDrawContext_t *context, nkFont_t *font, const char *name, float fontSize);
+
+/* measures text relative to origin. measurements and, on the NanoVG backend, laid out glyph
+** quads for nkDraw_Text are cached per (face, size, string) in LRUs owned by the context;
+** hit and miss counts are cumulative since creation. */
+nkRect_t nkDraw_MeasureText(nkDrawContext_t* context, nkFont_t* font, const char* text);
+void nkDraw_GetTextCacheStats(nkDrawContext_t *context, nkDrawTextCacheStats_t *stats);
+
+/* the NanoVG backend grows one glyph atlas up to its size limit, then evicts glyphs not used
+** in the current frame to make room. the batched GL backend bakes ASCII into one atlas per
+** nkFont_t up front and reports the default font's. */
+void nkDraw_GetGlyphAtlasStats(nkDrawContext_t *context, nkDrawGlyphAtlasStats_t *stats);
+
+/* counters of the last frame ended with nkDraw_End. draw calls and triangles are counted
+** as NanoVG counts them on the NanoVG backend and per primitive on the batched backend. */
+void nkDraw_GetFrameStats(nkDrawContext_t *context, nkDrawFrameStats_t *stats);
+
+/* per-frame geometry memory. on the NanoVG backend path commands, the path cache and the
+** renderer's calls and vertices come from the frame allocator and are reset in nkDraw_Begin;
+** the batched GL backend uses fixed buffers and reports zero bytes. */
+void nkDraw_GetMemoryStats(nkDrawContext_t *context, nkDrawMemoryStats_t *stats);
+
+/* display lists: draw calls made between BeginList and EndList are tessellated once and
+** captured instead of drawn. must be recorded inside nkDraw_Begin/nkDraw_End. lists holding
+** text reference the current glyph atlas and need re-recording once its generation in
+** nkDraw_GetGlyphAtlasStats changes. */
+void nkDraw_BeginList(nkDrawContext_t *context, nkDrawList_t *list);
+void nkDraw_EndList(nkDrawContext_t *context);
+void nkDraw_ReplayList(nkDrawContext_t *context, nkDrawList_t *list, float dx, float dy);
+void nkDrawList_Free(nkDrawList_t *list);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,187 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkarena.c
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-05 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Linear Frame Arena
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkarena.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define NK_ARENA_MIN_BLOCK (64U * 1024U)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+struct nkArenaBlock_t
+{
+    nkArenaBlock_t *next;
+    size_t size;   /* bytes of data following the header */
+    size_t offset; /* first free byte */
+};
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void *nkArena_Bump(nkArena_t *arena, size_t size);
+static bool nkArena_AddBlock(nkArena_t *arena, size_t size);
+static void nkArena_FreeBlocks(nkArena_t *arena);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkArena_Init(nkArena_t *arena, size_t capacity)
+{
+    arena->blocks = NULL;
+    arena->used = 0;
+    arena->capacity = 0;
+    arena->highWater = 0;
+    arena->growths = 0;
+
+    if (capacity > 0)
+    {
+        nkArena_AddBlock(arena, capacity);
+    }
+}
+
+void nkArena_Destroy(nkArena_t *arena)
+{
+    nkArena_FreeBlocks(arena);
+    arena->used = 0;
+    arena->highWater = 0;
+    arena->growths = 0;
+}
+
+void *nkArena_Alloc(nkArena_t *arena, size_t size)
+{
+    void *ptr = nkArena_Bump(arena, size);
+
+    if (ptr)
+    {
+        return ptr;
+    }
+
+    /* double the newest block so a growing frame needs few of them */
+    size_t blockSize = arena->blocks ? arena->blocks->size * 2 : 0;
+
+    if (arena->blocks)
+    {
+        arena->growths++;
+    }
+
+    if (!nkArena_AddBlock(arena, blockSize > size ? blockSize : size))
+    {
+        return NULL;
+    }
+
+    return nkArena_Bump(arena, size);
+}
+
+void nkArena_Reset(nkArena_t *arena)
+{
+    if (arena->used > arena->highWater)
+    {
+        arena->highWater = arena->used;
+    }
+
+    arena->used = 0;
+
+    if (arena->blocks && arena->blocks->next)
+    {
+        nkArena_FreeBlocks(arena);
+        nkArena_AddBlock(arena, arena->highWater);
+    }
+    else if (arena->blocks)
+    {
+        arena->blocks->offset = 0;
+    }
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+/* NULL when the newest block is full */
+static void *nkArena_Bump(nkArena_t *arena, size_t size)
+{
+    nkArenaBlock_t *block = arena->blocks;
+
+    if (!block)
+    {
+        return NULL;
+    }
+
+    uintptr_t data = (uintptr_t)(block + 1);
+    uintptr_t start = (data + block->offset + NK_ARENA_ALIGNMENT - 1) & ~(uintptr_t)(NK_ARENA_ALIGNMENT - 1);
+    size_t end = (size_t)(start - data) + size;
+
+    if (end > block->size)
+    {
+        return NULL;
+    }
+
+    arena->used += end - block->offset;
+    block->offset = end;
+    return (void*)start;
+}
+
+static bool nkArena_AddBlock(nkArena_t *arena, size_t size)
+{
+    /* room to align the first allocation */
+    size += NK_ARENA_ALIGNMENT;
+
+    if (size < NK_ARENA_MIN_BLOCK)
+    {
+        size = NK_ARENA_MIN_BLOCK;
+    }
+
+    nkArenaBlock_t *block = (nkArenaBlock_t*)malloc(sizeof(nkArenaBlock_t) + size);
+
+    if (!block)
+    {
+        fprintf(stderr, "ERROR: Failed to allocate %zu byte arena block.\n", size);
+        return false;
+    }
+
+    block->next = arena->blocks;
+    block->size = size;
+    block->offset = 0;
+    arena->blocks = block;
+    arena->capacity += size;
+    return true;
+}
+
+static void nkArena_FreeBlocks(nkArena_t *arena)
+{
+    while (arena->blocks)
+    {
+        nkArenaBlock_t *next = arena->blocks->next;
+        free(arena->blocks);
+        arena->blocks = next;
+    }
+
+    arena->capacity = 0;
+}
@@ -0,0 +1,64 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkarena.h
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-05 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Linear Frame Arena
+**
+***************************************************************/
+
+#ifndef NKARENA_H
+#define NKARENA_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/* alignment of every block handed out */
+#define NK_ARENA_ALIGNMENT (16U)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct nkArenaBlock_t nkArenaBlock_t;
+
+/* bump allocator over a list of malloc'd blocks. allocations are only released all at once
+** by nkArena_Reset. zero-initialised arenas are valid and empty. */
+typedef struct
+{
+    nkArenaBlock_t *blocks; /* newest first, allocations come from the head */
+    size_t used;            /* bytes handed out since the last reset, padding included */
+    size_t capacity;        /* bytes reserved over all blocks */
+    size_t highWater;       /* most bytes used between two resets */
+    uint32_t growths;       /* blocks added because the reserved ones were full */
+} nkArena_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* reserves capacity bytes up front, 0 waits for the first allocation */
+void nkArena_Init(nkArena_t *arena, size_t capacity);
+void nkArena_Destroy(nkArena_t *arena);
+
+/* NULL when a new block cannot be allocated */
+void *nkArena_Alloc(nkArena_t *arena, size_t size);
+
+/* invalidates every allocation. an arena that had to grow is replaced by a single block of
+** at least its high water mark, so steady frames never call malloc. */
+void nkArena_Reset(nkArena_t *arena);
+
+#endif /* NKARENA_H */
@@ -0,0 +1,151 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkfilemap.c
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-05 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Read-Only File Mapping
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkfilemap.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool nkFileMap_Open(nkFileMap_t *map, const char *path)
+{
+    memset(map, 0, sizeof(nkFileMap_t));
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        fprintf(stderr, "ERROR: Failed to open %s.\n", path);
+        return false;
+    }
+
+    LARGE_INTEGER size;
+
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0 || (uint64_t)size.QuadPart > (uint64_t)SIZE_MAX)
+    {
+        fprintf(stderr, "ERROR: %s is empty or too large to map.\n", path);
+        CloseHandle(file);
+        return false;
+    }
+
+    /* the mapping keeps the file open */
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+
+    if (!mapping)
+    {
+        fprintf(stderr, "ERROR: Failed to map %s.\n", path);
+        return false;
+    }
+
+    const void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+    if (!data)
+    {
+        fprintf(stderr, "ERROR: Failed to map %s.\n", path);
+        CloseHandle(mapping);
+        return false;
+    }
+
+    map->data = (const uint8_t*)data;
+    map->size = (size_t)size.QuadPart;
+    map->handle = mapping;
+#else
+    int file = open(path, O_RDONLY);
+
+    if (file < 0)
+    {
+        fprintf(stderr, "ERROR: Failed to open %s.\n", path);
+        return false;
+    }
+
+    struct stat info;
+
+    if (fstat(file, &info) != 0 || info.st_size <= 0 || (uint64_t)info.st_size > (uint64_t)SIZE_MAX)
+    {
+        fprintf(stderr, "ERROR: %s is empty or too large to map.\n", path);
+        close(file);
+        return false;
+    }
+
+    /* the mapping keeps the file open */
+    void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+
+    if (data == MAP_FAILED)
+    {
+        fprintf(stderr, "ERROR: Failed to map %s.\n", path);
+        return false;
+    }
+
+    map->data = (const uint8_t*)data;
+    map->size = (size_t)info.st_size;
+#endif
+
+    return true;
+}
+
+void nkFileMap_Close(nkFileMap_t *map)
+{
+    if (!map->data)
+    {
+        return;
+    }
+
+#if defined(_WIN32)
+    UnmapViewOfFile(map->data);
+    CloseHandle((HANDLE)map->handle);
+#else
+    munmap((void*)map->data, map->size);
+#endif
+
+    memset(map, 0, sizeof(nkFileMap_t));
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
@@ -0,0 +1,50 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkfilemap.h
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-05 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Read-Only File Mapping
+**
+***************************************************************/
+
+#ifndef NKFILEMAP_H
+#define NKFILEMAP_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* a whole file mapped read-only, so pages are loaded on first touch and shared between
+** processes mapping the same file. zero-initialised maps are valid and empty. */
+typedef struct
+{
+    const uint8_t *data; /* NULL when nothing is mapped */
+    size_t size;
+    void *handle;        /* platform mapping object, Win32 only */
+} nkFileMap_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* false, leaving map empty, when the file cannot be opened or is empty */
+bool nkFileMap_Open(nkFileMap_t *map, const char *path);
+void nkFileMap_Close(nkFileMap_t *map);
+
+#endif /* NKFILEMAP_H */
@@ -42,36 +42,20 @@
 
 bool nkFont_Load(nkFont_t *font, const char *filename, float fontSize, uint8_t *atlas_buffer, size_t atlas_buffer_width, size_t atlas_buffer_height)
 {
-    uint8_t* ttf_buffer = NULL;
-    size_t file_size = 0;
-    FILE* fontFile = fopen(filename, "rb");
+    /* baking touches only the pages holding ASCII glyphs, and fonts a context has registered
+    ** with nkDraw_RegisterFontFile are already mapped */
+    nkFontSource_t *source = nkFontSource_Acquire(filename);
 
-    if (!fontFile) 
+    if (!source)
     {
         fprintf(stderr, "ERROR: Failed to open font file '%s'\n", filename);
         return false;
     }
 
-    fseek(fontFile, 0, SEEK_END);
-    file_size = ftell(fontFile);
-    fseek(fontFile, 0, SEEK_SET);
+    bool success = nkFont_LoadFromMemory(font, (uint8_t*)source->data, source->size, fontSize, atlas_buffer, atlas_buffer_width, atlas_buffer_height);
 
-    ttf_buffer = (unsigned char*)malloc(file_size);
+    nkFontSource_Release(source);
 
-    if (!ttf_buffer || fread(ttf_buffer, 1, file_size, fontFile) != file_size) 
-    {
-        fprintf(stderr, "ERROR: Failed to read font file into buffer.\n");
-        fclose(fontFile);
-        free(ttf_buffer);
-        return false;
-    }
-
-    fclose(fontFile);
-
-    bool success = nkFont_LoadFromMemory(font, ttf_buffer, file_size, fontSize, atlas_buffer, atlas_buffer_width, atlas_buffer_height);
-
-    free(ttf_buffer);
-    
     printf("Font '%s' loaded successfully with size %.2f.\n", filename, fontSize);
 
     return success;
@@ -115,6 +99,24 @@ bool nkFont_LoadFromMemory(nkFont_t *font, uint8_t *data, size_t dataSize, float
     font->width = atlas_buffer_width;
     font->height = atlas_buffer_height;
     font->fontSize = fontSize;
+    font->faceId = -1;
+
+    // Vertical metrics at the baked pixel height, used for line bounds.
+    stbtt_fontinfo info;
+    int ascent = 0, descent = 0, lineGap = 0;
+
+    if (stbtt_InitFont(&info, data, stbtt_GetFontOffsetForIndex(data, 0)))
+    {
+        float scale = stbtt_ScaleForPixelHeight(&info, fontSize);
+        stbtt_GetFontVMetrics(&info, &ascent, &descent, &lineGap);
+        font->ascent = (float)ascent * scale;
+        font->descent = (float)descent * scale;
+    }
+    else
+    {
+        font->ascent = fontSize;
+        font->descent = 0.0f;
+    }
 
     printf("Font '%pu' loaded successfully with size %.2f.\n", data, fontSize);
 
@@ -0,0 +1,165 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkfontsource.c
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-26 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Shared Font Sources
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkfontsource.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #define NK_FONT_SOURCE_WIN32 1
+#elif !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+    #include <pthread.h>
+    #define NK_FONT_SOURCE_POSIX 1
+#endif
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+#if NK_FONT_SOURCE_WIN32
+static SRWLOCK nkFontSource_lock = SRWLOCK_INIT;
+#elif NK_FONT_SOURCE_POSIX
+static pthread_mutex_t nkFontSource_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/* every mapped source, few enough that a list is searched faster than it is hashed */
+static nkFontSource_t *nkFontSource_sources = NULL;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void nkFontSource_Lock(void);
+static void nkFontSource_Unlock(void);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+nkFontSource_t *nkFontSource_Acquire(const char *path)
+{
+    nkFontSource_Lock();
+
+    nkFontSource_t *source = nkFontSource_sources;
+
+    while (source && strcmp(source->path, path) != 0)
+    {
+        source = source->next;
+    }
+
+    if (source)
+    {
+        source->references++;
+        nkFontSource_Unlock();
+        return source;
+    }
+
+    /* mapped under the lock, so two contexts loading one font at once share the mapping */
+    size_t length = strlen(path) + 1;
+
+    source = (nkFontSource_t*)calloc(1, sizeof(nkFontSource_t));
+
+    if (!source || !(source->path = (char*)malloc(length)))
+    {
+        fprintf(stderr, "ERROR: Failed to allocate font source for '%s'.\n", path);
+        free(source);
+        nkFontSource_Unlock();
+        return NULL;
+    }
+
+    if (!nkFileMap_Open(&source->map, path))
+    {
+        free(source->path);
+        free(source);
+        nkFontSource_Unlock();
+        return NULL;
+    }
+
+    memcpy(source->path, path, length);
+    source->data = source->map.data;
+    source->size = source->map.size;
+    source->references = 1;
+    source->next = nkFontSource_sources;
+    nkFontSource_sources = source;
+
+    nkFontSource_Unlock();
+    return source;
+}
+
+void nkFontSource_Release(nkFontSource_t *source)
+{
+    if (!source)
+    {
+        return;
+    }
+
+    nkFontSource_Lock();
+
+    if (--source->references > 0)
+    {
+        nkFontSource_Unlock();
+        return;
+    }
+
+    nkFontSource_t **link = &nkFontSource_sources;
+
+    while (*link != source)
+    {
+        link = &(*link)->next;
+    }
+
+    *link = source->next;
+    nkFontSource_Unlock();
+
+    nkFileMap_Close(&source->map);
+    free(source->path);
+    free(source);
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void nkFontSource_Lock(void)
+{
+#if NK_FONT_SOURCE_WIN32
+    AcquireSRWLockExclusive(&nkFontSource_lock);
+#elif NK_FONT_SOURCE_POSIX
+    pthread_mutex_lock(&nkFontSource_lock);
+#endif
+}
+
+static void nkFontSource_Unlock(void)
+{
+#if NK_FONT_SOURCE_WIN32
+    ReleaseSRWLockExclusive(&nkFontSource_lock);
+#elif NK_FONT_SOURCE_POSIX
+    pthread_mutex_unlock(&nkFontSource_lock);
+#endif
+}
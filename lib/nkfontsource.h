@@ -0,0 +1,60 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkfontsource.h
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-26 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Shared Font Sources
+**
+***************************************************************/
+
+#ifndef NKFONTSOURCE_H
+#define NKFONTSOURCE_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "nkfilemap.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* a font file memory mapped read-only, shared by everything that acquires the same path, so
+** opening a large font reads nothing up front and its pages are resident once however many
+** contexts use it. unmapped when the last reference is released. */
+typedef struct nkFontSource_t
+{
+    const uint8_t *data;
+    size_t size;
+
+    char *path;
+    nkFileMap_t map;
+    uint32_t references;          /* guarded by the sources' lock */
+    struct nkFontSource_t *next;
+} nkFontSource_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* maps path, or takes another reference to the source already mapped for it. NULL when the
+** file cannot be mapped. safe from any thread */
+nkFontSource_t *nkFontSource_Acquire(const char *path);
+
+/* drops a reference, NULL is ignored. data must not be used once the last one is gone */
+void nkFontSource_Release(nkFontSource_t *source);
+
+#endif /* NKFONTSOURCE_H */
@@ -0,0 +1,322 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkimageatlas.c
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-12 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Image Atlas Packer
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkimageatlas.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define NK_IMAGE_ATLAS_MIN_NODES (64U)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static nkImageAtlasPage_t *nkImageAtlas_AddPage(nkImageAtlas_t *atlas);
+static void nkImageAtlas_ResetPage(const nkImageAtlas_t *atlas, nkImageAtlasPage_t *page);
+static bool nkImageAtlas_Place(const nkImageAtlas_t *atlas, nkImageAtlasPage_t *page, uint32_t width, uint32_t height, uint32_t *x, uint32_t *y);
+static bool nkImageAtlas_Rise(const nkImageAtlas_t *atlas, const nkImageAtlasPage_t *page, size_t node, uint32_t width, uint32_t height, uint32_t *y);
+static bool nkImageAtlas_Insert(nkImageAtlasPage_t *page, size_t node, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkImageAtlas_Init(nkImageAtlas_t *atlas, uint32_t pageSize, uint32_t limit)
+{
+    memset(atlas, 0, sizeof(nkImageAtlas_t));
+
+    atlas->pageSize = pageSize;
+    atlas->limit = pageSize > 2 * NK_IMAGE_ATLAS_PADDING ? pageSize - 2 * NK_IMAGE_ATLAS_PADDING : 0;
+    atlas->limit = limit < atlas->limit ? limit : atlas->limit;
+}
+
+void nkImageAtlas_Destroy(nkImageAtlas_t *atlas)
+{
+    for (size_t i = 0; i < atlas->pageCount; i++)
+    {
+        free(atlas->pages[i].nodes);
+    }
+
+    free(atlas->pages);
+    memset(atlas, 0, sizeof(nkImageAtlas_t));
+}
+
+bool nkImageAtlas_Fits(const nkImageAtlas_t *atlas, uint32_t width, uint32_t height)
+{
+    return width > 0 && height > 0 && width <= atlas->limit && height <= atlas->limit;
+}
+
+bool nkImageAtlas_Alloc(nkImageAtlas_t *atlas, uint32_t width, uint32_t height, uint32_t *page, uint32_t *x, uint32_t *y)
+{
+    if (!nkImageAtlas_Fits(atlas, width, height))
+    {
+        return false;
+    }
+
+    uint32_t paddedWidth = width + 2 * NK_IMAGE_ATLAS_PADDING;
+    uint32_t paddedHeight = height + 2 * NK_IMAGE_ATLAS_PADDING;
+
+    size_t pageCount = atlas->pageCount;
+
+    /* every page in use, then a new one, which an image within the limit always fits */
+    for (size_t i = 0; i <= pageCount; i++)
+    {
+        nkImageAtlasPage_t *target = i < pageCount ? &atlas->pages[i] : nkImageAtlas_AddPage(atlas);
+
+        if (!target)
+        {
+            return false;
+        }
+
+        if (nkImageAtlas_Place(atlas, target, paddedWidth, paddedHeight, x, y))
+        {
+            target->images++;
+            *page = (uint32_t)i;
+            *x += NK_IMAGE_ATLAS_PADDING;
+            *y += NK_IMAGE_ATLAS_PADDING;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void nkImageAtlas_Free(nkImageAtlas_t *atlas, uint32_t page)
+{
+    if (page >= atlas->pageCount || atlas->pages[page].images == 0)
+    {
+        return;
+    }
+
+    /* the skyline cannot give back the space of one image, an empty page starts over */
+    if (--atlas->pages[page].images == 0)
+    {
+        nkImageAtlas_ResetPage(atlas, &atlas->pages[page]);
+    }
+}
+
+void nkImageAtlas_Pad(const uint8_t *pixels, uint32_t width, uint32_t height, uint8_t *dst, size_t stride)
+{
+    const uint32_t pad = NK_IMAGE_ATLAS_PADDING;
+
+    for (uint32_t row = 0; row < height + 2 * pad; row++)
+    {
+        uint32_t source = row < pad ? 0 : (row - pad < height ? row - pad : height - 1);
+        const uint8_t *src = pixels + (size_t)source * width * 4;
+        uint8_t *out = dst + (size_t)row * stride;
+
+        for (uint32_t i = 0; i < pad; i++)
+        {
+            memcpy(out + i * 4, src, 4);
+            memcpy(out + (pad + width + i) * 4, src + (size_t)(width - 1) * 4, 4);
+        }
+
+        memcpy(out + pad * 4, src, (size_t)width * 4);
+    }
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static nkImageAtlasPage_t *nkImageAtlas_AddPage(nkImageAtlas_t *atlas)
+{
+    if (atlas->pageCount == atlas->pageCapacity)
+    {
+        size_t capacity = atlas->pageCapacity ? atlas->pageCapacity * 2 : 4;
+        nkImageAtlasPage_t *pages = (nkImageAtlasPage_t*)realloc(atlas->pages, capacity * sizeof(nkImageAtlasPage_t));
+
+        if (!pages)
+        {
+            fprintf(stderr, "ERROR: Failed to grow the image atlas.\n");
+            return NULL;
+        }
+
+        atlas->pages = pages;
+        atlas->pageCapacity = capacity;
+    }
+
+    nkImageAtlasPage_t *page = &atlas->pages[atlas->pageCount];
+    memset(page, 0, sizeof(nkImageAtlasPage_t));
+
+    if (!(page->nodes = (nkImageAtlasNode_t*)malloc(NK_IMAGE_ATLAS_MIN_NODES * sizeof(nkImageAtlasNode_t))))
+    {
+        fprintf(stderr, "ERROR: Failed to grow the image atlas.\n");
+        return NULL;
+    }
+
+    page->nodeCapacity = NK_IMAGE_ATLAS_MIN_NODES;
+    nkImageAtlas_ResetPage(atlas, page);
+
+    atlas->pageCount++;
+    return page;
+}
+
+static void nkImageAtlas_ResetPage(const nkImageAtlas_t *atlas, nkImageAtlasPage_t *page)
+{
+    page->nodes[0] = (nkImageAtlasNode_t){ 0, 0, atlas->pageSize };
+    page->nodeCount = 1;
+    page->images = 0;
+}
+
+/* bottom-left skyline placement, as fontstash packs glyphs: the lowest top edge wins and
+** the narrower node breaks ties */
+static bool nkImageAtlas_Place(const nkImageAtlas_t *atlas, nkImageAtlasPage_t *page, uint32_t width, uint32_t height, uint32_t *x, uint32_t *y)
+{
+    size_t best = SIZE_MAX;
+    uint32_t bestWidth = UINT32_MAX;
+    uint32_t bestBottom = UINT32_MAX;
+    uint32_t bestX = 0;
+    uint32_t bestY = 0;
+
+    for (size_t i = 0; i < page->nodeCount; i++)
+    {
+        uint32_t top = 0;
+
+        if (!nkImageAtlas_Rise(atlas, page, i, width, height, &top))
+        {
+            continue;
+        }
+
+        if (top + height < bestBottom || (top + height == bestBottom && page->nodes[i].width < bestWidth))
+        {
+            best = i;
+            bestWidth = page->nodes[i].width;
+            bestBottom = top + height;
+            bestX = page->nodes[i].x;
+            bestY = top;
+        }
+    }
+
+    if (best == SIZE_MAX || !nkImageAtlas_Insert(page, best, bestX, bestY, width, height))
+    {
+        return false;
+    }
+
+    *x = bestX;
+    *y = bestY;
+    return true;
+}
+
+/* top of a width x height rect resting on the skyline from node on, false if it leaves the page */
+static bool nkImageAtlas_Rise(const nkImageAtlas_t *atlas, const nkImageAtlasPage_t *page, size_t node, uint32_t width, uint32_t height, uint32_t *y)
+{
+    uint32_t top = 0;
+    uint32_t covered = 0;
+
+    if (page->nodes[node].x + width > atlas->pageSize)
+    {
+        return false;
+    }
+
+    for (size_t i = node; covered < width; i++)
+    {
+        if (i == page->nodeCount)
+        {
+            return false;
+        }
+
+        top = page->nodes[i].y > top ? page->nodes[i].y : top;
+
+        if (top + height > atlas->pageSize)
+        {
+            return false;
+        }
+
+        covered += page->nodes[i].width;
+    }
+
+    *y = top;
+    return true;
+}
+
+/* raises the skyline over the rect placed at node, trimming the nodes it covers */
+static bool nkImageAtlas_Insert(nkImageAtlasPage_t *page, size_t node, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    if (page->nodeCount == page->nodeCapacity)
+    {
+        size_t capacity = page->nodeCapacity * 2;
+        nkImageAtlasNode_t *nodes = (nkImageAtlasNode_t*)realloc(page->nodes, capacity * sizeof(nkImageAtlasNode_t));
+
+        if (!nodes)
+        {
+            fprintf(stderr, "ERROR: Failed to grow the image atlas.\n");
+            return false;
+        }
+
+        page->nodes = nodes;
+        page->nodeCapacity = capacity;
+    }
+
+    memmove(&page->nodes[node + 1], &page->nodes[node], (page->nodeCount - node) * sizeof(nkImageAtlasNode_t));
+    page->nodes[node] = (nkImageAtlasNode_t){ x, y + height, width };
+    page->nodeCount++;
+
+    /* nodes under the rect shrink from the left, those fully covered go */
+    for (size_t i = node + 1; i < page->nodeCount; )
+    {
+        uint32_t right = page->nodes[i - 1].x + page->nodes[i - 1].width;
+
+        if (page->nodes[i].x >= right)
+        {
+            break;
+        }
+
+        uint32_t shrink = right - page->nodes[i].x;
+
+        if (shrink < page->nodes[i].width)
+        {
+            page->nodes[i].x += shrink;
+            page->nodes[i].width -= shrink;
+            break;
+        }
+
+        memmove(&page->nodes[i], &page->nodes[i + 1], (page->nodeCount - i - 1) * sizeof(nkImageAtlasNode_t));
+        page->nodeCount--;
+    }
+
+    /* neighbours at the same height become one node */
+    for (size_t i = 0; i + 1 < page->nodeCount; )
+    {
+        if (page->nodes[i].y == page->nodes[i + 1].y)
+        {
+            page->nodes[i].width += page->nodes[i + 1].width;
+            memmove(&page->nodes[i + 1], &page->nodes[i + 2], (page->nodeCount - i - 2) * sizeof(nkImageAtlasNode_t));
+            page->nodeCount--;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,90 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkimageatlas.h
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-12 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Image Atlas Packer
+**
+***************************************************************/
+
+#ifndef NKIMAGEATLAS_H
+#define NKIMAGEATLAS_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/* pixels around each packed image repeating its edges, so filtering never reads a neighbour */
+#define NK_IMAGE_ATLAS_PADDING (2U)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* top edge of the packed area over [x, x + width) */
+typedef struct
+{
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+} nkImageAtlasNode_t;
+
+typedef struct
+{
+    uint32_t texture;           /* the backend's, 0 until the caller creates it */
+    nkImageAtlasNode_t *nodes;  /* skyline, left to right */
+    size_t nodeCount;
+    size_t nodeCapacity;
+    uint32_t images;            /* live images; space is only reclaimed once they are all freed */
+} nkImageAtlasPage_t;
+
+/* packs small RGBA images into square pages shared between them, so drawing many of them
+** binds one texture. only the layout is kept here, pixels live in the backend's textures.
+** zero-initialised atlases pack nothing. */
+typedef struct
+{
+    uint32_t pageSize;
+    uint32_t limit;             /* largest side packed */
+
+    nkImageAtlasPage_t *pages;
+    size_t pageCount;
+    size_t pageCapacity;
+} nkImageAtlas_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* limit is clamped so a padded image fits a page, 0 packs nothing */
+void nkImageAtlas_Init(nkImageAtlas_t *atlas, uint32_t pageSize, uint32_t limit);
+
+/* the page textures are left to the caller */
+void nkImageAtlas_Destroy(nkImageAtlas_t *atlas);
+
+bool nkImageAtlas_Fits(const nkImageAtlas_t *atlas, uint32_t width, uint32_t height);
+
+/* reserves a padded width x height image, returning its page and the top left corner of the
+** image inside the padding. pages added for it have texture 0. false when it does not fit
+** or no page can be added. */
+bool nkImageAtlas_Alloc(nkImageAtlas_t *atlas, uint32_t width, uint32_t height, uint32_t *page, uint32_t *x, uint32_t *y);
+
+/* releases an image of page, emptying the page once it holds none */
+void nkImageAtlas_Free(nkImageAtlas_t *atlas, uint32_t page);
+
+/* copies RGBA pixels to dst, the top left corner of the padding, with the padding repeating
+** the edge pixels. stride is in bytes. */
+void nkImageAtlas_Pad(const uint8_t *pixels, uint32_t width, uint32_t height, uint8_t *dst, size_t stride);
+
+#endif /* NKIMAGEATLAS_H */
@@ -0,0 +1,310 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkimagedecoder.c
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-05 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Background Image Decoder
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkimagedecoder.h"
+#include "nkfilemap.h"
+#include "nkmipmap.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+/* the implementation is compiled by whichever of nanovg.c or the batched backend is built */
+#include <extern/stb/stb_image.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define NK_IMAGE_DECODER_MIN_JOBS (16U)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static nkImageJob_t *nkImageDecoder_Push(nkImageDecoder_t *decoder, uint32_t image);
+static void nkImageDecoder_FreeJob(nkImageJob_t *job);
+static void nkImageDecoder_Decode(void *user, size_t index);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkImageDecoder_Init(nkImageDecoder_t *decoder, size_t threads)
+{
+    memset(decoder, 0, sizeof(nkImageDecoder_t));
+
+    /* batches run on the workers alone, the caller's thread is not one of them */
+    decoder->threads = threads ? threads : nkThreadPool_CoreCount() + 1;
+}
+
+void nkImageDecoder_Destroy(nkImageDecoder_t *decoder)
+{
+    nkThreadPool_Join(decoder->pool);
+
+    for (size_t i = 0; i < decoder->batchCount; i++)
+    {
+        nkImageDecoder_FreeJob(&decoder->batch[i]);
+    }
+
+    for (size_t i = 0; i < decoder->queuedCount; i++)
+    {
+        nkImageDecoder_FreeJob(&decoder->queued[i]);
+    }
+
+    nkThreadPool_Destroy(decoder->pool);
+    free(decoder->batch);
+    free(decoder->queued);
+
+    memset(decoder, 0, sizeof(nkImageDecoder_t));
+}
+
+bool nkImageDecoder_QueueMemory(nkImageDecoder_t *decoder, uint32_t image, const uint8_t *data, size_t size)
+{
+    nkImageJob_t *job = nkImageDecoder_Push(decoder, image);
+
+    if (!job)
+    {
+        return false;
+    }
+
+    job->data = (uint8_t*)malloc(size > 0 ? size : 1);
+
+    if (!job->data)
+    {
+        fprintf(stderr, "ERROR: Failed to copy %zu bytes of image data.\n", size);
+        decoder->queuedCount--;
+        return false;
+    }
+
+    memcpy(job->data, data, size);
+    job->size = size;
+
+    return true;
+}
+
+bool nkImageDecoder_QueueFile(nkImageDecoder_t *decoder, uint32_t image, const char *path)
+{
+    nkImageJob_t *job = nkImageDecoder_Push(decoder, image);
+
+    if (!job)
+    {
+        return false;
+    }
+
+    size_t length = strlen(path);
+    job->path = (char*)malloc(length + 1);
+
+    if (!job->path)
+    {
+        fprintf(stderr, "ERROR: Failed to copy image path.\n");
+        decoder->queuedCount--;
+        return false;
+    }
+
+    memcpy(job->path, path, length + 1);
+
+    return true;
+}
+
+void nkImageDecoder_Cancel(nkImageDecoder_t *decoder, uint32_t image)
+{
+    size_t kept = 0;
+
+    for (size_t i = 0; i < decoder->queuedCount; i++)
+    {
+        if (decoder->queued[i].image == image)
+        {
+            nkImageDecoder_FreeJob(&decoder->queued[i]);
+        }
+        else
+        {
+            decoder->queued[kept++] = decoder->queued[i];
+        }
+    }
+
+    decoder->queuedCount = kept;
+
+    /* workers never read the flag, it is only checked once they are done */
+    for (size_t i = 0; i < decoder->batchCount; i++)
+    {
+        if (decoder->batch[i].image == image)
+        {
+            decoder->batch[i].cancelled = true;
+        }
+    }
+}
+
+size_t nkImageDecoder_Poll(nkImageDecoder_t *decoder, nkImageDecoderDone_t done, void *user)
+{
+    size_t handled = 0;
+
+    if (decoder->batchCount > 0)
+    {
+        if (!nkThreadPool_IsIdle(decoder->pool))
+        {
+            return 0;
+        }
+
+        for (size_t i = 0; i < decoder->batchCount; i++)
+        {
+            nkImageJob_t *job = &decoder->batch[i];
+
+            if (!job->cancelled)
+            {
+                done(user, job);
+                handled++;
+            }
+
+            nkImageDecoder_FreeJob(job);
+        }
+
+        decoder->batchCount = 0;
+    }
+
+    nkImageDecoder_Start(decoder);
+
+    return handled;
+}
+
+void nkImageDecoder_Start(nkImageDecoder_t *decoder)
+{
+    if (decoder->batchCount > 0 || decoder->queuedCount == 0)
+    {
+        return;
+    }
+
+    /* the arrays swap, so the queue keeps growing while the workers own the batch */
+    nkImageJob_t *jobs = decoder->batch;
+    size_t capacity = decoder->batchCapacity;
+
+    decoder->batch = decoder->queued;
+    decoder->batchCapacity = decoder->queuedCapacity;
+    decoder->batchCount = decoder->queuedCount;
+
+    decoder->queued = jobs;
+    decoder->queuedCapacity = capacity;
+    decoder->queuedCount = 0;
+
+    if (!decoder->pool)
+    {
+        decoder->pool = nkThreadPool_Create(decoder->threads);
+    }
+
+    nkThreadPool_Dispatch(decoder->pool, decoder->batchCount, nkImageDecoder_Decode, decoder);
+}
+
+size_t nkImageDecoder_PendingCount(const nkImageDecoder_t *decoder)
+{
+    return decoder->queuedCount + decoder->batchCount;
+}
+
+void nkImageDecoder_FreePixels(uint8_t *pixels)
+{
+    stbi_image_free(pixels);
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static nkImageJob_t *nkImageDecoder_Push(nkImageDecoder_t *decoder, uint32_t image)
+{
+    if (decoder->queuedCount == decoder->queuedCapacity)
+    {
+        size_t capacity = decoder->queuedCapacity ? decoder->queuedCapacity * 2 : NK_IMAGE_DECODER_MIN_JOBS;
+        nkImageJob_t *jobs = (nkImageJob_t*)realloc(decoder->queued, capacity * sizeof(nkImageJob_t));
+
+        if (!jobs)
+        {
+            fprintf(stderr, "ERROR: Failed to queue image decode.\n");
+            return NULL;
+        }
+
+        decoder->queued = jobs;
+        decoder->queuedCapacity = capacity;
+    }
+
+    nkImageJob_t *job = &decoder->queued[decoder->queuedCount++];
+    memset(job, 0, sizeof(nkImageJob_t));
+    job->image = image;
+
+    return job;
+}
+
+static void nkImageDecoder_FreeJob(nkImageJob_t *job)
+{
+    free(job->data);
+    free(job->path);
+    stbi_image_free(job->pixels);
+    free(job->mipmaps);
+    memset(job, 0, sizeof(nkImageJob_t));
+}
+
+/* worker side, touches nothing but its job and only reads the decoder's settings */
+static void nkImageDecoder_Decode(void *user, size_t index)
+{
+    const nkImageDecoder_t *decoder = (const nkImageDecoder_t*)user;
+    nkImageJob_t *job = &decoder->batch[index];
+    const uint8_t *data = job->data;
+    size_t size = job->size;
+    nkFileMap_t file = { 0 };
+
+    if (!data && nkFileMap_Open(&file, job->path))
+    {
+        data = file.data;
+        size = file.size;
+    }
+
+    if (data && size <= INT_MAX)
+    {
+        int channels;
+        job->pixels = stbi_load_from_memory(data, (int)size, &job->width, &job->height, &channels, 4);
+    }
+
+    nkFileMap_Close(&file);
+    free(job->data);
+    job->data = NULL;
+
+    if (!job->pixels)
+    {
+        fprintf(stderr, "ERROR: Failed to decode image %s.\n", job->path ? job->path : "from memory");
+        return;
+    }
+
+    /* the pyramid is built here so the caller's thread only uploads it */
+    job->levels = 1;
+
+    if (decoder->mipmaps && ((uint32_t)job->width > decoder->mipmapAbove || (uint32_t)job->height > decoder->mipmapAbove))
+    {
+        uint32_t levels = nkMipmap_LevelCount((uint32_t)job->width, (uint32_t)job->height);
+
+        if ((job->mipmaps = nkMipmap_Build(job->pixels, (uint32_t)job->width, (uint32_t)job->height, levels)) != NULL)
+        {
+            job->levels = levels;
+        }
+    }
+}
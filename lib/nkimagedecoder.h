@@ -0,0 +1,103 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkimagedecoder.h
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-05 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Background Image Decoder
+**
+***************************************************************/
+
+#ifndef NKIMAGEDECODER_H
+#define NKIMAGEDECODER_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "nkthreadpool.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* one image to decode with stb_image. the source is freed, and pixels filled, on a worker */
+typedef struct
+{
+    uint32_t image;   /* caller's id for the image */
+    uint8_t *data;    /* encoded bytes, owned */
+    size_t size;
+    char *path;       /* mapped and decoded on the worker when data is NULL, owned */
+    uint8_t *pixels;  /* RGBA8, straight alpha, NULL when decoding failed */
+    int width;
+    int height;
+    uint8_t *mipmaps; /* levels 1 and up of pixels, see nkMipmap_Build, NULL without them */
+    uint32_t levels;  /* 1 without mipmaps */
+    bool cancelled;   /* freed while decoding, the result is dropped */
+} nkImageJob_t;
+
+/* handles the pixels of a decoded job. they are freed afterwards unless done takes them,
+** leaving NULL behind and freeing them later with nkImageDecoder_FreePixels and free */
+typedef void (*nkImageDecoderDone_t)(void *user, nkImageJob_t *job);
+
+/* decodes images on a worker pool without blocking the caller. jobs queue up while a batch is
+** decoding and go out as the next batch once the caller has collected its results, so the
+** caller never waits on a worker. zero-initialised decoders are valid and idle. */
+typedef struct
+{
+    nkThreadPool_t *pool; /* started by the first batch */
+    size_t threads;       /* as for nkThreadPool_Create, so one more than the workers */
+    bool mipmaps;         /* build mip pyramids on the workers for images above mipmapAbove */
+    uint32_t mipmapAbove; /* largest side of images left without */
+
+    nkImageJob_t *queued; /* waiting for the next batch */
+    size_t queuedCount;
+    size_t queuedCapacity;
+
+    nkImageJob_t *batch;  /* owned by the workers until the pool is idle */
+    size_t batchCount;
+    size_t batchCapacity;
+} nkImageDecoder_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* threads as for nkThreadPool_Create, 0 for one worker per core */
+void nkImageDecoder_Init(nkImageDecoder_t *decoder, size_t threads);
+
+/* waits for the batch in flight and drops every job */
+void nkImageDecoder_Destroy(nkImageDecoder_t *decoder);
+
+/* data is copied. false when the job cannot be allocated */
+bool nkImageDecoder_QueueMemory(nkImageDecoder_t *decoder, uint32_t image, const uint8_t *data, size_t size);
+bool nkImageDecoder_QueueFile(nkImageDecoder_t *decoder, uint32_t image, const char *path);
+
+/* drops the jobs of image, done is not called for them */
+void nkImageDecoder_Cancel(nkImageDecoder_t *decoder, uint32_t image);
+
+/* hands the queued jobs to the workers as one batch, unless a batch is still out. never waits */
+void nkImageDecoder_Start(nkImageDecoder_t *decoder);
+
+/* if the batch in flight has finished, calls done for each of its jobs and starts the queued
+** ones. never waits. returns the jobs handed to done. */
+size_t nkImageDecoder_Poll(nkImageDecoder_t *decoder, nkImageDecoderDone_t done, void *user);
+
+/* jobs queued or decoding */
+size_t nkImageDecoder_PendingCount(const nkImageDecoder_t *decoder);
+
+/* frees pixels taken from a job, which stb_image allocated */
+void nkImageDecoder_FreePixels(uint8_t *pixels);
+
+#endif /* NKIMAGEDECODER_H */
@@ -0,0 +1,499 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkimagetable.c
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-27 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Image Table
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkimagetable.h"
+#include "nkmipmap.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define NK_IMAGE_TABLE_MIN_CAPACITY (64U)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static uint32_t nkImageTable_Alloc(nkImageTable_t *table);
+static void nkImageTable_Upload(void *user, nkImageJob_t *job);
+static bool nkImageTable_Pack(nkImageTable_t *table, nkImageRecord_t *record, const nkImageJob_t *job);
+static void nkImageTable_StageLevels(nkImageTable_t *table, nkImageRecord_t *record, nkImageJob_t *job);
+static void nkImageTable_UploadLevels(nkImageTable_t *table, size_t budget);
+static bool nkImageTable_CreateLevels(nkImageTable_t *table, nkImageRecord_t *record);
+static void nkImageTable_ReleaseLevels(nkImageTable_t *table, nkImageRecord_t *record);
+static void nkImageTable_FitLevels(nkImageRecord_t *record, float w, float h);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkImageTable_Init(nkImageTable_t *table, const nkImageTextures_t *textures, size_t threads, uint32_t pageSize, uint32_t atlasLimit, bool mipmaps, bool fitLevels)
+{
+    memset(table, 0, sizeof(nkImageTable_t));
+
+    table->textures = *textures;
+    table->fitLevels = mipmaps && fitLevels;
+
+    nkImageDecoder_Init(&table->decoder, threads);
+    nkImageAtlas_Init(&table->atlas, pageSize, atlasLimit);
+    table->decoder.mipmaps = mipmaps;
+    table->decoder.mipmapAbove = table->atlas.limit;
+}
+
+void nkImageTable_Destroy(nkImageTable_t *table)
+{
+    nkImageDecoder_Destroy(&table->decoder);
+
+    for (size_t i = 0; i < table->count; i++)
+    {
+        nkImageRecord_t *record = &table->images[i];
+
+        nkImageTable_ReleaseLevels(table, record);
+
+        if (record->texture && !record->page)
+        {
+            table->textures.deleteTexture(table->textures.user, record->texture);
+        }
+    }
+
+    for (size_t i = 0; i < table->atlas.pageCount; i++)
+    {
+        if (table->atlas.pages[i].texture)
+        {
+            table->textures.deleteTexture(table->textures.user, table->atlas.pages[i].texture);
+        }
+    }
+
+    nkImageAtlas_Destroy(&table->atlas);
+    free(table->images);
+    free(table->staging);
+    memset(table, 0, sizeof(nkImageTable_t));
+}
+
+uint32_t nkImageTable_LoadFile(nkImageTable_t *table, const char *path)
+{
+    uint32_t id = nkImageTable_Alloc(table);
+
+    if (id && !nkImageDecoder_QueueFile(&table->decoder, id, path))
+    {
+        table->images[id - 1].state = NK_IMAGE_EMPTY;
+        id = 0;
+    }
+
+    return id;
+}
+
+uint32_t nkImageTable_LoadMemory(nkImageTable_t *table, const uint8_t *data, size_t size)
+{
+    uint32_t id = nkImageTable_Alloc(table);
+
+    if (id && !nkImageDecoder_QueueMemory(&table->decoder, id, data, size))
+    {
+        table->images[id - 1].state = NK_IMAGE_EMPTY;
+        id = 0;
+    }
+
+    return id;
+}
+
+void nkImageTable_Free(nkImageTable_t *table, uint32_t id)
+{
+    nkImageRecord_t *record = nkImageTable_Find(table, id);
+
+    if (!record)
+    {
+        return;
+    }
+
+    nkImageDecoder_Cancel(&table->decoder, id);
+    nkImageTable_ReleaseLevels(table, record);
+
+    /* mipmapped images have their texture while still loading */
+    if (record->state == NK_IMAGE_READY && record->page)
+    {
+        nkImageAtlas_Free(&table->atlas, record->page - 1);
+    }
+    else if (record->texture)
+    {
+        table->textures.deleteTexture(table->textures.user, record->texture);
+        table->textureBytes -= record->textureBytes;
+    }
+
+    memset(record, 0, sizeof(*record));
+}
+
+nkImageRecord_t *nkImageTable_Find(nkImageTable_t *table, uint32_t id)
+{
+    if (id == 0 || id > table->count)
+    {
+        return NULL;
+    }
+
+    nkImageRecord_t *record = &table->images[id - 1];
+    return record->state != NK_IMAGE_EMPTY ? record : NULL;
+}
+
+nkImageState_t nkImageTable_GetState(nkImageTable_t *table, uint32_t id, uint32_t *width, uint32_t *height)
+{
+    nkImageRecord_t *record = nkImageTable_Find(table, id);
+
+    if (width)
+    {
+        *width = record ? record->width : 0;
+    }
+
+    if (height)
+    {
+        *height = record ? record->height : 0;
+    }
+
+    return record ? record->state : NK_IMAGE_EMPTY;
+}
+
+void nkImageTable_GetMemory(nkImageTable_t *table, uint32_t id, nkImageMemory_t *memory)
+{
+    nkImageRecord_t *record = nkImageTable_Find(table, id);
+
+    memset(memory, 0, sizeof(nkImageMemory_t));
+
+    if (!record)
+    {
+        return;
+    }
+
+    memory->textureBytes = record->textureBytes;
+    memory->stagedBytes = record->stagedBytes;
+    memory->firstLevel = record->firstLevel != UINT32_MAX ? record->firstLevel : 0;
+    memory->levels = record->levels - memory->firstLevel;
+}
+
+void nkImageTable_Update(nkImageTable_t *table, size_t budget)
+{
+    nkImageDecoder_Poll(&table->decoder, nkImageTable_Upload, table);
+    free(table->staging);
+    table->staging = NULL;
+
+    if (table->staged)
+    {
+        nkImageTable_UploadLevels(table, budget);
+    }
+}
+
+void nkImageTable_Start(nkImageTable_t *table)
+{
+    nkImageDecoder_Start(&table->decoder);
+}
+
+const nkImageRecord_t *nkImageTable_Draw(nkImageTable_t *table, uint32_t id, float w, float h, bool *pending)
+{
+    nkImageRecord_t *record = nkImageTable_Find(table, id);
+
+    *pending = false;
+
+    if (!record || w <= 0.0f || h <= 0.0f)
+    {
+        return NULL;
+    }
+
+    /* FIT images size their texture on the first draw, uploads start at the next update */
+    if (record->pixels && !record->texture && table->fitLevels)
+    {
+        nkImageTable_FitLevels(record, w, h);
+    }
+
+    *pending = record->state == NK_IMAGE_LOADING || record->pixels;
+    return record;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+/* id of an empty slot, marked loading, 0 when the table cannot grow */
+static uint32_t nkImageTable_Alloc(nkImageTable_t *table)
+{
+    size_t slot = 0;
+
+    while (slot < table->count && table->images[slot].state != NK_IMAGE_EMPTY)
+    {
+        slot++;
+    }
+
+    if (slot == table->count && slot == table->capacity)
+    {
+        size_t capacity = table->capacity ? table->capacity * 2 : NK_IMAGE_TABLE_MIN_CAPACITY;
+        nkImageRecord_t *images = capacity <= UINT32_MAX ? (nkImageRecord_t*)realloc(table->images, capacity * sizeof(nkImageRecord_t)) : NULL;
+
+        if (!images)
+        {
+            fprintf(stderr, "ERROR: Failed to grow the image table.\n");
+            return 0;
+        }
+
+        table->images = images;
+        table->capacity = capacity;
+    }
+
+    if (slot == table->count)
+    {
+        table->count++;
+    }
+
+    memset(&table->images[slot], 0, sizeof(nkImageRecord_t));
+    table->images[slot].state = NK_IMAGE_LOADING;
+
+    return (uint32_t)slot + 1;
+}
+
+static void nkImageTable_Upload(void *user, nkImageJob_t *job)
+{
+    nkImageTable_t *table = (nkImageTable_t*)user;
+    nkImageRecord_t *record = &table->images[job->image - 1];
+
+    if (job->pixels && job->levels > 1)
+    {
+        nkImageTable_StageLevels(table, record, job);
+        return;
+    }
+
+    if (job->pixels && nkImageTable_Pack(table, record, job))
+    {
+        return;
+    }
+
+    uint32_t texture = job->pixels ? table->textures.createTexture(table->textures.user, (uint32_t)job->width, (uint32_t)job->height, job->pixels) : 0;
+
+    record->state = texture ? NK_IMAGE_READY : NK_IMAGE_FAILED;
+    record->texture = texture;
+    record->width = texture ? (uint32_t)job->width : 0;
+    record->height = texture ? (uint32_t)job->height : 0;
+    record->page = 0;
+    record->u0 = 0.0f;
+    record->v0 = 0.0f;
+    record->u1 = 1.0f;
+    record->v1 = 1.0f;
+    record->levels = 1;
+    record->textureBytes = (size_t)record->width * record->height * 4;
+
+    table->textureBytes += record->textureBytes;
+}
+
+/* places a small image on an atlas page, false to give it a texture of its own */
+static bool nkImageTable_Pack(nkImageTable_t *table, nkImageRecord_t *record, const nkImageJob_t *job)
+{
+    const uint32_t size = table->atlas.pageSize;
+    const uint32_t pad = NK_IMAGE_ATLAS_PADDING;
+    uint32_t width = (uint32_t)job->width;
+    uint32_t height = (uint32_t)job->height;
+    uint32_t page = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+
+    if (!nkImageAtlas_Alloc(&table->atlas, width, height, &page, &x, &y))
+    {
+        return false;
+    }
+
+    nkImageAtlasPage_t *target = &table->atlas.pages[page];
+
+    /* regions are uploaded out of a whole-page buffer, as NanoVG takes them, so one buffer
+    ** serves every upload of the update instead of keeping a copy of each page */
+    if (!table->staging)
+    {
+        table->staging = (uint8_t*)malloc((size_t)size * size * 4);
+    }
+
+    if (!target->texture && (target->texture = table->textures.createTexture(table->textures.user, size, size, NULL)) != 0)
+    {
+        table->textureBytes += (size_t)size * size * 4;
+    }
+
+    if (!table->staging || !target->texture)
+    {
+        nkImageAtlas_Free(&table->atlas, page);
+        return false;
+    }
+
+    nkImageAtlas_Pad(job->pixels, width, height, table->staging + (((size_t)(y - pad) * size) + (x - pad)) * 4, (size_t)size * 4);
+    table->textures.updateRegion(table->textures.user, target->texture, x - pad, y - pad, width + 2 * pad, height + 2 * pad, table->staging, size);
+
+    record->state = NK_IMAGE_READY;
+    record->texture = target->texture;
+    record->width = width;
+    record->height = height;
+    record->page = page + 1;
+    record->u0 = (float)x / (float)size;
+    record->v0 = (float)y / (float)size;
+    record->u1 = (float)(x + width) / (float)size;
+    record->v1 = (float)(y + height) / (float)size;
+    record->levels = 1;
+    record->textureBytes = (size_t)(width + 2 * pad) * (height + 2 * pad) * 4;
+
+    return true;
+}
+
+/* keeps the decoded pyramid for nkImageTable_UploadLevels, the image stays loading until its
+** coarsest level is in */
+static void nkImageTable_StageLevels(nkImageTable_t *table, nkImageRecord_t *record, nkImageJob_t *job)
+{
+    record->pixels = job->pixels;
+    record->mipmaps = job->mipmaps;
+    record->width = (uint32_t)job->width;
+    record->height = (uint32_t)job->height;
+    record->levels = job->levels;
+    record->firstLevel = table->fitLevels ? UINT32_MAX : 0;
+    record->baseLevel = job->levels;
+    record->stagedBytes = nkMipmap_PyramidBytes(record->width, record->height, 0, record->levels);
+    record->u0 = 0.0f;
+    record->v0 = 0.0f;
+    record->u1 = 1.0f;
+    record->v1 = 1.0f;
+
+    job->pixels = NULL;
+    job->mipmaps = NULL;
+
+    table->stagedBytes += record->stagedBytes;
+    table->staged++;
+}
+
+/* uploads staged levels from the coarsest up within budget, so a large photo never stalls a
+** frame and shows blurred at once */
+static void nkImageTable_UploadLevels(nkImageTable_t *table, size_t budget)
+{
+    size_t spent = 0;
+
+    for (size_t i = 0; i < table->count && table->staged && spent < budget; i++)
+    {
+        nkImageRecord_t *record = &table->images[i];
+
+        /* FIT images wait for their first draw to know which levels they need */
+        if (!record->pixels || record->firstLevel == UINT32_MAX)
+        {
+            continue;
+        }
+
+        if (!record->texture && !nkImageTable_CreateLevels(table, record))
+        {
+            continue;
+        }
+
+        while (record->baseLevel > record->firstLevel)
+        {
+            uint32_t level = record->baseLevel - 1;
+            uint32_t width, height;
+            size_t bytes = nkMipmap_LevelBytes(record->width, record->height, level);
+
+            if (spent > 0 && spent + bytes > budget)
+            {
+                break;
+            }
+
+            nkMipmap_LevelSize(record->width, record->height, level, &width, &height);
+            table->textures.updateLevel(table->textures.user, record->texture, level - record->firstLevel, width, height,
+                nkMipmap_Level(record->pixels, record->mipmaps, record->width, record->height, level));
+
+            spent += bytes;
+            record->baseLevel = level;
+            record->state = NK_IMAGE_READY;
+        }
+
+        if (record->baseLevel == record->firstLevel)
+        {
+            nkImageTable_ReleaseLevels(table, record);
+        }
+    }
+}
+
+/* a texture for levels firstLevel and down. backends without caller supplied levels get the
+** first level alone, which is then ready at once */
+static bool nkImageTable_CreateLevels(nkImageTable_t *table, nkImageRecord_t *record)
+{
+    uint32_t width, height;
+    uint32_t levels = record->levels - record->firstLevel;
+
+    nkMipmap_LevelSize(record->width, record->height, record->firstLevel, &width, &height);
+
+    uint32_t texture = table->textures.createLevels(table->textures.user, width, height, levels);
+
+    if (!texture)
+    {
+        const uint8_t *pixels = nkMipmap_Level(record->pixels, record->mipmaps, record->width, record->height, record->firstLevel);
+
+        texture = table->textures.createTexture(table->textures.user, width, height, pixels);
+        levels = 1;
+        record->levels = record->firstLevel + 1;
+        record->baseLevel = record->firstLevel;
+        record->state = texture ? NK_IMAGE_READY : NK_IMAGE_FAILED;
+    }
+
+    if (!texture)
+    {
+        nkImageTable_ReleaseLevels(table, record);
+        return false;
+    }
+
+    record->texture = texture;
+    record->textureBytes = nkMipmap_PyramidBytes(record->width, record->height, record->firstLevel, record->firstLevel + levels);
+    table->textureBytes += record->textureBytes;
+
+    return true;
+}
+
+static void nkImageTable_ReleaseLevels(nkImageTable_t *table, nkImageRecord_t *record)
+{
+    if (!record->pixels)
+    {
+        return;
+    }
+
+    nkImageDecoder_FreePixels(record->pixels);
+    free(record->mipmaps);
+    record->pixels = NULL;
+    record->mipmaps = NULL;
+
+    table->stagedBytes -= record->stagedBytes;
+    record->stagedBytes = 0;
+    table->staged--;
+}
+
+/* the coarsest level still at least the drawn size, the finest over every draw so far */
+static void nkImageTable_FitLevels(nkImageRecord_t *record, float w, float h)
+{
+    float scale = fminf((float)record->width / w, (float)record->height / h);
+    uint32_t level = 0;
+
+    while (scale >= 2.0f && level + 1 < record->levels)
+    {
+        scale *= 0.5f;
+        level++;
+    }
+
+    record->firstLevel = level < record->firstLevel ? level : record->firstLevel;
+}
@@ -0,0 +1,152 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkimagetable.h
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-27 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Image Table
+**
+***************************************************************/
+
+#ifndef NKIMAGETABLE_H
+#define NKIMAGETABLE_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "nkimagedecoder.h"
+#include "nkimageatlas.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef enum
+{
+    NK_IMAGE_EMPTY,   /* never loaded, or freed */
+    NK_IMAGE_LOADING, /* decoding, or waiting for nkImageTable_Update to upload it */
+    NK_IMAGE_READY,
+    NK_IMAGE_FAILED   /* could not be read or decoded */
+} nkImageState_t;
+
+typedef struct
+{
+    nkImageState_t state;
+    uint32_t texture; /* the backend's, shared by every image of an atlas page */
+    uint32_t width;
+    uint32_t height;
+    uint32_t page;    /* atlas page + 1, 0 when the image has a texture to itself */
+    float u0, v0;     /* the image's rect in the texture, normalized */
+    float u1, v1;
+
+    /* mipmapped images, levels indexing the decoded pyramid */
+    uint8_t *pixels;      /* level 0 while levels wait for upload, owned */
+    uint8_t *mipmaps;     /* the rest of the pyramid, see nkMipmap_Build, owned */
+    uint32_t levels;      /* 1 without a pyramid */
+    uint32_t firstLevel;  /* the texture's level 0, UINT32_MAX until a FIT image is drawn */
+    uint32_t baseLevel;   /* finest level uploaded, levels before the first */
+    size_t textureBytes;  /* texture memory, the padded rect of packed images */
+    size_t stagedBytes;   /* decoded levels waiting for upload */
+} nkImageRecord_t;
+
+typedef struct
+{
+    size_t textureBytes; /* texture memory, including levels not uploaded yet; packed images count their padded rect */
+    size_t stagedBytes;  /* decoded pixels held until they are uploaded */
+    uint32_t levels;     /* mipmap levels of the texture, 1 without */
+    uint32_t firstLevel; /* levels of the decoded image dropped above the texture's finest one */
+} nkImageMemory_t;
+
+/* the backend's side of the table: RGBA8 textures, bilinear filtered with clamped edges.
+** texture names are nonzero, 0 reports a failure */
+typedef struct
+{
+    void *user;
+
+    /* pixels may be NULL */
+    uint32_t (*createTexture)(void *user, uint32_t width, uint32_t height, const uint8_t *pixels);
+
+    /* storage for levels of a width x height image sampling none of them until they are
+    ** uploaded, 0 when the backend cannot take caller supplied levels */
+    uint32_t (*createLevels)(void *user, uint32_t width, uint32_t height, uint32_t levels);
+
+    /* fills level, then samples from it down. uploads run from the coarsest level up */
+    void (*updateLevel)(void *user, uint32_t texture, uint32_t level, uint32_t width, uint32_t height, const uint8_t *pixels);
+
+    /* copies a rect of page, pixels for the whole pageSize x pageSize texture */
+    void (*updateRegion)(void *user, uint32_t texture, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const uint8_t *page, uint32_t pageSize);
+
+    void (*deleteTexture)(void *user, uint32_t texture);
+} nkImageTextures_t;
+
+/* the images of a context: decoded on worker threads, packed into atlas pages when small,
+** staged as mip pyramids when large, and accounted for. only the textures are left to the
+** backend. ids are slot + 1, 0 being empty. */
+typedef struct
+{
+    nkImageRecord_t *images; /* indexed by id - 1 */
+    size_t count;
+    size_t capacity;
+
+    nkImageDecoder_t decoder;
+    nkImageAtlas_t atlas;
+    nkImageTextures_t textures;
+    bool fitLevels;          /* mipmapped textures start at the level of their first draw */
+
+    uint8_t *staging;        /* atlas page sized while nkImageTable_Update uploads */
+    size_t staged;           /* images with levels waiting for upload */
+
+    size_t textureBytes;     /* textures of images and atlas pages, each page once */
+    size_t stagedBytes;      /* decoded levels waiting for upload */
+} nkImageTable_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* threads as for nkImageDecoder_Init. images no larger than atlasLimit share pageSize pages,
+** 0 gives each its own texture. larger ones get mip pyramids with mipmaps, fitLevels holding
+** their levels until they are first drawn. */
+void nkImageTable_Init(nkImageTable_t *table, const nkImageTextures_t *textures, size_t threads, uint32_t pageSize, uint32_t atlasLimit, bool mipmaps, bool fitLevels);
+
+/* waits for the decoder and deletes every texture */
+void nkImageTable_Destroy(nkImageTable_t *table);
+
+/* queue an image for decoding, returning its id loading, or 0 when it could not be queued */
+uint32_t nkImageTable_LoadFile(nkImageTable_t *table, const char *path);
+uint32_t nkImageTable_LoadMemory(nkImageTable_t *table, const uint8_t *data, size_t size);
+
+void nkImageTable_Free(nkImageTable_t *table, uint32_t id);
+
+/* NULL for empty ids */
+nkImageRecord_t *nkImageTable_Find(nkImageTable_t *table, uint32_t id);
+
+nkImageState_t nkImageTable_GetState(nkImageTable_t *table, uint32_t id, uint32_t *width, uint32_t *height);
+
+/* zeroed for empty ids */
+void nkImageTable_GetMemory(nkImageTable_t *table, uint32_t id, nkImageMemory_t *memory);
+
+/* uploads the images decoded since the last call, then staged levels from the coarsest up, at
+** least one and otherwise no more than budget bytes of them. never waits on the decoder */
+void nkImageTable_Update(nkImageTable_t *table, size_t budget);
+
+/* starts decoding the images loaded since the last call */
+void nkImageTable_Start(nkImageTable_t *table);
+
+/* the image to draw at w x h, NULL for empty ids and rects. images only draw once ready;
+** pending is set while what they draw will still change, loading or refining */
+const nkImageRecord_t *nkImageTable_Draw(nkImageTable_t *table, uint32_t id, float w, float h, bool *pending);
+
+#endif /* NKIMAGETABLE_H */
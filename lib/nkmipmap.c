@@ -0,0 +1,176 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkmipmap.c
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-19 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Mipmap Pyramids
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkmipmap.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/* SSE2 is baseline on x86-64, the vector loop rounds exactly like the scalar one */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define NK_MIPMAP_SSE2 1
+#else
+    #define NK_MIPMAP_SSE2 0
+#endif
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+uint32_t nkMipmap_LevelCount(uint32_t width, uint32_t height)
+{
+    uint32_t side = width > height ? width : height;
+    uint32_t levels = 1;
+
+    while (side > 1 && levels < NK_MIPMAP_MAX_LEVELS)
+    {
+        side >>= 1;
+        levels++;
+    }
+
+    return levels;
+}
+
+void nkMipmap_LevelSize(uint32_t width, uint32_t height, uint32_t level, uint32_t *levelWidth, uint32_t *levelHeight)
+{
+    *levelWidth = (width >> level) ? (width >> level) : 1;
+    *levelHeight = (height >> level) ? (height >> level) : 1;
+}
+
+size_t nkMipmap_LevelBytes(uint32_t width, uint32_t height, uint32_t level)
+{
+    uint32_t levelWidth, levelHeight;
+
+    nkMipmap_LevelSize(width, height, level, &levelWidth, &levelHeight);
+    return (size_t)levelWidth * levelHeight * 4;
+}
+
+size_t nkMipmap_PyramidBytes(uint32_t width, uint32_t height, uint32_t first, uint32_t levels)
+{
+    size_t bytes = 0;
+
+    for (uint32_t level = first; level < levels; level++)
+    {
+        bytes += nkMipmap_LevelBytes(width, height, level);
+    }
+
+    return bytes;
+}
+
+uint8_t *nkMipmap_Build(const uint8_t *pixels, uint32_t width, uint32_t height, uint32_t levels)
+{
+    if (levels <= 1)
+    {
+        return NULL;
+    }
+
+    uint8_t *chain = (uint8_t*)malloc(nkMipmap_PyramidBytes(width, height, 1, levels));
+
+    if (!chain)
+    {
+        fprintf(stderr, "ERROR: Failed to allocate %u mipmap levels.\n", levels - 1);
+        return NULL;
+    }
+
+    /* each level reads the one just written, which is still in cache for small levels */
+    for (uint32_t level = 1; level < levels; level++)
+    {
+        uint32_t sourceWidth, sourceHeight;
+
+        nkMipmap_LevelSize(width, height, level - 1, &sourceWidth, &sourceHeight);
+        nkMipmap_Downsample(nkMipmap_Level(pixels, chain, width, height, level - 1), sourceWidth, sourceHeight, chain + nkMipmap_PyramidBytes(width, height, 1, level));
+    }
+
+    return chain;
+}
+
+const uint8_t *nkMipmap_Level(const uint8_t *pixels, const uint8_t *chain, uint32_t width, uint32_t height, uint32_t level)
+{
+    return level == 0 ? pixels : chain + nkMipmap_PyramidBytes(width, height, 1, level);
+}
+
+void nkMipmap_Downsample(const uint8_t *src, uint32_t width, uint32_t height, uint8_t *dst)
+{
+    uint32_t dstWidth, dstHeight;
+
+    nkMipmap_LevelSize(width, height, 1, &dstWidth, &dstHeight);
+
+    size_t stride = (size_t)width * 4;
+    size_t right = width > 1 ? 4 : 0;
+
+    for (uint32_t y = 0; y < dstHeight; y++)
+    {
+        const uint8_t *top = src + (size_t)(height > 1 ? 2 * y : y) * stride;
+        const uint8_t *bottom = height > 1 ? top + stride : top;
+        uint8_t *out = dst + (size_t)y * dstWidth * 4;
+        uint32_t x = 0;
+
+#if NK_MIPMAP_SSE2
+        if (width > 1)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i two = _mm_set1_epi16(2);
+
+            /* four source pixels of each row make two output pixels */
+            for (; x + 2 <= dstWidth; x += 2)
+            {
+                __m128i a = _mm_loadu_si128((const __m128i*)(top + (size_t)x * 8));
+                __m128i b = _mm_loadu_si128((const __m128i*)(bottom + (size_t)x * 8));
+                __m128i low = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+                __m128i high = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+                __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(low, high), _mm_unpackhi_epi64(low, high));
+
+                sum = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+                _mm_storel_epi64((__m128i*)(out + (size_t)x * 4), _mm_packus_epi16(sum, sum));
+            }
+        }
+#endif
+
+        for (; x < dstWidth; x++)
+        {
+            const uint8_t *a = top + (size_t)(width > 1 ? 2 * x : x) * 4;
+            const uint8_t *b = bottom + (size_t)(width > 1 ? 2 * x : x) * 4;
+
+            for (int c = 0; c < 4; c++)
+            {
+                out[x * 4 + c] = (uint8_t)((a[c] + a[c + right] + b[c] + b[c + right] + 2) >> 2);
+            }
+        }
+    }
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
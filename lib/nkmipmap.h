@@ -0,0 +1,59 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkmipmap.h
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-19 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Mipmap Pyramids
+**
+***************************************************************/
+
+#ifndef NKMIPMAP_H
+#define NKMIPMAP_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define NK_MIPMAP_MAX_LEVELS (16U)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* levels down to 1x1, each half the previous rounded down and at least 1, as GL sizes them */
+uint32_t nkMipmap_LevelCount(uint32_t width, uint32_t height);
+void nkMipmap_LevelSize(uint32_t width, uint32_t height, uint32_t level, uint32_t *levelWidth, uint32_t *levelHeight);
+size_t nkMipmap_LevelBytes(uint32_t width, uint32_t height, uint32_t level);
+
+/* bytes of levels first up to levels - 1 */
+size_t nkMipmap_PyramidBytes(uint32_t width, uint32_t height, uint32_t first, uint32_t levels);
+
+/* levels 1 up to levels - 1 of RGBA pixels, packed one after the other in a malloc'd chain
+** that nkMipmap_Level reads. each level box filters the one above it. NULL when levels is 1
+** or out of memory. */
+uint8_t *nkMipmap_Build(const uint8_t *pixels, uint32_t width, uint32_t height, uint32_t levels);
+
+/* level of an image, level 0 being pixels and the rest in chain */
+const uint8_t *nkMipmap_Level(const uint8_t *pixels, const uint8_t *chain, uint32_t width, uint32_t height, uint32_t level);
+
+/* halves RGBA src into dst, averaging each 2x2 block with rounding like glGenerateMipmap's box
+** filter. odd sides drop their last row or column, sides of 1 stay 1 */
+void nkMipmap_Downsample(const uint8_t *src, uint32_t width, uint32_t height, uint8_t *dst);
+
+#endif /* NKMIPMAP_H */
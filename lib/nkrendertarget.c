@@ -0,0 +1,140 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkrendertarget.c
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-05 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Retained GL Render Target
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkrendertarget.h"
+
+#include <stdio.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static bool nkRenderTarget_Create(nkRenderTarget_t *target, int width, int height);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool nkRenderTarget_Begin(nkRenderTarget_t *target, int width, int height)
+{
+    bool intact = target->framebuffer != 0 && target->width == width && target->height == height;
+
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &target->drawFramebuffer);
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &target->readFramebuffer);
+
+    if (!intact)
+    {
+        nkRenderTarget_Destroy(target);
+
+        if (width <= 0 || height <= 0 || !nkRenderTarget_Create(target, width, height))
+        {
+            nkRenderTarget_Destroy(target);
+            return false;
+        }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, target->framebuffer);
+    target->bound = true;
+    return intact;
+}
+
+void nkRenderTarget_End(nkRenderTarget_t *target)
+{
+    if (!target->bound)
+    {
+        return;
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, target->framebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, (GLuint)target->drawFramebuffer);
+    glBlitFramebuffer(0, 0, target->width, target->height, 0, 0, target->width, target->height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint)target->readFramebuffer);
+
+    target->bound = false;
+}
+
+void nkRenderTarget_Destroy(nkRenderTarget_t *target)
+{
+    if (target->framebuffer)
+    {
+        glDeleteFramebuffers(1, &target->framebuffer);
+    }
+
+    if (target->color)
+    {
+        glDeleteRenderbuffers(1, &target->color);
+    }
+
+    if (target->depthStencil)
+    {
+        glDeleteRenderbuffers(1, &target->depthStencil);
+    }
+
+    target->framebuffer = 0;
+    target->color = 0;
+    target->depthStencil = 0;
+    target->width = 0;
+    target->height = 0;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static bool nkRenderTarget_Create(nkRenderTarget_t *target, int width, int height)
+{
+    glGenRenderbuffers(1, &target->color);
+    glBindRenderbuffer(GL_RENDERBUFFER, target->color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    glGenRenderbuffers(1, &target->depthStencil);
+    glBindRenderbuffer(GL_RENDERBUFFER, target->depthStencil);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &target->framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, target->framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, target->color);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, target->depthStencil);
+
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, (GLuint)target->drawFramebuffer);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint)target->readFramebuffer);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        fprintf(stderr, "ERROR: Failed to create %dx%d render target (status 0x%x).\n", width, height, (unsigned)status);
+        return false;
+    }
+
+    target->width = width;
+    target->height = height;
+    return true;
+}
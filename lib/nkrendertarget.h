@@ -0,0 +1,68 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkrendertarget.h
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-05 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Retained GL Render Target
+**
+***************************************************************/
+
+#ifndef NKRENDERTARGET_H
+#define NKRENDERTARGET_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#if __EMSCRIPTEN__
+    #include <GLES3/gl3.h>
+#else
+    #include <extern/glad/glad.h>
+#endif
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* offscreen colour and stencil buffer that keeps its pixels between frames, unlike a window
+** framebuffer after a swap. zero-initialised targets are valid and empty. */
+typedef struct
+{
+    GLuint framebuffer;
+    GLuint color;
+    GLuint depthStencil;
+    int width;
+    int height;
+
+    bool bound;
+    GLint drawFramebuffer; /* caller's bindings, restored by nkRenderTarget_End */
+    GLint readFramebuffer;
+} nkRenderTarget_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* binds the target in place of the caller's framebuffer, (re)creating it at width x height.
+** returns false when the previous frame's pixels are gone: the target was just created or
+** resized, or could not be created and drawing stays on the caller's framebuffer. */
+bool nkRenderTarget_Begin(nkRenderTarget_t *target, int width, int height);
+
+/* copies the target to the caller's framebuffer and rebinds it */
+void nkRenderTarget_End(nkRenderTarget_t *target);
+
+void nkRenderTarget_Destroy(nkRenderTarget_t *target);
+
+#endif /* NKRENDERTARGET_H */
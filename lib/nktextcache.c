@@ -0,0 +1,300 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nktextcache.c
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-05 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Text Cache
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktextcache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define NK_TEXT_CACHE_FNV_OFFSET (0xcbf29ce484222325ULL)
+#define NK_TEXT_CACHE_FNV_PRIME  (0x100000001b3ULL)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static uint32_t nkTextCache_Bucket(const nkTextCache_t *cache, uint64_t hash, int faceId, float fontSize);
+static void nkTextCache_Unlink(nkTextCache_t *cache, uint16_t index);
+static void nkTextCache_PushFront(nkTextCache_t *cache, uint16_t index);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool nkTextCache_Init(nkTextCache_t *cache, size_t capacity)
+{
+    memset(cache, 0, sizeof(*cache));
+
+    if (capacity == 0 || capacity > NK_TEXT_CACHE_MAX_CAPACITY)
+    {
+        return false;
+    }
+
+    /* at most half full so chains stay short */
+    cache->bucketCount = 1;
+
+    while (cache->bucketCount < capacity * 2)
+    {
+        cache->bucketCount *= 2;
+    }
+
+    cache->entries = (nkTextCacheEntry_t*)calloc(capacity, sizeof(nkTextCacheEntry_t));
+    cache->buckets = (uint16_t*)malloc(cache->bucketCount * sizeof(uint16_t));
+
+    if (!cache->entries || !cache->buckets)
+    {
+        fprintf(stderr, "ERROR: Failed to allocate text cache.\n");
+        free(cache->entries);
+        free(cache->buckets);
+        memset(cache, 0, sizeof(*cache));
+        return false;
+    }
+
+    memset(cache->buckets, 0xFF, cache->bucketCount * sizeof(uint16_t));
+    cache->capacity = capacity;
+
+    cache->head = NK_TEXT_CACHE_NONE;
+    cache->tail = NK_TEXT_CACHE_NONE;
+    cache->count = 0;
+    cache->hits = 0;
+    cache->misses = 0;
+
+    return true;
+}
+
+void nkTextCache_Destroy(nkTextCache_t *cache)
+{
+    for (size_t i = 0; i < cache->capacity; i++)
+    {
+        free(cache->entries[i].text);
+        free(cache->entries[i].run);
+    }
+
+    free(cache->entries);
+    free(cache->buckets);
+    memset(cache, 0, sizeof(*cache));
+}
+
+uint64_t nkTextCache_Hash(const char *text)
+{
+    uint64_t hash = NK_TEXT_CACHE_FNV_OFFSET;
+    const unsigned char *c;
+
+    for (c = (const unsigned char*)text; c && *c; c++)
+    {
+        hash ^= *c;
+        hash *= NK_TEXT_CACHE_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+nkTextCacheEntry_t *nkTextCache_Lookup(nkTextCache_t *cache, uint64_t hash, const char *text, size_t length, int faceId, float fontSize, uint32_t generation)
+{
+    if (cache->capacity == 0)
+    {
+        cache->misses++;
+        return NULL;
+    }
+
+    uint16_t index = cache->buckets[nkTextCache_Bucket(cache, hash, faceId, fontSize)];
+
+    while (index != NK_TEXT_CACHE_NONE)
+    {
+        nkTextCacheEntry_t *entry = &cache->entries[index];
+
+        if (entry->hash == hash && entry->faceId == faceId && entry->fontSize == fontSize &&
+            entry->textLength == length && memcmp(entry->text, text, length) == 0)
+        {
+            if (cache->head != index)
+            {
+                nkTextCache_Unlink(cache, index);
+                nkTextCache_PushFront(cache, index);
+            }
+
+            if (entry->generation == generation)
+            {
+                cache->hits++;
+            }
+            else
+            {
+                cache->misses++;
+            }
+
+            return entry;
+        }
+
+        index = entry->chain;
+    }
+
+    cache->misses++;
+    return NULL;
+}
+
+nkTextCacheEntry_t *nkTextCache_Insert(nkTextCache_t *cache, uint64_t hash, const char *text, size_t length, int faceId, float fontSize, uint32_t generation)
+{
+    uint16_t index;
+
+    if (cache->capacity == 0 || length >= UINT32_MAX)
+    {
+        return NULL;
+    }
+
+    if (cache->count < cache->capacity)
+    {
+        index = (uint16_t)cache->count++;
+    }
+    else
+    {
+        index = cache->tail;
+
+        /* drop the evicted entry from its bucket chain */
+        nkTextCacheEntry_t *evicted = &cache->entries[index];
+        uint16_t *link = &cache->buckets[nkTextCache_Bucket(cache, evicted->hash, evicted->faceId, evicted->fontSize)];
+
+        while (*link != index)
+        {
+            link = &cache->entries[*link].chain;
+        }
+
+        *link = evicted->chain;
+
+        nkTextCache_Unlink(cache, index);
+    }
+
+    nkTextCacheEntry_t *entry = &cache->entries[index];
+    uint32_t bucket = nkTextCache_Bucket(cache, hash, faceId, fontSize);
+
+    bool copied = length <= entry->textCapacity;
+
+    if (!copied)
+    {
+        char *copy = (char*)realloc(entry->text, length);
+
+        if (copy)
+        {
+            entry->text = copy;
+            entry->textCapacity = (uint32_t)length;
+            copied = true;
+        }
+        else
+        {
+            fprintf(stderr, "ERROR: Failed to grow text cache entry.\n");
+        }
+    }
+
+    if (copied && length > 0)
+    {
+        memcpy(entry->text, text, length);
+    }
+
+    /* a slot without its string stays linked but matches nothing until it is recycled */
+    entry->textLength = copied ? (uint32_t)length : UINT32_MAX;
+
+    /* the run and text buffers are kept for the next occupant */
+    entry->hash = hash;
+    entry->faceId = faceId;
+    entry->fontSize = fontSize;
+    entry->generation = generation;
+    entry->bounds = (nkRect_t){0};
+    entry->runCount = 0;
+
+    entry->chain = cache->buckets[bucket];
+    cache->buckets[bucket] = index;
+
+    nkTextCache_PushFront(cache, index);
+
+    return copied ? entry : NULL;
+}
+
+void nkTextCache_GetStats(const nkTextCache_t *cache, nkTextCacheStats_t *stats)
+{
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+    stats->entries = cache->count;
+    stats->capacity = cache->capacity;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static uint32_t nkTextCache_Bucket(const nkTextCache_t *cache, uint64_t hash, int faceId, float fontSize)
+{
+    uint32_t sizeBits;
+
+    memcpy(&sizeBits, &fontSize, sizeof(sizeBits));
+
+    uint64_t key = hash ^ ((uint64_t)(uint32_t)faceId * 0x9E3779B97F4A7C15ULL) ^ ((uint64_t)sizeBits << 17);
+
+    return (uint32_t)(key ^ (key >> 32)) & (uint32_t)(cache->bucketCount - 1);
+}
+
+static void nkTextCache_Unlink(nkTextCache_t *cache, uint16_t index)
+{
+    nkTextCacheEntry_t *entry = &cache->entries[index];
+
+    if (entry->prev != NK_TEXT_CACHE_NONE)
+    {
+        cache->entries[entry->prev].next = entry->next;
+    }
+    else
+    {
+        cache->head = entry->next;
+    }
+
+    if (entry->next != NK_TEXT_CACHE_NONE)
+    {
+        cache->entries[entry->next].prev = entry->prev;
+    }
+    else
+    {
+        cache->tail = entry->prev;
+    }
+}
+
+static void nkTextCache_PushFront(nkTextCache_t *cache, uint16_t index)
+{
+    nkTextCacheEntry_t *entry = &cache->entries[index];
+
+    entry->prev = NK_TEXT_CACHE_NONE;
+    entry->next = cache->head;
+
+    if (cache->head != NK_TEXT_CACHE_NONE)
+    {
+        cache->entries[cache->head].prev = index;
+    }
+    else
+    {
+        cache->tail = index;
+    }
+
+    cache->head = index;
+}
@@ -0,0 +1,107 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nktextcache.h
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-05 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Text Cache
+**
+***************************************************************/
+
+#ifndef NKTEXTCACHE_H
+#define NKTEXTCACHE_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "geometry.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define NK_TEXT_CACHE_NONE (0xFFFFU)
+#define NK_TEXT_CACHE_MAX_CAPACITY (0xFFFEU)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* keyed on (face, size, string), with the string's hash picking the bucket */
+typedef struct
+{
+    uint64_t hash;
+    char *text;          /* copy of the string, reused when the entry is evicted */
+    uint32_t textLength;
+    uint32_t textCapacity;
+    int faceId;
+    float fontSize;
+    uint32_t generation; /* entries from an older generation count as misses */
+
+    nkRect_t bounds;     /* measured bounds */
+
+    void *run;           /* laid out glyph vertices and their atlas slots, reused when the entry is evicted */
+    uint32_t runCount;
+    uint32_t runCapacity;
+
+    uint16_t prev;  /* towards most recently used */
+    uint16_t next;  /* towards least recently used */
+    uint16_t chain; /* next entry in the same bucket */
+} nkTextCacheEntry_t;
+
+typedef struct
+{
+    nkTextCacheEntry_t *entries;
+    uint16_t *buckets;
+    size_t capacity;
+    size_t bucketCount; /* power of two */
+
+    uint16_t head; /* most recently used */
+    uint16_t tail; /* least recently used, evicted first */
+    size_t count;
+
+    uint64_t hits;
+    uint64_t misses;
+} nkTextCache_t;
+
+typedef struct
+{
+    uint64_t hits;    /* cumulative since nkTextCache_Init */
+    uint64_t misses;
+    size_t entries;
+    size_t capacity;
+} nkTextCacheStats_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+bool nkTextCache_Init(nkTextCache_t *cache, size_t capacity);
+
+/* frees the entries with their strings and runs */
+void nkTextCache_Destroy(nkTextCache_t *cache);
+
+/* 64-bit FNV-1a over the bytes of text */
+uint64_t nkTextCache_Hash(const char *text);
+
+/* returns the entry for the key, or NULL. text is length bytes hashed into hash, and is
+** compared with the entry's copy so colliding strings never share an entry. counts a hit only
+** if the entry is from the given generation; a stale entry is returned for the caller to
+** refresh in place. */
+nkTextCacheEntry_t *nkTextCache_Lookup(nkTextCache_t *cache, uint64_t hash, const char *text, size_t length, int faceId, float fontSize, uint32_t generation);
+
+/* inserts after a missed lookup, copying text and recycling the least recently used entry
+** when full. NULL when the copy cannot be allocated */
+nkTextCacheEntry_t *nkTextCache_Insert(nkTextCache_t *cache, uint64_t hash, const char *text, size_t length, int faceId, float fontSize, uint32_t generation);
+
+void nkTextCache_GetStats(const nkTextCache_t *cache, nkTextCacheStats_t *stats);
+
+#endif /* NKTEXTCACHE_H */
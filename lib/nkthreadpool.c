@@ -0,0 +1,429 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkthreadpool.c
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-05 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Thread Pool
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkthreadpool.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #define NK_THREADS_WIN32 1
+#elif !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+    #include <pthread.h>
+    #include <unistd.h>
+    #define NK_THREADS_POSIX 1
+#endif
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define NK_THREAD_POOL_MAX_THREADS (64U)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+struct nkThreadPool_t
+{
+#if NK_THREADS_WIN32
+    SRWLOCK lock;
+    CONDITION_VARIABLE workReady;
+    CONDITION_VARIABLE workDone;
+    HANDLE threads[NK_THREAD_POOL_MAX_THREADS];
+#elif NK_THREADS_POSIX
+    pthread_mutex_t lock;
+    pthread_cond_t workReady;
+    pthread_cond_t workDone;
+    pthread_t threads[NK_THREAD_POOL_MAX_THREADS];
+#endif
+    size_t workerCount;
+
+    /* current batch, guarded by lock */
+    nkThreadPoolTask_t task;
+    void *user;
+    size_t count;
+    size_t next;
+    size_t finished;      /* workers done with this batch */
+    uint64_t generation;  /* bumped per batch so workers never run one twice */
+    bool quit;
+};
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+#if NK_THREADS_WIN32 || NK_THREADS_POSIX
+static void nkThreadPool_Lock(nkThreadPool_t *pool);
+static void nkThreadPool_Unlock(nkThreadPool_t *pool);
+static void nkThreadPool_Wait(nkThreadPool_t *pool, bool done);
+static void nkThreadPool_Wake(nkThreadPool_t *pool, bool done);
+static void nkThreadPool_Drain(nkThreadPool_t *pool);
+static void nkThreadPool_Finish(nkThreadPool_t *pool);
+static void nkThreadPool_Worker(nkThreadPool_t *pool);
+#endif
+
+#if NK_THREADS_WIN32
+static DWORD WINAPI nkThreadPool_ThreadMain(LPVOID arg);
+#elif NK_THREADS_POSIX
+static void *nkThreadPool_ThreadMain(void *arg);
+#endif
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+nkThreadPool_t *nkThreadPool_Create(size_t threads)
+{
+#if NK_THREADS_WIN32 || NK_THREADS_POSIX
+    if (threads == 0)
+    {
+        threads = nkThreadPool_CoreCount();
+    }
+
+    if (threads > NK_THREAD_POOL_MAX_THREADS + 1)
+    {
+        threads = NK_THREAD_POOL_MAX_THREADS + 1;
+    }
+
+    if (threads <= 1)
+    {
+        return NULL;
+    }
+
+    nkThreadPool_t *pool = (nkThreadPool_t*)calloc(1, sizeof(nkThreadPool_t));
+
+    if (!pool)
+    {
+        fprintf(stderr, "ERROR: Failed to allocate thread pool.\n");
+        return NULL;
+    }
+
+    #if NK_THREADS_WIN32
+        InitializeSRWLock(&pool->lock);
+        InitializeConditionVariable(&pool->workReady);
+        InitializeConditionVariable(&pool->workDone);
+    #else
+        pthread_mutex_init(&pool->lock, NULL);
+        pthread_cond_init(&pool->workReady, NULL);
+        pthread_cond_init(&pool->workDone, NULL);
+    #endif
+
+    for (size_t i = 0; i < threads - 1; i++)
+    {
+    #if NK_THREADS_WIN32
+        pool->threads[i] = CreateThread(NULL, 0, nkThreadPool_ThreadMain, pool, 0, NULL);
+        bool started = pool->threads[i] != NULL;
+    #else
+        bool started = pthread_create(&pool->threads[i], NULL, nkThreadPool_ThreadMain, pool) == 0;
+    #endif
+
+        if (!started)
+        {
+            fprintf(stderr, "ERROR: Failed to start worker thread %zu.\n", i);
+            break;
+        }
+
+        pool->workerCount++;
+    }
+
+    if (pool->workerCount == 0)
+    {
+        nkThreadPool_Destroy(pool);
+        return NULL;
+    }
+
+    return pool;
+#else
+    (void)threads;
+    return NULL;
+#endif
+}
+
+void nkThreadPool_Destroy(nkThreadPool_t *pool)
+{
+#if NK_THREADS_WIN32 || NK_THREADS_POSIX
+    if (!pool)
+    {
+        return;
+    }
+
+    nkThreadPool_Lock(pool);
+    pool->quit = true;
+    nkThreadPool_Wake(pool, false);
+    nkThreadPool_Unlock(pool);
+
+    for (size_t i = 0; i < pool->workerCount; i++)
+    {
+    #if NK_THREADS_WIN32
+        WaitForSingleObject(pool->threads[i], INFINITE);
+        CloseHandle(pool->threads[i]);
+    #else
+        pthread_join(pool->threads[i], NULL);
+    #endif
+    }
+
+    #if NK_THREADS_POSIX
+        pthread_cond_destroy(&pool->workDone);
+        pthread_cond_destroy(&pool->workReady);
+        pthread_mutex_destroy(&pool->lock);
+    #endif
+
+    free(pool);
+#else
+    (void)pool;
+#endif
+}
+
+size_t nkThreadPool_ThreadCount(const nkThreadPool_t *pool)
+{
+    return pool ? pool->workerCount + 1 : 1;
+}
+
+void nkThreadPool_ParallelFor(nkThreadPool_t *pool, size_t count, nkThreadPoolTask_t task, void *user)
+{
+#if NK_THREADS_WIN32 || NK_THREADS_POSIX
+    if (pool && count > 1)
+    {
+        nkThreadPool_Lock(pool);
+        nkThreadPool_Finish(pool);
+
+        pool->task = task;
+        pool->user = user;
+        pool->count = count;
+        pool->next = 0;
+        pool->finished = 0;
+        pool->generation++;
+        nkThreadPool_Wake(pool, false);
+
+        nkThreadPool_Finish(pool);
+        nkThreadPool_Unlock(pool);
+        return;
+    }
+
+    nkThreadPool_Join(pool);
+#else
+    (void)pool;
+#endif
+
+    for (size_t i = 0; i < count; i++)
+    {
+        task(user, i);
+    }
+}
+
+void nkThreadPool_Dispatch(nkThreadPool_t *pool, size_t count, nkThreadPoolTask_t task, void *user)
+{
+#if NK_THREADS_WIN32 || NK_THREADS_POSIX
+    if (pool)
+    {
+        nkThreadPool_Lock(pool);
+        nkThreadPool_Finish(pool);
+
+        if (count > 0)
+        {
+            pool->task = task;
+            pool->user = user;
+            pool->count = count;
+            pool->next = 0;
+            pool->finished = 0;
+            pool->generation++;
+            nkThreadPool_Wake(pool, false);
+        }
+
+        nkThreadPool_Unlock(pool);
+        return;
+    }
+#else
+    (void)pool;
+#endif
+
+    for (size_t i = 0; i < count; i++)
+    {
+        task(user, i);
+    }
+}
+
+bool nkThreadPool_IsIdle(nkThreadPool_t *pool)
+{
+#if NK_THREADS_WIN32 || NK_THREADS_POSIX
+    if (pool)
+    {
+        nkThreadPool_Lock(pool);
+        bool idle = !pool->task || pool->finished == pool->workerCount;
+        nkThreadPool_Unlock(pool);
+        return idle;
+    }
+#else
+    (void)pool;
+#endif
+
+    return true;
+}
+
+void nkThreadPool_Join(nkThreadPool_t *pool)
+{
+#if NK_THREADS_WIN32 || NK_THREADS_POSIX
+    if (pool)
+    {
+        nkThreadPool_Lock(pool);
+        nkThreadPool_Finish(pool);
+        nkThreadPool_Unlock(pool);
+    }
+#else
+    (void)pool;
+#endif
+}
+
+size_t nkThreadPool_CoreCount(void)
+{
+#if NK_THREADS_WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (size_t)info.dwNumberOfProcessors : 1;
+#elif NK_THREADS_POSIX && defined(_SC_NPROCESSORS_ONLN)
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? (size_t)cores : 1;
+#else
+    return 1;
+#endif
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+#if NK_THREADS_WIN32 || NK_THREADS_POSIX
+
+static void nkThreadPool_Lock(nkThreadPool_t *pool)
+{
+#if NK_THREADS_WIN32
+    AcquireSRWLockExclusive(&pool->lock);
+#else
+    pthread_mutex_lock(&pool->lock);
+#endif
+}
+
+static void nkThreadPool_Unlock(nkThreadPool_t *pool)
+{
+#if NK_THREADS_WIN32
+    ReleaseSRWLockExclusive(&pool->lock);
+#else
+    pthread_mutex_unlock(&pool->lock);
+#endif
+}
+
+/* called with the lock held */
+static void nkThreadPool_Wait(nkThreadPool_t *pool, bool done)
+{
+#if NK_THREADS_WIN32
+    SleepConditionVariableSRW(done ? &pool->workDone : &pool->workReady, &pool->lock, INFINITE, 0);
+#else
+    pthread_cond_wait(done ? &pool->workDone : &pool->workReady, &pool->lock);
+#endif
+}
+
+static void nkThreadPool_Wake(nkThreadPool_t *pool, bool done)
+{
+#if NK_THREADS_WIN32
+    WakeAllConditionVariable(done ? &pool->workDone : &pool->workReady);
+#else
+    pthread_cond_broadcast(done ? &pool->workDone : &pool->workReady);
+#endif
+}
+
+/* runs tasks of the current batch until none are left; called and returns with the lock held */
+static void nkThreadPool_Drain(nkThreadPool_t *pool)
+{
+    while (pool->next < pool->count)
+    {
+        size_t index = pool->next++;
+
+        nkThreadPool_Unlock(pool);
+        pool->task(pool->user, index);
+        nkThreadPool_Lock(pool);
+    }
+}
+
+/* runs what is left of the batch in flight, if any, and waits for every worker to check in
+** so none is still inside its task; called and returns with the lock held */
+static void nkThreadPool_Finish(nkThreadPool_t *pool)
+{
+    if (!pool->task)
+    {
+        return;
+    }
+
+    nkThreadPool_Drain(pool);
+
+    while (pool->finished < pool->workerCount)
+    {
+        nkThreadPool_Wait(pool, true);
+    }
+
+    pool->task = NULL;
+}
+
+static void nkThreadPool_Worker(nkThreadPool_t *pool)
+{
+    uint64_t seen = 0;
+
+    nkThreadPool_Lock(pool);
+
+    for (;;)
+    {
+        while (!pool->quit && pool->generation == seen)
+        {
+            nkThreadPool_Wait(pool, false);
+        }
+
+        if (pool->quit)
+        {
+            break;
+        }
+
+        seen = pool->generation;
+        nkThreadPool_Drain(pool);
+
+        pool->finished++;
+        nkThreadPool_Wake(pool, true);
+    }
+
+    nkThreadPool_Unlock(pool);
+}
+
+#if NK_THREADS_WIN32
+static DWORD WINAPI nkThreadPool_ThreadMain(LPVOID arg)
+{
+    nkThreadPool_Worker((nkThreadPool_t*)arg);
+    return 0;
+}
+#else
+static void *nkThreadPool_ThreadMain(void *arg)
+{
+    nkThreadPool_Worker((nkThreadPool_t*)arg);
+    return NULL;
+}
+#endif
+
+#endif
@@ -0,0 +1,66 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkthreadpool.h
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-05 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Thread Pool
+**
+***************************************************************/
+
+#ifndef NKTHREADPOOL_H
+#define NKTHREADPOOL_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct nkThreadPool_t nkThreadPool_t;
+
+typedef void (*nkThreadPoolTask_t)(void *user, size_t index);
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* threads includes the calling thread, 0 picks one per core. returns NULL if no worker
+** could be started; a NULL pool runs everything on the caller. */
+nkThreadPool_t *nkThreadPool_Create(size_t threads);
+void nkThreadPool_Destroy(nkThreadPool_t *pool);
+
+/* workers plus the caller, 1 for a NULL pool */
+size_t nkThreadPool_ThreadCount(const nkThreadPool_t *pool);
+
+/* runs task(user, i) for every i in [0, count) on the workers and the caller, in no
+** particular order, and returns once all of them have finished */
+void nkThreadPool_ParallelFor(nkThreadPool_t *pool, size_t count, nkThreadPoolTask_t task, void *user);
+
+/* background batches: starts task(user, i) for every i in [0, count) on the workers alone and
+** returns at once. one batch runs at a time, Dispatch and ParallelFor first wait for the one
+** in flight. a NULL pool runs the batch on the caller before returning. */
+void nkThreadPool_Dispatch(nkThreadPool_t *pool, size_t count, nkThreadPoolTask_t task, void *user);
+
+/* true once the last dispatched batch has finished, without waiting */
+bool nkThreadPool_IsIdle(nkThreadPool_t *pool);
+
+/* helps the dispatched batch along and returns once it has finished */
+void nkThreadPool_Join(nkThreadPool_t *pool);
+
+size_t nkThreadPool_CoreCount(void);
+
+#endif /* NKTHREADPOOL_H */
@@ -3,17 +3,72 @@
 flat in uint vertexType;
 in vec4 vertexColor;
 in vec2 TexCoord;
+flat in vec3 vertexShape;
+flat in vec4 vertexRadii;
+flat in vec4 vertexColorEnd;
+in float vertexGradient;
 out vec4 FragColor;
 
-uniform sampler2D uTexture;
+uniform sampler2D uTextures[16];
+
+// Sampler arrays may only be indexed with constant expressions in GLSL 3.30,
+// the slot is flat per primitive so every fragment takes the same case.
+vec4 sampleSlot(uint slot, vec2 uv)
+{
+    switch (slot)
+    {
+        case 0u:  return texture(uTextures[0], uv);
+        case 1u:  return texture(uTextures[1], uv);
+        case 2u:  return texture(uTextures[2], uv);
+        case 3u:  return texture(uTextures[3], uv);
+        case 4u:  return texture(uTextures[4], uv);
+        case 5u:  return texture(uTextures[5], uv);
+        case 6u:  return texture(uTextures[6], uv);
+        case 7u:  return texture(uTextures[7], uv);
+        case 8u:  return texture(uTextures[8], uv);
+        case 9u:  return texture(uTextures[9], uv);
+        case 10u: return texture(uTextures[10], uv);
+        case 11u: return texture(uTextures[11], uv);
+        case 12u: return texture(uTextures[12], uv);
+        case 13u: return texture(uTextures[13], uv);
+        case 14u: return texture(uTextures[14], uv);
+        default:  return texture(uTextures[15], uv);
+    }
+}
+
+// Signed distance to a rounded box centred on the origin, y down.
+float roundedBoxDistance(vec2 p, vec2 halfSize, vec4 radii)
+{
+    vec2 side = (p.x > 0.0) ? radii.yz : radii.xw;
+    float radius = (p.y > 0.0) ? side.y : side.x;
+    vec2 q = abs(p) - halfSize + radius;
+    return min(max(q.x, q.y), 0.0) + length(max(q, 0.0)) - radius;
+}
 
 void main()
 {
-    // Calculate BOTH possible outcomes for every pixel
-    vec4 shapeColor = vertexColor;
-    vec4 textColor  = vec4(vertexColor.rgb, vertexColor.a * texture(uTexture, TexCoord).r);
+    // Low byte selects the primitive, the next byte the texture slot.
+    uint primitive = vertexType & 0xFFu;
+    uint slot = (vertexType >> 8) & 0xFFu;
+
+    // SDF primitives fill when the stroke width is zero, otherwise stroke
+    // a band centred on the outline. Coverage ramps over one pixel.
+    float distance = roundedBoxDistance(TexCoord, vertexShape.xy, vertexRadii);
+    float edge = mix(distance, abs(distance) - 0.5 * vertexShape.z, step(0.0001, vertexShape.z));
+
+    // Gradients clamp here rather than per vertex, so they end flat past their axis
+    // like NanoVG's. Solid paints carry the same colour at both ends.
+    vec4 paint = mix(vertexColor, vertexColorEnd, clamp(vertexGradient, 0.0, 1.0));
+
+    // Calculate ALL possible outcomes for every pixel
+    vec4 shapeColor = paint;
+    vec4 textColor  = vec4(paint.rgb, paint.a * sampleSlot(slot, TexCoord).r);
+    vec4 sdfColor   = vec4(paint.rgb, paint.a * clamp(0.5 - edge, 0.0, 1.0));
+    vec4 imageColor = paint * sampleSlot(slot, TexCoord);
 
     // Select the correct outcome using arithmetic instead of a branch.
-    // float(vertexType) will be 0.0 for shapes and 1.0 for text.
-    FragColor = mix(shapeColor, textColor, float(vertexType));
+    // primitive is 0 for shapes, 1 for text, 2 for SDF rects and 3 for images.
+    vec4 color = mix(shapeColor, textColor, float(primitive == 1u));
+    color = mix(color, sdfColor, float(primitive == 2u));
+    FragColor = mix(color, imageColor, float(primitive == 3u));
 }
\ No newline at end of file
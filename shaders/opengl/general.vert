@@ -3,11 +3,19 @@
 layout (location = 0) in uint aType;
 layout (location = 1) in vec2 aPos;
 layout (location = 2) in vec4 aColor; // Can be used to tint the texture
-layout (location = 3) in vec2 aTexCoord;
+layout (location = 3) in vec2 aTexCoord; // Local position for SDF primitives
+layout (location = 4) in vec3 aShape;    // SDF half extents and stroke width
+layout (location = 5) in vec4 aRadii;    // SDF corner radii, clockwise from top left
+layout (location = 6) in vec4 aColorEnd; // Gradient end colour, aColor being its start
+layout (location = 7) in float aGradient; // Position along the gradient axis, unclamped
 
 flat out uint vertexType;
 out vec4 vertexColor;
 out vec2 TexCoord;
+flat out vec3 vertexShape;
+flat out vec4 vertexRadii;
+flat out vec4 vertexColorEnd;
+out float vertexGradient;
 
 uniform mat4 uProjection;
 
@@ -17,4 +25,8 @@ void main()
     vertexColor = aColor;
     TexCoord = aTexCoord;
     vertexType = aType;
+    vertexShape = aShape;
+    vertexRadii = aRadii;
+    vertexColorEnd = aColorEnd;
+    vertexGradient = aGradient;
 }
\ No newline at end of file
@@ -0,0 +1,253 @@
+/***************************************************************
+**
+** NanoKit Library Test File
+**
+** File         :  cpudeterminism.c
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-27 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  CPU frames are identical for every thread count and SIMD level
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <extern/nanovg/nanovg.h>
+#include "backends/cpu/nanovg_cpu.h"
+#include <extern/nanovg/nanovg_gl.h> /* NVGcreateFlags only */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define TEST_WIDTH (512)
+#define TEST_HEIGHT (384)
+#define TEST_SHAPES (300)
+#define TEST_IMAGE_SIZE (16)
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static const int threadCounts[] = { 1, 2, 8 };
+static const int simdLevels[] = { 0, 1, 2 };
+
+static unsigned char expected[TEST_WIDTH * TEST_HEIGHT * 4];
+static unsigned char actual[TEST_WIDTH * TEST_HEIGHT * 4];
+
+static uint32_t seed;
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+/* xorshift, so every render sees the same scene */
+static uint32_t next(void)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+static float range(float lo, float hi)
+{
+    return lo + (hi - lo) * (float)(next() & 0xFFFF) / 65535.0f;
+}
+
+static NVGcolor color(void)
+{
+    return nvgRGBA((unsigned char)next(), (unsigned char)next(), (unsigned char)next(), (unsigned char)(64 + next() % 192));
+}
+
+static NVGpaint paint(NVGcontext *vg, int image, float x, float y, float w, float h)
+{
+    switch (next() % 5)
+    {
+        case 0:  return nvgLinearGradient(vg, x, y, x + w, y + h, color(), color());
+        case 1:  return nvgRadialGradient(vg, x + w * 0.5f, y + h * 0.5f, 0.0f, range(4.0f, w), color(), color());
+        case 2:  return nvgBoxGradient(vg, x, y, w, h, range(0.0f, 12.0f), range(1.0f, 16.0f), color(), color());
+        case 3:  return nvgImagePattern(vg, x, y, TEST_IMAGE_SIZE, TEST_IMAGE_SIZE, range(0.0f, 3.14f), image, range(0.3f, 1.0f));
+        default: break;
+    }
+
+    NVGcolor solid = color();
+    return nvgLinearGradient(vg, x, y, x + w, y, solid, solid);
+}
+
+/* a star with a hole cut through it */
+static void star(NVGcontext *vg, float cx, float cy, float r)
+{
+    for (int i = 0; i < 10; i++)
+    {
+        float a = (float)i * NVG_PI / 5.0f;
+        float d = (i & 1) ? r * 0.45f : r;
+
+        if (i == 0)
+        {
+            nvgMoveTo(vg, cx + d * cosf(a), cy + d * sinf(a));
+        }
+        else
+        {
+            nvgLineTo(vg, cx + d * cosf(a), cy + d * sinf(a));
+        }
+    }
+
+    nvgClosePath(vg);
+    nvgCircle(vg, cx, cy, r * 0.3f);
+    nvgPathWinding(vg, NVG_HOLE);
+}
+
+/* about TEST_SHAPES gradient, image and solid shapes: stars and rects with holes, rotated,
+** scissored and stroked */
+static void render(NVGcontext *vg, int image, unsigned char *pixels)
+{
+    memset(pixels, 0, TEST_WIDTH * TEST_HEIGHT * 4);
+    nvgCPUSetTarget(vg, pixels, TEST_WIDTH, TEST_HEIGHT, TEST_WIDTH * 4);
+
+    seed = 0x9E3779B9U;
+
+    nvgCPUClear(vg, nvgRGBA(24, 24, 32, 255));
+    nvgBeginFrame(vg, TEST_WIDTH, TEST_HEIGHT, 1.0f);
+
+    for (int i = 0; i < TEST_SHAPES; i++)
+    {
+        float x = range(-20.0f, TEST_WIDTH);
+        float y = range(-20.0f, TEST_HEIGHT);
+        float w = range(4.0f, 96.0f);
+        float h = range(4.0f, 96.0f);
+        uint32_t kind = next();
+
+        nvgSave(vg);
+
+        if (kind & 0x10)
+        {
+            nvgScissor(vg, range(0.0f, TEST_WIDTH), range(0.0f, TEST_HEIGHT), range(16.0f, 256.0f), range(16.0f, 192.0f));
+        }
+
+        if (kind & 0x20)
+        {
+            nvgTranslate(vg, x + w * 0.5f, y + h * 0.5f);
+            nvgRotate(vg, range(-3.14f, 3.14f));
+            nvgTranslate(vg, -(x + w * 0.5f), -(y + h * 0.5f));
+
+            if (kind & 0x40)
+            {
+                nvgIntersectScissor(vg, x, y, w * 0.75f, h * 0.75f);
+            }
+        }
+
+        nvgBeginPath(vg);
+
+        switch (kind % 4)
+        {
+            case 0:
+                star(vg, x + w * 0.5f, y + h * 0.5f, 0.5f * (w < h ? w : h));
+                break;
+            case 1:
+                nvgRoundedRect(vg, x, y, w, h, range(0.0f, 16.0f));
+                nvgRect(vg, x + w * 0.25f, y + h * 0.25f, w * 0.5f, h * 0.5f);
+                nvgPathWinding(vg, NVG_HOLE);
+                break;
+            case 2:
+                nvgEllipse(vg, x + w * 0.5f, y + h * 0.5f, w * 0.5f, h * 0.5f);
+                break;
+            default:
+                nvgMoveTo(vg, x, y);
+                nvgBezierTo(vg, x + w, y - h * 0.5f, x - w * 0.5f, y + h, x + w, y + h);
+                nvgQuadTo(vg, x + w * 0.5f, y, x, y + h * 0.5f);
+                break;
+        }
+
+        if ((kind & 0x100) == 0)
+        {
+            nvgFillPaint(vg, paint(vg, image, x, y, w, h));
+            nvgFill(vg);
+        }
+
+        if (kind & 0x300)
+        {
+            nvgStrokePaint(vg, paint(vg, image, x, y, w, h));
+            nvgStrokeWidth(vg, range(0.5f, 8.0f));
+            nvgLineJoin(vg, (int[]){ NVG_MITER, NVG_ROUND, NVG_BEVEL }[next() % 3]);
+            nvgLineCap(vg, (int[]){ NVG_BUTT, NVG_ROUND, NVG_SQUARE }[next() % 3]);
+            nvgStroke(vg);
+        }
+
+        nvgRestore(vg);
+    }
+
+    nvgEndFrame(vg);
+}
+
+/***************************************************************
+** MARK: MAIN
+***************************************************************/
+
+int main(void)
+{
+    unsigned char checker[TEST_IMAGE_SIZE * TEST_IMAGE_SIZE * 4];
+    int failures = 0;
+
+    for (int i = 0; i < TEST_IMAGE_SIZE * TEST_IMAGE_SIZE; i++)
+    {
+        unsigned char v = (((i % TEST_IMAGE_SIZE) / 4 + (i / TEST_IMAGE_SIZE) / 4) & 1) ? 255 : 64;
+
+        checker[i * 4 + 0] = v;
+        checker[i * 4 + 1] = (unsigned char)(255 - v);
+        checker[i * 4 + 2] = 128;
+        checker[i * 4 + 3] = 255;
+    }
+
+    NVGcontext *vg = nvgCreateCPU(NVG_ANTIALIAS | NVG_STENCIL_STROKES);
+    int image = vg ? nvgCreateImageRGBA(vg, TEST_IMAGE_SIZE, TEST_IMAGE_SIZE, NVG_IMAGE_REPEATX | NVG_IMAGE_REPEATY, checker) : 0;
+
+    if (!vg || image == 0)
+    {
+        fprintf(stderr, "ERROR: Failed to set up the NanoVG CPU renderer.\n");
+        return 2;
+    }
+
+    /* the scalar, single threaded frame is the reference */
+    nvgCPUSetThreads(vg, 1);
+    nvgCPUSetSimd(vg, 0);
+    render(vg, image, expected);
+
+    for (size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); t++)
+    {
+        for (size_t s = 0; s < sizeof(simdLevels) / sizeof(simdLevels[0]); s++)
+        {
+            int threads = nvgCPUSetThreads(vg, threadCounts[t]);
+            int simd = nvgCPUSetSimd(vg, simdLevels[s]);
+
+            render(vg, image, actual);
+
+            if (memcmp(expected, actual, sizeof(expected)) != 0)
+            {
+                size_t differing = 0;
+
+                for (size_t p = 0; p < sizeof(expected); p += 4)
+                {
+                    differing += memcmp(&expected[p], &actual[p], 4) != 0;
+                }
+
+                fprintf(stderr, "FAIL: %d threads at SIMD level %d differ from the scalar frame in %zu pixels\n", threads, simd, differing);
+                failures++;
+            }
+        }
+    }
+
+    nvgDeleteImage(vg, image);
+    nvgDeleteCPU(vg);
+
+    return failures ? 1 : 0;
+}
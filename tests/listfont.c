@@ -0,0 +1,141 @@
+/***************************************************************
+**
+** NanoKit Library Test File
+**
+** File         :  listfont.c
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-27 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Text after a recorded display list keeps its own font
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <nanodraw.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define TEST_WIDTH (200)
+#define TEST_HEIGHT (64)
+#define TEST_SIZE (24.0f)
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/* the library's default face, which the tests replace with faces of NANODRAW_TEST_FONT */
+const uint8_t NKFonts_fonts_Roboto_Regular_ttf[1] = { 0 };
+const size_t NKFonts_fonts_Roboto_Regular_ttf_size = 0;
+
+static nkDrawContext_t context;
+static uint8_t expected[TEST_WIDTH * TEST_HEIGHT * 4];
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+/* a partial redraw CPU context with faces "a" and "b" of the test font, both at TEST_SIZE */
+static bool create(const char *path, nkFont_t *a, nkFont_t *b)
+{
+    nkDrawContextOptions_t options = { 0 };
+
+    options.target = NK_DRAW_TARGET_CPU;
+    options.threads = 1;
+    options.partialRedraw = true;
+
+    memset(&context, 0, sizeof(context));
+
+    return nkDraw_CreateContextWithOptions(&context, &options) &&
+        nkDraw_RegisterFontFile(&context, "a", path) != -1 &&
+        nkDraw_RegisterFontFile(&context, "b", path) != -1 &&
+        nkDraw_LoadFont(&context, a, "a", TEST_SIZE) &&
+        nkDraw_LoadFont(&context, b, "b", TEST_SIZE);
+}
+
+/* draws face a text, after recording face b text into a list when record is set */
+static const uint8_t *render(nkFont_t *a, nkFont_t *b, bool record)
+{
+    nkDrawList_t list = { 0 };
+    size_t width = 0;
+    size_t height = 0;
+    size_t stride = 0;
+
+    nkDraw_Begin(&context, TEST_WIDTH, TEST_HEIGHT);
+    nkDraw_Clear(&context, (nkColor_t){ 0.0f, 0.0f, 0.0f, 1.0f });
+    nkDraw_SetColor(&context, (nkVector4_t){ 1.0f, 1.0f, 1.0f, 1.0f });
+
+    if (record)
+    {
+        nkDraw_BeginList(&context, &list);
+        nkDraw_Text(&context, b, "Recorded", 10.0f, 20.0f);
+        nkDraw_EndList(&context);
+    }
+
+    nkDraw_Text(&context, a, "After list", 10.0f, 40.0f);
+    nkDraw_End(&context);
+    nkDrawList_Free(&list);
+
+    const uint8_t *pixels = nkDraw_GetPixels(&context, &width, &height, &stride);
+    return pixels && width == TEST_WIDTH && height == TEST_HEIGHT && stride == TEST_WIDTH * 4 ? pixels : NULL;
+}
+
+/***************************************************************
+** MARK: MAIN
+***************************************************************/
+
+int main(int argc, char **argv)
+{
+    nkFont_t a;
+    nkFont_t b;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s font.ttf\n", argv[0]);
+        return 2;
+    }
+
+    /* separate contexts, so the run cache cannot carry a correct run into the second */
+    if (!create(argv[1], &a, &b))
+    {
+        fprintf(stderr, "ERROR: Failed to set up a CPU context with font '%s'.\n", argv[1]);
+        return 2;
+    }
+
+    const uint8_t *pixels = render(&a, &b, false);
+
+    if (!pixels)
+    {
+        fprintf(stderr, "ERROR: No CPU pixels.\n");
+        return 2;
+    }
+
+    memcpy(expected, pixels, sizeof(expected));
+    nkDraw_DestroyContext(&context);
+
+    if (!create(argv[1], &a, &b) || (pixels = render(&a, &b, true)) == NULL)
+    {
+        fprintf(stderr, "ERROR: Failed to set up the second context.\n");
+        return 2;
+    }
+
+    int failed = memcmp(expected, pixels, sizeof(expected)) != 0;
+
+    if (failed)
+    {
+        fprintf(stderr, "FAIL: text after a display list drew with the list's font\n");
+    }
+
+    nkDraw_DestroyContext(&context);
+
+    return failed;
+}
@@ -0,0 +1,122 @@
+/***************************************************************
+**
+** NanoKit Library Test File
+**
+** File         :  textrun.c
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-27 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Cached text runs draw exactly as nvgText
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <extern/nanovg/nanovg.h>
+#include "backends/cpu/nanovg_cpu.h"
+#include <extern/nanovg/nanovg_gl.h> /* NVGcreateFlags only */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define TEST_WIDTH (160)
+#define TEST_HEIGHT (48)
+#define TEST_TEXT "Cached text 0123"
+#define TEST_MAX_VERTS (6 * (sizeof(TEST_TEXT) - 1))
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static unsigned char expected[TEST_WIDTH * TEST_HEIGHT * 4];
+static unsigned char actual[TEST_WIDTH * TEST_HEIGHT * 4];
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+/* draws TEST_TEXT at x, y into pixels, through a run laid out at the origin or through nvgText */
+static void render(NVGcontext *vg, unsigned char *pixels, float x, float y, int run)
+{
+    NVGvertex verts[TEST_MAX_VERTS];
+    int slots[TEST_MAX_VERTS / 6];
+
+    memset(pixels, 0, TEST_WIDTH * TEST_HEIGHT * 4);
+    nvgCPUSetTarget(vg, pixels, TEST_WIDTH, TEST_HEIGHT, TEST_WIDTH * 4);
+
+    nvgBeginFrame(vg, TEST_WIDTH, TEST_HEIGHT, 1.0f);
+    nvgFontFace(vg, "test");
+    nvgFontSize(vg, 17.0f);
+    nvgFillColor(vg, nvgRGBA(255, 255, 255, 255));
+
+    if (run)
+    {
+        int count = nvgTextRun(vg, TEST_TEXT, NULL, verts, slots, (int)TEST_MAX_VERTS);
+        nvgTextRunDraw(vg, x, y, verts, slots, count);
+    }
+    else
+    {
+        nvgText(vg, x, y, TEST_TEXT, NULL);
+    }
+
+    nvgEndFrame(vg);
+}
+
+/***************************************************************
+** MARK: MAIN
+***************************************************************/
+
+int main(int argc, char **argv)
+{
+    static const float positions[][2] = {
+        { 10.0f, 30.0f }, { 10.5f, 30.0f }, { 10.0f, 30.5f }, { 10.25f, 30.75f }, { 9.99f, 29.01f }
+    };
+    int failures = 0;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s font.ttf\n", argv[0]);
+        return 2;
+    }
+
+    NVGcontext *vg = nvgCreateCPU(NVG_ANTIALIAS);
+
+    if (!vg || nvgCreateFont(vg, "test", argv[1]) == -1)
+    {
+        fprintf(stderr, "ERROR: Failed to set up NanoVG with font '%s'.\n", argv[1]);
+        return 2;
+    }
+
+    for (size_t i = 0; i < sizeof(positions) / sizeof(positions[0]); i++)
+    {
+        float x = positions[i][0];
+        float y = positions[i][1];
+        size_t lit = 0;
+
+        render(vg, expected, x, y, 0);
+        render(vg, actual, x, y, 1);
+
+        for (size_t p = 0; p < sizeof(expected); p += 4)
+        {
+            lit += expected[p + 3] != 0;
+        }
+
+        if (lit == 0 || memcmp(expected, actual, sizeof(expected)) != 0)
+        {
+            fprintf(stderr, "FAIL: text run at %.2f, %.2f differs from nvgText (%zu pixels drawn)\n", x, y, lit);
+            failures++;
+        }
+    }
+
+    nvgDeleteCPU(vg);
+
+    return failures ? 1 : 0;
+}
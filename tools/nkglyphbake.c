@@ -0,0 +1,265 @@
+/***************************************************************
+**
+** NanoKit Tool Source File
+**
+** File         :  nkglyphbake.c
+** Module       :  nanodraw
+** Author       :  SH
+** Created      :  2025-07-05 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Glyph Cache Baker
+**
+** Usage        :  nkglyphbake font.ttf out.nkgc [--sdf] [--range first last] [size ...]
+**
+** Rasterizes codepoints first..last (ASCII by default) of a font at each pixel size, or once
+** as signed distance fields with --sdf, and writes them as a glyph cache for
+** nkDraw_LoadGlyphCache. Sizes are device pixels, font size times the pixel ratio.
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define FONTSTASH_IMPLEMENTATION
+#include <extern/nanovg/fontstash.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define NK_GLYPH_BAKE_ATLAS_SIZE (512)
+#define NK_GLYPH_BAKE_MAX_ATLAS_SIZE (8192)
+#define NK_GLYPH_BAKE_JOBS (256)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static unsigned char *nkGlyphBake_ReadFile(const char *path, int *size);
+static int nkGlyphBake_Rasterize(FONScontext *stash);
+static int nkGlyphBake_Write(FONScontext *stash, const char *path);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: %s font.ttf out.nkgc [--sdf] [--range first last] [size ...]\n", argv[0]);
+        return 1;
+    }
+
+    int fontSize = 0;
+    unsigned char *fontData = nkGlyphBake_ReadFile(argv[1], &fontSize);
+
+    if (!fontData)
+    {
+        return 1;
+    }
+
+    FONSparams params;
+    memset(&params, 0, sizeof(params));
+    params.width = NK_GLYPH_BAKE_ATLAS_SIZE;
+    params.height = NK_GLYPH_BAKE_ATLAS_SIZE;
+    params.flags = FONS_ZERO_TOPLEFT;
+
+    FONScontext *stash = fonsCreateInternal(&params);
+
+    /* the stash owns and frees the font data */
+    int font = stash ? fonsAddFontMem(stash, "font", fontData, fontSize, 1, 0) : FONS_INVALID;
+
+    if (font == FONS_INVALID)
+    {
+        fprintf(stderr, "ERROR: Failed to load font %s.\n", argv[1]);
+
+        if (stash)
+        {
+            fonsDeleteInternal(stash);
+        }
+        else
+        {
+            free(fontData);
+        }
+
+        return 1;
+    }
+
+    fonsSetFont(stash, font);
+
+    unsigned int first = 32;
+    unsigned int last = 126;
+    int sdf = 0;
+    int sizes = 0;
+
+    for (int i = 3; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--sdf") == 0)
+        {
+            sdf = 1;
+        }
+        else if (strcmp(argv[i], "--range") == 0 && i + 2 < argc)
+        {
+            first = (unsigned int)strtoul(argv[i + 1], NULL, 0);
+            last = (unsigned int)strtoul(argv[i + 2], NULL, 0);
+            i += 2;
+        }
+        else
+        {
+            float size = strtof(argv[i], NULL);
+
+            if (size <= 0.0f)
+            {
+                fprintf(stderr, "ERROR: Invalid size %s.\n", argv[i]);
+                fonsDeleteInternal(stash);
+                return 1;
+            }
+
+            fonsSetSize(stash, size);
+            fonsPrewarmGlyphs(stash, first, last);
+            sizes++;
+        }
+    }
+
+    /* distance fields are rendered at one size for all of them */
+    if (sdf)
+    {
+        fonsSetSDF(stash, 1);
+        fonsPrewarmGlyphs(stash, first, last);
+    }
+    else if (sizes == 0)
+    {
+        fonsSetSize(stash, 14.0f);
+        fonsPrewarmGlyphs(stash, first, last);
+    }
+
+    int glyphs = nkGlyphBake_Rasterize(stash);
+
+    if (glyphs < 0 || !nkGlyphBake_Write(stash, argv[2]))
+    {
+        fonsDeleteInternal(stash);
+        return 1;
+    }
+
+    printf("%s: %d glyphs\n", argv[2], glyphs);
+
+    fonsDeleteInternal(stash);
+    return 0;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static unsigned char *nkGlyphBake_ReadFile(const char *path, int *size)
+{
+    FILE *file = fopen(path, "rb");
+
+    if (!file)
+    {
+        fprintf(stderr, "ERROR: Failed to open %s.\n", path);
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    unsigned char *data = length > 0 ? (unsigned char*)malloc((size_t)length) : NULL;
+
+    if (!data || fread(data, 1, (size_t)length, file) != (size_t)length)
+    {
+        fprintf(stderr, "ERROR: Failed to read %s.\n", path);
+        free(data);
+        fclose(file);
+        return NULL;
+    }
+
+    fclose(file);
+    *size = (int)length;
+    return data;
+}
+
+/* renders every queued glyph into the atlas, doubling it when full. returns the glyphs added */
+static int nkGlyphBake_Rasterize(FONScontext *stash)
+{
+    FONSglyphJob jobs[NK_GLYPH_BAKE_JOBS];
+    int glyphs = 0;
+    int count;
+
+    while ((count = fonsTakeGlyphJobs(stash, jobs, NK_GLYPH_BAKE_JOBS)) > 0)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            fonsRasterizeGlyphJob(&jobs[i]);
+
+            int result;
+
+            while ((result = fonsCommitGlyphJob(stash, &jobs[i])) < 0)
+            {
+                int width, height;
+                fonsGetAtlasSize(stash, &width, &height);
+
+                if (width >= NK_GLYPH_BAKE_MAX_ATLAS_SIZE || !fonsExpandAtlas(stash, width * 2, height * 2))
+                {
+                    fprintf(stderr, "ERROR: Glyphs do not fit a %dx%d atlas.\n", width, height);
+
+                    for (int j = i; j < count; j++)
+                    {
+                        fonsCancelGlyphJob(stash, &jobs[j]);
+                    }
+
+                    return -1;
+                }
+            }
+
+            glyphs += result;
+        }
+    }
+
+    return glyphs;
+}
+
+static int nkGlyphBake_Write(FONScontext *stash, const char *path)
+{
+    int size = fonsSaveGlyphCache(stash, NULL, 0);
+    unsigned char *data = (unsigned char*)malloc((size_t)size);
+
+    if (!data)
+    {
+        fprintf(stderr, "ERROR: Failed to allocate %d bytes for the glyph cache.\n", size);
+        return 0;
+    }
+
+    fonsSaveGlyphCache(stash, data, size);
+
+    FILE *file = fopen(path, "wb");
+    int written = file && fwrite(data, 1, (size_t)size, file) == (size_t)size;
+
+    if (file && fclose(file) != 0)
+    {
+        written = 0;
+    }
+
+    if (!written)
+    {
+        fprintf(stderr, "ERROR: Failed to write %s.\n", path);
+    }
+
+    free(data);
+    return written;
+}